@@ -0,0 +1,71 @@
+/**
+ * @file AlignedAllocator.h
+ * @brief 先頭を指定の境界に揃えて確保するアロケータ
+ * @details C++11のstd::allocatorはalignof(std::max_align_t)（16byte）を超える境界を保証しないため，
+ *          alignas(64)の型やSIMD用の配列をstd::vectorで確保する場合に使う
+**/
+#ifndef AlignedAllocator_h
+#define AlignedAllocator_h
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace myStd
+{
+    /**
+     * @brief 先頭をAlignバイト境界に揃えて確保するアロケータ
+     * @tparam T: 要素の型
+     * @tparam Align: 境界[byte]（2のべき乗）
+    **/
+    template <typename T, std::size_t Align = 64>
+    class AlignedAllocator
+    {
+        static_assert((Align & (Align - 1)) == 0, "Align must be a power of two");
+
+    public:
+        using value_type = T;
+
+        template <typename U>
+        struct rebind
+        {
+            using other = AlignedAllocator<U, Align>;
+        };
+
+        AlignedAllocator() = default;
+        template <typename U>
+        AlignedAllocator(const AlignedAllocator<U, Align> &) {}
+
+        T *allocate(std::size_t n)
+        {
+            // 余分に確保して境界に揃え，直前に元のポインタを保存する
+            void *raw = std::malloc(n * sizeof(T) + Align + sizeof(void *));
+            if (!raw)
+            {
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS)
+                throw std::bad_alloc();
+#else
+                std::abort();
+#endif
+            }
+            std::uintptr_t p = reinterpret_cast<std::uintptr_t>(raw) + sizeof(void *);
+            p = (p + Align - 1) & ~static_cast<std::uintptr_t>(Align - 1);
+            reinterpret_cast<void **>(p)[-1] = raw;
+            return reinterpret_cast<T *>(p);
+        }
+
+        void deallocate(T *p, std::size_t)
+        {
+            if (p)
+                std::free(reinterpret_cast<void **>(p)[-1]);
+        }
+
+        template <typename U>
+        bool operator==(const AlignedAllocator<U, Align> &) const { return true; }
+        template <typename U>
+        bool operator!=(const AlignedAllocator<U, Align> &) const { return false; }
+    };
+} // namespace myStd
+
+#endif // AlignedAllocator_h
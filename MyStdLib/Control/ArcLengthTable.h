@@ -0,0 +1,181 @@
+/**
+ * @file ArcLengthTable.h
+ * @brief 経路の弧長テーブル
+**/
+#ifndef ArcLengthTable_h
+#define ArcLengthTable_h
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include "./../MyStdFunctions.h"
+#include "./../Vector/Vector.h"
+
+namespace myStd
+{
+    /**
+     * @brief 経路の弧長テーブル
+     * @details 線分（path[i]からpath[i + 1]）ごとに始点までの累積弧長と長さを1つの構造体にまとめて保持する．
+     *          追従中に参照する値が連続したメモリに並ぶため，カーソルを進める処理がキャッシュに乗りやすい．
+     *          release()で先頭側の線分を解放でき，その場合もインデックスは変わらない（弧長の起点は解放後の先頭に移る）．
+     * @tparam T: 数値型
+    **/
+    template <typename T>
+    class ArcLengthTable
+    {
+    public:
+        /**
+         * @brief 線分の情報
+         */
+        struct segment_t
+        {
+            T s;      /**< 経路の始点から線分の始点までの弧長 */
+            T length; /**< 線分の長さ */
+        };
+
+        /**
+         * @brief コンストラクタ
+         */
+        ArcLengthTable() = default;
+
+        /**
+         * @brief テーブルの構築
+         * @param path: 経路データの先頭ポインタ
+         * @param num: 経路データの要素数
+         */
+        void build(const Pose2D<T> *path, std::size_t num)
+        {
+            clear();
+            extend(path, num);
+        }
+
+        /**
+         * @brief 累積弧長からテーブルを構築（線分の長さは隣り合う弧長の差とする）
+         * @param arc_length: 各点までの累積弧長の先頭ポインタ（PathFile::arcLength()など）
+         * @param num: 経路データの要素数
+         */
+        void assign(const T *arc_length, std::size_t num)
+        {
+            clear();
+            if (num < 2)
+                return;
+            _segments.resize(num - 1);
+            for (std::size_t i = 0; i + 1 < num; i++)
+            {
+                _segments[i].s = arc_length[i];
+                _segments[i].length = arc_length[i + 1] - arc_length[i];
+            }
+        }
+
+        /**
+         * @brief 経路データの末尾に追加された分だけテーブルを伸ばす
+         * @param path: 経路データの先頭ポインタ（構築済みの部分は変更されていないこと）
+         * @param num: 経路データの要素数
+         */
+        void extend(const Pose2D<T> *path, std::size_t num) { extend(path, 0, num); }
+
+        /**
+         * @brief 経路データの末尾に追加された分だけテーブルを伸ばす
+         * @param path: path[i]で点を取得できる経路データ（ポインタ，StreamingPathなど）
+         * @param begin: 経路データの最初の点のインデックス（テーブルが空の場合のみ使う）
+         * @param end: 経路データの最後の点の次のインデックス
+         */
+        template <typename P>
+        void extend(const P &path, std::size_t begin, std::size_t end);
+
+        /**
+         * @brief 指定したインデックスより前の線分を解放
+         * @param idx: 残す線分のうち最も古い線分のインデックス
+         */
+        void release(std::size_t idx);
+
+        /**
+         * @brief テーブルの破棄
+         */
+        inline void clear()
+        {
+            _segments.clear();
+            _base = _offset = 0;
+        }
+
+        /**
+         * @brief 最初の線分のインデックスの取得
+         */
+        inline std::size_t begin() const { return _base + _offset; }
+
+        /**
+         * @brief 最後の線分の次のインデックスの取得
+         */
+        inline std::size_t end() const { return _base + _segments.size(); }
+
+        /**
+         * @brief 線分の数の取得
+         */
+        inline std::size_t size() const { return end() - begin(); }
+
+        /**
+         * @brief 線分の情報の取得
+         * @param i: 線分のインデックス（begin()以上end()未満）
+         */
+        inline const segment_t &operator[](std::size_t i) const { return _segments[i - _base]; }
+
+        /**
+         * @brief 経路の全長の取得
+         */
+        inline T totalLength() const { return size() == 0 ? T(0) : _segments.back().s + _segments.back().length; }
+
+    private:
+        std::vector<segment_t> _segments; // _segments[k]がインデックス_base + kの線分（先頭の_offset個は解放済み）
+        std::size_t _base = 0;
+        std::size_t _offset = 0;
+    };
+
+    template <typename T>
+    template <typename P>
+    void ArcLengthTable<T>::extend(const P &path, std::size_t begin, std::size_t end)
+    {
+        if (size() == 0)
+        {
+            _segments.clear();
+            _base = begin;
+            _offset = 0;
+        }
+        if (end < _base + 2 || this->end() >= end - 1)
+            return;
+
+        T s = totalLength();
+        for (std::size_t i = this->end(); i + 1 < end; i++)
+        {
+            const T dx = path[i + 1].x - path[i].x;
+            const T dy = path[i + 1].y - path[i].y;
+            segment_t seg;
+            seg.s = s;
+            seg.length = std::sqrt(dx * dx + dy * dy);
+            _segments.push_back(seg);
+            s += seg.length;
+        }
+    }
+
+    template <typename T>
+    void ArcLengthTable<T>::release(std::size_t idx)
+    {
+        if (idx <= begin())
+            return;
+        _offset = min(idx, end()) - _base;
+
+        // 解放済みの領域が半分を超えたら詰める（償却O(1)）
+        // 弧長の起点も先頭に移し，長時間の追従でも弧長が大きくなり続けないようにする
+        if (_offset * 2 >= _segments.size())
+        {
+            const T s0 = (_offset < _segments.size()) ? _segments[_offset].s : T(0);
+            _segments.erase(_segments.begin(), _segments.begin() + _offset);
+            for (auto &seg : _segments)
+                seg.s -= s0;
+            _base += _offset;
+            _offset = 0;
+        }
+    }
+
+} // namespace myStd
+
+#endif // ArcLengthTable_h
@@ -0,0 +1,221 @@
+/**
+ * @file AnyController.h
+ * @brief 任意のフィードバックコントローラを保持する型
+**/
+#ifndef AnyController_h
+#define AnyController_h
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "./../../MyStdFunctions.h"
+#include "IFBController.h"
+#include "PID.h"
+
+namespace myStd
+{
+    namespace any_controller_detail
+    {
+        /**
+         * @brief reset()を持つ型か
+         */
+        template <typename C>
+        class hasReset
+        {
+            template <typename U>
+            static auto check(U *u) -> decltype(u->reset(), std::true_type());
+
+            template <typename U>
+            static std::false_type check(...);
+
+        public:
+            static constexpr bool value = decltype(check<C>(nullptr))::value;
+        };
+    } // namespace any_controller_detail
+
+    /**
+     * @brief 任意のフィードバックコントローラを保持する型
+     * @details コントローラを実行時に選択したい場合に使う．
+     *          コントローラは内部のバッファに格納されるため動的確保を行わず，
+     *          呼び出しは仮想関数ではなく型ごとの関数ポインタ表を介して行う．
+     *          コントローラを保持していない場合，update()は何もせずgetControlVal()は0を返す．
+     *          保持できるのはupdate(T, T, T)とgetControlVal()を持つ型で，reset()を持たない型ではreset()は何もしない．
+     * @tparam T: 数値型
+     * @tparam Capacity: 内部バッファの大きさ[byte]（既定値はPID<T>が入る大きさ）
+    **/
+    template <typename T, std::size_t Capacity = sizeof(PID<T>)>
+    class AnyController : public FBController<AnyController<T, Capacity>, T>
+    {
+    public:
+        /**
+         * @brief コンストラクタ（コントローラを保持しない）
+         */
+        AnyController() = default;
+
+        /**
+         * @brief コンストラクタ コントローラで初期化
+         * @param fbc: 保持するコントローラ
+         */
+        template <typename C, typename std::enable_if<!std::is_same<typename std::decay<C>::type, AnyController>::value, int>::type = 0>
+        AnyController(C &&fbc) { emplace(std::forward<C>(fbc)); }
+
+        AnyController(const AnyController &other) { copyFrom(other); }
+
+        AnyController(AnyController &&other) { moveFrom(other); }
+
+        ~AnyController() { clear(); }
+
+        AnyController &operator=(const AnyController &other)
+        {
+            if (this != &other)
+            {
+                clear();
+                copyFrom(other);
+            }
+            return *this;
+        }
+
+        AnyController &operator=(AnyController &&other)
+        {
+            if (this != &other)
+            {
+                clear();
+                moveFrom(other);
+            }
+            return *this;
+        }
+
+        /**
+         * @brief 保持するコントローラの設定
+         * @param fbc: 保持するコントローラ
+         */
+        template <typename C>
+        void emplace(C &&fbc);
+
+        /**
+         * @brief 保持しているコントローラの破棄
+         */
+        void clear();
+
+        /**
+         * @brief コントローラを保持しているか
+         */
+        inline bool empty() const { return _ops == nullptr; }
+
+        /**
+         * @brief 保持しているコントローラの取得
+         * @return コントローラへのポインタ（型が異なる場合はnullptr）
+         */
+        template <typename C>
+        C *get();
+
+        /**
+         * @brief リセット
+         */
+        inline void reset()
+        {
+            if (_ops)
+                _ops->reset(_buf);
+        }
+
+        /**
+         * @brief 値の更新
+         * @param target: 目標値
+         * @param now_val: 現在値
+         * @param dt: 前回この関数をコールしてからの経過時間
+         */
+        inline void update(T target, T now_val, T dt)
+        {
+            if (_ops)
+                _ops->update(_buf, target, now_val, dt);
+        }
+
+        /**
+         * @brief 制御量（計算結果）の取得
+         * @return 制御量（計算結果）
+         * @attention update()を呼び出さないと値は更新されない
+         */
+        inline T getControlVal() { return _ops ? _ops->getControlVal(_buf) : T(0); }
+
+    private:
+        // 型ごとの操作をまとめた関数ポインタ表
+        struct ops_t
+        {
+            void (*reset)(void *);
+            void (*update)(void *, T, T, T);
+            T (*getControlVal)(void *);
+            void (*copy)(void *, const void *);
+            void (*move)(void *, void *);
+            void (*destroy)(void *);
+        };
+
+        template <typename C>
+        struct Ops
+        {
+            static void reset(void *p) { resetIf(static_cast<C *>(p), std::integral_constant<bool, any_controller_detail::hasReset<C>::value>()); }
+            static void resetIf(C *c, std::true_type) { c->reset(); }
+            static void resetIf(C *, std::false_type) {}
+            static void update(void *p, T target, T now_val, T dt) { static_cast<C *>(p)->update(target, now_val, dt); }
+            static T getControlVal(void *p) { return static_cast<C *>(p)->getControlVal(); }
+            static void copy(void *dst, const void *src) { new (dst) C(*static_cast<const C *>(src)); }
+            static void move(void *dst, void *src) { new (dst) C(std::move(*static_cast<C *>(src))); }
+            static void destroy(void *p) { static_cast<C *>(p)->~C(); }
+            static const ops_t table;
+        };
+
+        void copyFrom(const AnyController &other)
+        {
+            if (other._ops)
+                other._ops->copy(_buf, other._buf);
+            _ops = other._ops;
+        }
+
+        void moveFrom(AnyController &other)
+        {
+            if (other._ops)
+                other._ops->move(_buf, other._buf);
+            _ops = other._ops;
+        }
+
+        alignas(std::max_align_t) unsigned char _buf[Capacity];
+        const ops_t *_ops = nullptr;
+    };
+
+    template <typename T, std::size_t Capacity>
+    template <typename C>
+    const typename AnyController<T, Capacity>::ops_t AnyController<T, Capacity>::Ops<C>::table = {
+        &Ops<C>::reset, &Ops<C>::update, &Ops<C>::getControlVal, &Ops<C>::copy, &Ops<C>::move, &Ops<C>::destroy};
+
+    template <typename T, std::size_t Capacity>
+    template <typename C>
+    void AnyController<T, Capacity>::emplace(C &&fbc)
+    {
+        using type = typename std::decay<C>::type;
+        static_assert(isFBController<type, T>::value, "C must have update(T, T, T) and getControlVal() (reset() is optional)");
+        static_assert(sizeof(type) <= Capacity, "controller does not fit in AnyController; increase Capacity");
+        static_assert(alignof(type) <= alignof(std::max_align_t), "over-aligned controllers are not supported");
+
+        clear();
+        new (_buf) type(std::forward<C>(fbc));
+        _ops = &Ops<type>::table;
+    }
+
+    template <typename T, std::size_t Capacity>
+    void AnyController<T, Capacity>::clear()
+    {
+        if (_ops)
+            _ops->destroy(_buf);
+        _ops = nullptr;
+    }
+
+    template <typename T, std::size_t Capacity>
+    template <typename C>
+    C *AnyController<T, Capacity>::get()
+    {
+        return (_ops == &Ops<C>::table) ? static_cast<C *>(static_cast<void *>(_buf)) : nullptr;
+    }
+
+} // namespace myStd
+
+#endif // AnyController_h
@@ -7,5 +7,7 @@
 
 #include "IFBController.h"
 #include "PID.h"
+#include "PIDBank.h"
+#include "AnyController.h"
 
 #endif // FBController_h
\ No newline at end of file
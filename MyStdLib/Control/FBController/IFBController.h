@@ -8,56 +8,75 @@
 #include <iostream>
 #include <cmath>
 #include <array>
+#include <type_traits>
 #include "./../../MyStdFunctions.h"
 
 namespace myStd
 {
     /**
-     * @brief フィードバックコントローラの基底クラス
+     * @brief フィードバックコントローラの基底クラス（CRTP）
+     * @details 仮想関数を使わず，派生クラスのメンバをコンパイル時に呼び出すためインライン展開される．
+     *          派生クラスはreset(), update(T, T, T), getControlVal()を実装する．
+     * @tparam Derived: 派生クラス
+     * @tparam T: 数値型
     **/
+    template <typename Derived, typename T>
     class FBController
     {
     public:
         /**
          * @brief リセット
          */
-        void reset();
+        inline void reset() { derived().reset(); }
 
         /**
-         * @brief パラメータの設定
+         * @brief 値の更新
+         * @param target: 目標値
+         * @param now_val: 現在値
+         * @param dt: 前回この関数をコールしてからの経過時間
          */
-        template <class... Args>
-        void setParam(Args... args);
+        inline void update(T target, T now_val, T dt) { derived().update(target, now_val, dt); }
 
         /**
-         * @brief ゲインの設定
+         * @brief 制御量（計算結果）の取得
+         * @return 制御量（計算結果）
          */
-        template <class... Args>
-        void setGain(Args... args);
+        inline T getControlVal() { return derived().getControlVal(); }
 
-        /**
-         * @brief モードの設定
-         */
-        template <class... Args>
-        void setMode(Args... args);
+    protected:
+        FBController() = default;
 
-        /**
-         * @brief 出力の最小，最大値の設定
-         */
-        template <class... Args>
-        void setSaturation(Args... args);
+    private:
+        inline Derived &derived() { return static_cast<Derived &>(*this); }
+    };
 
-        /**
-         * @brief 値の更新
-         */
-        void update(double target, double now_val, double dt);
+    /**
+     * @brief Cがフィードバックコントローラとして使えるか判定する
+     * @details update(T, T, T)とTに変換可能なgetControlVal()を持つ型であればtrue
+     *          （FBControllerを継承していない型も可）
+     * @tparam C: 判定する型
+     * @tparam T: 数値型
+    **/
+    template <typename C, typename T>
+    class isFBController
+    {
+        template <typename U>
+        static auto check(U *u) -> decltype(u->update(T(), T(), T()), static_cast<T>(u->getControlVal()), std::true_type());
 
-        /**
-         * @brief 制御量（計算結果）の取得
-         */
-        template <typename T>
-        T getControlVal();
+        template <typename U>
+        static std::false_type check(...);
+
+    public:
+        static constexpr bool value = decltype(check<C>(nullptr))::value;
     };
+
+#if defined(__cpp_concepts) && __cpp_concepts >= 201907L
+    /**
+     * @brief フィードバックコントローラのコンセプト（C++20以降）
+    **/
+    template <typename C, typename T>
+    concept FeedbackController = isFBController<C, T>::value;
+#endif
 } // namespace myStd
 
 #endif // IFBController_h
\ No newline at end of file
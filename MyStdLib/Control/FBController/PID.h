@@ -8,16 +8,38 @@
 #include <iostream>
 #include <cmath>
 #include <array>
+#include <limits>
 #include "./../../MyStdFunctions.h"
+#include "./../../Instrument.h"
+#include "./../../Trace.h"
 #include "IFBController.h"
+#include "PIDMode.h"
 
 namespace myStd
 {
     /**
      * @brief PIDの計算
+     * @tparam T: 数値型
+     * @tparam ModePolicy: PIDモードのポリシークラス（PIDMode::pPIDなど）
+     *                     省略時はPIDMode::Runtimeとなり，モードを実行時に切り替えられる
+    **/
+    template <typename T, typename ModePolicy = PIDMode::Runtime>
+    class PID;
+
+    namespace pid_detail
+    {
+        // 積分値を持たないモード（sPID）は0とする
+        template <typename S>
+        inline auto integralOf(const S &s) -> decltype(s.integral) { return s.integral; }
+        template <typename S, typename... Dummy>
+        inline int integralOf(const S &, Dummy...) { return 0; }
+    } // namespace pid_detail
+
+    /**
+     * @brief PIDの計算（モードを実行時に切り替える）
     **/
     template <typename T>
-    class PID : FBController
+    class PID<T, PIDMode::Runtime> : public FBController<PID<T, PIDMode::Runtime>, T>
     {
     public:
         /**
@@ -122,8 +144,31 @@ namespace myStd
          */
         inline T getControlVal() { return output; };
 
+#if defined(MYSTD_TRACE)
+        /**
+         * @brief トレースの書き込み先の設定（MYSTD_TRACEを定義した場合のみ）
+         * @details update()の度にTraceKind::PIDのレコードを書き込む
+         * @param ring: 書き込み先（update()を呼ぶスレッドのリング，nullptrで書き込みを止める）
+         * @param source: 記録元の番号
+         */
+        inline void setTrace(TraceRing *ring, std::uint32_t source)
+        {
+            _trace = ring;
+            _trace_source = source;
+        }
+#endif
+
+#if defined(MYSTD_INSTRUMENTATION)
+        /**
+         * @brief 計測値の取得（MYSTD_INSTRUMENTATIONを定義した場合のみ）
+         * @return update()の処理時間，出力制限の回数，積分値の大きさ
+         */
+        inline ControllerProbe &getProbe() { return _probe; }
+        inline const ControllerProbe &getProbe() const { return _probe; }
+#endif
+
     private:
-        param_t _param;
+        param_t _param = {Mode::pPID, {0, 0, 0}, false, 0, 0};
         inline T calculate_pPID(T target, T now_val, T dt);
         inline T calculate_sPID(T target, T now_val, T dt);
         inline T calculate_PI_D(T target, T now_val, T dt);
@@ -134,6 +179,8 @@ namespace myStd
         T prev_val, prev_target;
         T integral;
         T output;
+        MYSTD_PROBE_MEMBER(_probe)
+        MYSTD_TRACE_MEMBER(_trace, _trace_source)
     };
 
     template <typename T>
@@ -156,30 +203,40 @@ namespace myStd
     template <typename T>
     inline void PID<T>::update(T target, T now_val, T dt)
     {
+        MYSTD_PROBE_SCOPE(_probe);
         diff[0] = target - now_val;                   // 最新の偏差
-        integral += (diff[0] + diff[1]) * (dt / 2.0); // 積分
+        integral += (diff[0] + diff[1]) * (dt / 2); // 積分
 
         switch (_param.mode)
         {
         case Mode::pPID:
             output = calculate_pPID(target, now_val, dt);
+            break;
         case Mode::sPID:
             output = calculate_sPID(target, now_val, dt);
+            break;
         case Mode::PI_D:
             output = calculate_PI_D(target, now_val, dt);
+            break;
         case Mode::I_PD:
             output = calculate_I_PD(target, now_val, dt);
+            break;
+        }
+
+        // ガード処理
+        if (_param.need_saturation)
+        {
+            MYSTD_PROBE_SATURATION(_probe, output, _param.output_min, _param.output_max);
+            output = (_param.need_saturation) ? guard(output, _param.output_min, _param.output_max) : output;
         }
+        MYSTD_PROBE_INTEGRAL(_probe, integral);
+        MYSTD_TRACE_WRITE(_trace, _trace_source, TraceKind::PID, target, now_val, diff[0], diff[1], diff[2], integral, output);
 
         // 次回ループのために今回の値を前回の値にする
         diff[2] = diff[1];
         diff[1] = diff[0];
         prev_target = target;
         prev_val = now_val;
-
-        // ガード処理
-        if (_param.need_saturation)
-            output = (_param.need_saturation) ? guard(output, _param.output_min, _param.output_max) : output;
     }
 
     template <typename T>
@@ -221,6 +278,147 @@ namespace myStd
         return p + i + d;
     }
 
+    /**
+     * @brief PIDの計算（モードをコンパイル時に決定する）
+     * @details モードの分岐がなく，そのモードで使用する内部状態と計算のみを持つ．
+     *          計算結果は同じモードのPID<T>と一致する．
+    **/
+    template <typename T, typename ModePolicy>
+    class PID : public FBController<PID<T, ModePolicy>, T>
+    {
+    public:
+        using gain_t = typename PID<T>::gain_t;
+
+        /**
+         * @brief パラメータ構造体
+         */
+        struct param_t
+        {
+            gain_t gain;          /**< PIDゲイン */
+            bool need_saturation; /**< 出力制限を行うか */
+            T output_min;         /**< 出力制限時の最小値 */
+            T output_max;         /**< 出力制限時の最大値 */
+        };
+
+        /**
+         * @brief コンストラクタ
+         */
+        PID() = default;
+
+        /**
+         * @brief コンストラクタ PIDゲインで初期化
+         * @param kp: 比例ゲイン
+         * @param ki: 微分ゲイン
+         * @param kd: 積分ゲイン
+         */
+        PID(T kp, T ki, T kd)
+        {
+            _param.gain.Kp = kp;
+            _param.gain.Ki = ki;
+            _param.gain.Kd = kd;
+        }
+
+        /**
+         * @brief コンストラクタ パラメータ構造体で初期化
+         * @param param: パラメータ構造体
+         */
+        PID(param_t param) : _param(param) {}
+
+        /**
+         * @brief リセット
+         */
+        void reset()
+        {
+            _state = state_t();
+            output = 0.0;
+        }
+
+        /**
+         * @brief パラメータの設定
+         * @param param: パラメータ構造体
+         */
+        inline void setParam(const param_t param) { _param = param; }
+
+        /**
+         * @brief ゲインの設定
+         * @param gain: ゲイン構造体
+         */
+        inline void setGain(const gain_t gain) { _param.gain = gain; }
+
+        /**
+         * @brief 出力の最小，最大値の設定
+         * @param min_v: 最小値
+         * @param min_v: 最大値
+         */
+        inline void setSaturation(T min_v, T max_v)
+        {
+            _param.need_saturation = true;
+            _param.output_min = min_v;
+            _param.output_max = max_v;
+        }
+
+        /**
+         * @brief 値の更新
+         * @param target: 目標値
+         * @param now_val: 現在値
+         * @param dt: 前回この関数をコールしてからの経過時間
+         */
+        inline void update(T target, T now_val, T dt)
+        {
+            MYSTD_PROBE_SCOPE(_probe);
+            output = ModePolicy::calculate(_state, _param.gain, target, now_val, dt);
+            MYSTD_PROBE_INTEGRAL(_probe, pid_detail::integralOf(_state));
+
+            // ガード処理
+            if (_param.need_saturation)
+            {
+                MYSTD_PROBE_SATURATION(_probe, output, _param.output_min, _param.output_max);
+                output = guard(output, _param.output_min, _param.output_max);
+            }
+            MYSTD_TRACE_WRITE(_trace, _trace_source, TraceKind::PID, target, now_val, target - now_val,
+                              std::numeric_limits<T>::quiet_NaN(), std::numeric_limits<T>::quiet_NaN(), pid_detail::integralOf(_state), output);
+        }
+
+        /**
+         * @brief 制御量（PIDの計算結果）の取得
+         * @return 制御量（PIDの計算結果）
+         * @attention update()を呼び出さないと値は更新されない
+         */
+        inline T getControlVal() { return output; };
+
+#if defined(MYSTD_TRACE)
+        /**
+         * @brief トレースの書き込み先の設定（MYSTD_TRACEを定義した場合のみ）
+         * @details update()の度にTraceKind::PIDのレコードを書き込む（diff[1]，diff[2]は内部状態に無いためNaN）
+         * @param ring: 書き込み先（update()を呼ぶスレッドのリング，nullptrで書き込みを止める）
+         * @param source: 記録元の番号
+         */
+        inline void setTrace(TraceRing *ring, std::uint32_t source)
+        {
+            _trace = ring;
+            _trace_source = source;
+        }
+#endif
+
+#if defined(MYSTD_INSTRUMENTATION)
+        /**
+         * @brief 計測値の取得（MYSTD_INSTRUMENTATIONを定義した場合のみ）
+         * @return update()の処理時間，出力制限の回数，積分値の大きさ
+         */
+        inline ControllerProbe &getProbe() { return _probe; }
+        inline const ControllerProbe &getProbe() const { return _probe; }
+#endif
+
+    private:
+        using state_t = typename ModePolicy::template state_t<T>;
+
+        param_t _param = {{0, 0, 0}, false, 0, 0};
+        state_t _state;
+        T output = 0;
+        MYSTD_PROBE_MEMBER(_probe)
+        MYSTD_TRACE_MEMBER(_trace, _trace_source)
+    };
+
 } // namespace myStd
 
 #endif // PID_h
@@ -0,0 +1,248 @@
+/**
+ * @file PIDBank.h
+ * @brief 多数のPIDをまとめて計算する
+**/
+#ifndef PIDBank_h
+#define PIDBank_h
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+#include "./../../MyStdFunctions.h"
+#include "PID.h"
+
+namespace myStd
+{
+    /**
+     * @brief 多数のPIDをまとめて計算する
+     * @details ゲインや偏差などを要素ごとの配列（Structure of Arrays）で保持し，
+     *          全ループを1回のupdate()で計算する．ループ内に分岐がないためコンパイラの自動ベクトル化が効く．
+     *          計算式はPID<T>と同一で，同じ入力に対して同じ結果を返す．
+     * @tparam T: 数値型
+     * @tparam M: PIDモード（全ループ共通）
+    **/
+    template <typename T, typename PID<T>::Mode M>
+    class PIDBank
+    {
+    public:
+        using Mode = typename PID<T>::Mode;
+        using gain_t = typename PID<T>::gain_t;
+
+        /**
+         * @brief コンストラクタ
+         */
+        PIDBank() = default;
+
+        /**
+         * @brief コンストラクタ ループ数で初期化
+         * @param n: ループ数
+         */
+        explicit PIDBank(std::size_t n) { resize(n); }
+
+        /**
+         * @brief ループ数の変更（全ループのゲイン，出力制限，内部状態は初期化される）
+         * @param n: ループ数
+         */
+        void resize(std::size_t n);
+
+        /**
+         * @brief ループ数の取得
+         * @return ループ数
+         */
+        inline std::size_t size() const { return _output.size(); }
+
+        /**
+         * @brief 全ループのリセット
+         */
+        void reset();
+
+        /**
+         * @brief 指定ループのリセット
+         * @param i: ループのインデックス
+         */
+        void reset(std::size_t i);
+
+        /**
+         * @brief 全ループのゲインの設定
+         * @param gain: ゲイン構造体
+         */
+        void setGain(const gain_t gain);
+
+        /**
+         * @brief 指定ループのゲインの設定
+         * @param i: ループのインデックス
+         * @param gain: ゲイン構造体
+         */
+        inline void setGain(std::size_t i, const gain_t gain);
+
+        /**
+         * @brief 全ループの出力の最小，最大値の設定
+         * @param min_v: 最小値
+         * @param max_v: 最大値
+         */
+        void setSaturation(T min_v, T max_v);
+
+        /**
+         * @brief 指定ループの出力の最小，最大値の設定
+         * @param i: ループのインデックス
+         * @param min_v: 最小値
+         * @param max_v: 最大値
+         */
+        inline void setSaturation(std::size_t i, T min_v, T max_v);
+
+        /**
+         * @brief 全ループの値の更新
+         * @param targets: 目標値の配列（要素数size()）
+         * @param now_vals: 現在値の配列（要素数size()）
+         * @param dt: 前回この関数をコールしてからの経過時間
+         */
+        inline void update(const T *targets, const T *now_vals, T dt);
+
+        /**
+         * @brief 指定ループの制御量（PIDの計算結果）の取得
+         * @param i: ループのインデックス
+         * @return 制御量（PIDの計算結果）
+         * @attention update()を呼び出さないと値は更新されない
+         */
+        inline T getControlVal(std::size_t i) const { return _output[i]; }
+
+        /**
+         * @brief 全ループの制御量（PIDの計算結果）の取得
+         * @return 制御量の配列の先頭ポインタ（要素数size()）
+         * @attention update()を呼び出さないと値は更新されない
+         */
+        inline const T *getControlVals() const { return _output.data(); }
+
+    private:
+        // 出力制限なしを表す値
+        static constexpr T noLimitMin() { return std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::lowest(); }
+        static constexpr T noLimitMax() { return std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max(); }
+
+        static inline void calculate(std::size_t n, const T *__restrict targets, const T *__restrict now_vals, T dt,
+                                     const T *__restrict kp, const T *__restrict ki, const T *__restrict kd,
+                                     const T *__restrict out_min, const T *__restrict out_max,
+                                     T *__restrict diff1, T *__restrict diff2, T *__restrict prev_val,
+                                     T *__restrict integral, T *__restrict output);
+
+        // ゲイン
+        std::vector<T> _kp, _ki, _kd;
+        std::vector<T> _output_min, _output_max;
+
+        // リセットするやつ
+        // 現在の偏差はupdate()内でのみ使うため，過去と大過去の偏差のみ保持する
+        std::vector<T> _diff1, _diff2; // 1: 過去, 2: 大過去
+        std::vector<T> _prev_val;
+        std::vector<T> _integral;
+        std::vector<T> _output;
+    };
+
+    template <typename T, typename PID<T>::Mode M>
+    void PIDBank<T, M>::resize(std::size_t n)
+    {
+        _kp.assign(n, 0);
+        _ki.assign(n, 0);
+        _kd.assign(n, 0);
+        _output_min.assign(n, noLimitMin());
+        _output_max.assign(n, noLimitMax());
+        _diff1.assign(n, 0);
+        _diff2.assign(n, 0);
+        _prev_val.assign(n, 0);
+        _integral.assign(n, 0);
+        _output.assign(n, 0);
+    }
+
+    template <typename T, typename PID<T>::Mode M>
+    void PIDBank<T, M>::reset()
+    {
+        for (std::size_t i = 0; i < size(); i++)
+            reset(i);
+    }
+
+    template <typename T, typename PID<T>::Mode M>
+    void PIDBank<T, M>::reset(std::size_t i)
+    {
+        _diff1[i] = _diff2[i] = 0.0;
+        _prev_val[i] = 0.0;
+        _integral[i] = 0.0;
+        _output[i] = 0.0;
+    }
+
+    template <typename T, typename PID<T>::Mode M>
+    void PIDBank<T, M>::setGain(const gain_t gain)
+    {
+        for (std::size_t i = 0; i < size(); i++)
+            setGain(i, gain);
+    }
+
+    template <typename T, typename PID<T>::Mode M>
+    inline void PIDBank<T, M>::setGain(std::size_t i, const gain_t gain)
+    {
+        _kp[i] = gain.Kp;
+        _ki[i] = gain.Ki;
+        _kd[i] = gain.Kd;
+    }
+
+    template <typename T, typename PID<T>::Mode M>
+    void PIDBank<T, M>::setSaturation(T min_v, T max_v)
+    {
+        for (std::size_t i = 0; i < size(); i++)
+            setSaturation(i, min_v, max_v);
+    }
+
+    template <typename T, typename PID<T>::Mode M>
+    inline void PIDBank<T, M>::setSaturation(std::size_t i, T min_v, T max_v)
+    {
+        _output_min[i] = min_v;
+        _output_max[i] = max_v;
+    }
+
+    template <typename T, typename PID<T>::Mode M>
+    inline void PIDBank<T, M>::update(const T *targets, const T *now_vals, T dt)
+    {
+        calculate(size(), targets, now_vals, dt,
+                  _kp.data(), _ki.data(), _kd.data(), _output_min.data(), _output_max.data(),
+                  _diff1.data(), _diff2.data(), _prev_val.data(), _integral.data(), _output.data());
+    }
+
+    // 各配列は互いに重ならないためrestrictを付け，ベクトル化の妨げとなる実行時の重なりチェックを省く
+    template <typename T, typename PID<T>::Mode M>
+    inline void PIDBank<T, M>::calculate(std::size_t n, const T *__restrict targets, const T *__restrict now_vals, T dt,
+                                         const T *__restrict kp, const T *__restrict ki, const T *__restrict kd,
+                                         const T *__restrict out_min, const T *__restrict out_max,
+                                         T *__restrict diff1, T *__restrict diff2, T *__restrict prev_val,
+                                         T *__restrict integral, T *__restrict output)
+    {
+        // 各項の式はPID<T>::calculate_*と同じ順序で計算する（結果を一致させるため）
+        for (std::size_t i = 0; i < n; i++)
+        {
+            T e = targets[i] - now_vals[i]; // 最新の偏差
+            T out;
+            if (M == Mode::sPID)
+            {
+                T p = kp[i] * e - diff1[i];
+                T in = ki[i] * e * dt;
+                T d = kd[i] * (e - 2 * diff1[i] + diff2[i]) / dt;
+                out = prev_val[i] + p + in + d;
+            }
+            else
+            {
+                integral[i] += (e + diff1[i]) * (dt / 2); // 積分
+                T p = (M == Mode::I_PD) ? -kp[i] * now_vals[i] : kp[i] * e;
+                T in = ki[i] * integral[i];
+                T d = (M == Mode::pPID) ? kd[i] * ((e - diff1[i]) / dt) : -kd[i] * ((now_vals[i] - prev_val[i]) / dt);
+                out = p + in + d;
+            }
+
+            // 次回ループのために今回の値を前回の値にする
+            diff2[i] = diff1[i];
+            diff1[i] = e;
+            prev_val[i] = now_vals[i];
+
+            // ガード処理（出力制限なしの場合は±∞で制限するため値は変わらない）
+            output[i] = guard(out, out_min[i], out_max[i]);
+        }
+    }
+
+} // namespace myStd
+
+#endif // PIDBank_h
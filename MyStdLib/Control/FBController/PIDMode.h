@@ -0,0 +1,132 @@
+/**
+ * @file PIDMode.h
+ * @brief PIDモードをコンパイル時に指定するためのポリシークラス
+**/
+#ifndef PIDMode_h
+#define PIDMode_h
+
+namespace myStd
+{
+    /**
+     * @brief PIDモードのポリシークラス
+     * @details PID<T, ModePolicy>のModePolicyに指定する．
+     *          各ポリシーはそのモードに必要な内部状態state_tと計算calculate()のみを持つ．
+    **/
+    namespace PIDMode
+    {
+        /**
+         * @brief 実行時にモードを切り替える（PID<T>の既定値）
+         */
+        struct Runtime
+        {
+        };
+
+        /**
+         * @brief 位置型PID
+         */
+        struct pPID
+        {
+            template <typename T>
+            struct state_t
+            {
+                T diff = 0;     /**< 前回の偏差 */
+                T integral = 0; /**< 偏差の積分値 */
+            };
+
+            template <typename T, typename G>
+            static inline T calculate(state_t<T> &s, const G &gain, T target, T now_val, T dt)
+            {
+                T diff = target - now_val;
+                s.integral += (diff + s.diff) * (dt / 2);
+                T p = gain.Kp * diff;
+                T i = gain.Ki * s.integral;
+                T d = gain.Kd * ((diff - s.diff) / dt);
+                s.diff = diff;
+                return p + i + d;
+            }
+        };
+
+        /**
+         * @brief 速度型PID
+         */
+        struct sPID
+        {
+            template <typename T>
+            struct state_t
+            {
+                T diff[2] = {0, 0}; /**< 0: 過去, 1: 大過去の偏差 */
+                T prev_val = 0;     /**< 前回の現在値 */
+            };
+
+            template <typename T, typename G>
+            static inline T calculate(state_t<T> &s, const G &gain, T target, T now_val, T dt)
+            {
+                T diff = target - now_val;
+                T p = gain.Kp * diff - s.diff[0];
+                T i = gain.Ki * diff * dt;
+                T d = gain.Kd * (diff - 2 * s.diff[0] + s.diff[1]) / dt;
+                T output = s.prev_val + p + i + d;
+                s.diff[1] = s.diff[0];
+                s.diff[0] = diff;
+                s.prev_val = now_val;
+                return output;
+            }
+        };
+
+        /**
+         * @brief 微分先行型PID
+         */
+        struct PI_D
+        {
+            template <typename T>
+            struct state_t
+            {
+                T diff = 0;     /**< 前回の偏差 */
+                T prev_val = 0; /**< 前回の現在値 */
+                T integral = 0; /**< 偏差の積分値 */
+            };
+
+            template <typename T, typename G>
+            static inline T calculate(state_t<T> &s, const G &gain, T target, T now_val, T dt)
+            {
+                T diff = target - now_val;
+                s.integral += (diff + s.diff) * (dt / 2);
+                T p = gain.Kp * diff;
+                T i = gain.Ki * s.integral;
+                T d = -gain.Kd * ((now_val - s.prev_val) / dt);
+                s.diff = diff;
+                s.prev_val = now_val;
+                return p + i + d;
+            }
+        };
+
+        /**
+         * @brief 比例微分先行型PID
+         */
+        struct I_PD
+        {
+            template <typename T>
+            struct state_t
+            {
+                T diff = 0;     /**< 前回の偏差 */
+                T prev_val = 0; /**< 前回の現在値 */
+                T integral = 0; /**< 偏差の積分値 */
+            };
+
+            template <typename T, typename G>
+            static inline T calculate(state_t<T> &s, const G &gain, T target, T now_val, T dt)
+            {
+                T diff = target - now_val;
+                s.integral += (diff + s.diff) * (dt / 2);
+                T p = -gain.Kp * now_val;
+                T i = gain.Ki * s.integral;
+                T d = -gain.Kd * ((now_val - s.prev_val) / dt);
+                s.diff = diff;
+                s.prev_val = now_val;
+                return p + i + d;
+            }
+        };
+    } // namespace PIDMode
+} // namespace myStd
+
+#endif // PIDMode_h
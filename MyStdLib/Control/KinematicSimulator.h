@@ -0,0 +1,323 @@
+/**
+ * @file KinematicSimulator.h
+ * @brief 差動二輪型，全方位移動型ロボットの運動学シミュレータ（固定ステップ）
+ * @attention オフラインの検証用のためControl.hからはincludeされない．使う場合はこのファイルを直接includeすること
+**/
+#ifndef KinematicSimulator_h
+#define KinematicSimulator_h
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "./../MyStdFunctions.h"
+#include "./../FastMath.h"
+#include "./../Vector/Vector.h"
+#include "PurePursuitControl.h"
+
+namespace myStd
+{
+    /**
+     * @brief 差動二輪型，全方位移動型ロボットの運動学シミュレータ（固定ステップ）
+     * @details 速度指令（ロボット座標系のx, y方向の速度と角速度，PurePursuitControl::getControlVal()の出力）を
+     *          一定の刻み幅dtで積分して位置を求める．1ステップの間は速度一定として円弧に沿って厳密に積分する．
+     *          差動二輪型（Mode::diff）は横方向の速度（y）を無視する．
+     *
+     *          アクチュエータのモデルとして，指令の遅れ（ステップ数），速度と加速度の制限，
+     *          速度に加わる正規分布の雑音を順に適用する（いずれも省略可）．
+     *          雑音の乱数は独自の生成器（xoshiro256+）を使うため，同じプラットフォームでは同じシードと指令列から同じ結果になる
+     *          （std::normal_distributionのように標準ライブラリの実装には依存しないが，sqrt()やlog()などの丸め，
+     *          MYSTD_FAST_MATHの有無，FMAへの変換によってコンパイラやCPUが変わると結果が変わり得る）．
+     *
+     *          step()はメモリ確保を行わず，三角関数はステップごとにtrigSinCos()を1回呼ぶだけである
+     *          （MYSTD_FAST_MATHを定義すると近似版になる）．
+     * @code
+     *          myStd::KinematicSimulator<double>::param_t param = myStd::KinematicSimulator<double>::defaultParam();
+     *          param.dt = 0.001;
+     *          param.delay_steps = 5;
+     *          myStd::KinematicSimulator<double> sim(param);
+     *          sim.run(10000, [&](const myStd::Pose2D<double> &pose, double dt) {
+     *              ppc.update(pose, dt);
+     *              return ppc.getControlVal();
+     *          });
+     * @endcode
+     * @tparam T: 数値型
+    **/
+    template <typename T>
+    class KinematicSimulator
+    {
+    public:
+        /**
+         * @brief モードリスト（PurePursuitControl::Modeと同じ型）
+         */
+        using Mode = PurePursuitMode;
+
+        /**
+         * @brief パラメータ構造体
+         */
+        struct param_t
+        {
+            Mode mode;              /**< モード */
+            T dt;                   /**< 刻み幅[s] */
+            int delay_steps;        /**< 指令が反映されるまでのステップ数（0で遅れ無し） */
+            bool need_saturation;   /**< 速度，加速度の制限を行うか */
+            Pose2D<T> vel_max;      /**< 速度の絶対値の最大値（x, y, theta，need_saturationの場合は全ての成分を設定する） */
+            Pose2D<T> accel_max;    /**< 加速度の絶対値の最大値（x, y, theta，0の成分は制限しない） */
+            Pose2D<T> noise_stddev; /**< 速度に加える雑音の標準偏差（x, y, theta，0の成分は加えない） */
+            std::uint64_t seed;     /**< 雑音の乱数のシード */
+        };
+
+        /**
+         * @brief 既定のパラメータ（差動二輪型，dt = 1ms，遅れ，制限，雑音なし）
+         */
+        static param_t defaultParam()
+        {
+            param_t p;
+            p.mode = Mode::diff;
+            p.dt = T(0.001);
+            p.delay_steps = 0;
+            p.need_saturation = false;
+            p.vel_max = Pose2D<T>(0, 0, 0);
+            p.accel_max = Pose2D<T>(0, 0, 0);
+            p.noise_stddev = Pose2D<T>(0, 0, 0);
+            p.seed = 1;
+            return p;
+        }
+
+        /**
+         * @brief コンストラクタ
+         * @param param: パラメータ構造体
+         * @param init_pose: 初期位置
+         */
+        explicit KinematicSimulator(const param_t &param = defaultParam(), const Pose2D<T> &init_pose = Pose2D<T>(0, 0, 0))
+        {
+            setParam(param);
+            reset(init_pose);
+        }
+
+        /**
+         * @brief パラメータの設定（遅れのバッファを確保し直すため，続けてreset()を呼ぶこと）
+         * @param param: パラメータ構造体
+         */
+        void setParam(const param_t &param)
+        {
+            _param = param;
+            _param.delay_steps = max(_param.delay_steps, 0);
+            _delay.assign(static_cast<std::size_t>(_param.delay_steps), Pose2D<T>(0, 0, 0));
+        }
+
+        /**
+         * @brief パラメータの取得
+         */
+        inline const param_t &getParam() const { return _param; }
+
+        /**
+         * @brief 初期化（時刻，速度，遅れのバッファ，乱数を初期状態に戻す）
+         * @param init_pose: 初期位置
+         */
+        void reset(const Pose2D<T> &init_pose = Pose2D<T>(0, 0, 0))
+        {
+            _pose = init_pose;
+            _pose.theta = normalizeAngle(_pose.theta);
+            trigSinCos(_pose.theta, _sin, _cos);
+            _vel = Pose2D<T>(0, 0, 0);
+            for (Pose2D<T> &cmd : _delay)
+                cmd = Pose2D<T>(0, 0, 0);
+            _delay_head = 0;
+            _steps = 0;
+
+            // splitmix64でシードを展開する
+            std::uint64_t z = _param.seed;
+            for (std::uint64_t &s : _rng)
+            {
+                z += 0x9e3779b97f4a7c15ULL;
+                std::uint64_t x = z;
+                x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+                x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+                s = x ^ (x >> 31);
+            }
+            _has_spare = false;
+        }
+
+        /**
+         * @brief 1ステップ進める
+         * @param cmd: 速度指令（ロボット座標系のx, y方向の速度と角速度）
+         * @return 更新後の位置
+         */
+        inline const Pose2D<T> &step(const Pose2D<T> &cmd);
+
+        /**
+         * @brief 閉ループで複数ステップ進める
+         * @param num_steps: ステップ数
+         * @param controller: controller(pose, dt)で速度指令を返す関数（PurePursuitControlのupdate()とgetControlVal()など）
+         * @return 更新後の位置
+         */
+        template <typename F>
+        inline const Pose2D<T> &run(std::size_t num_steps, F &&controller)
+        {
+            for (std::size_t i = 0; i < num_steps; i++)
+                step(controller(static_cast<const Pose2D<T> &>(_pose), _param.dt));
+            return _pose;
+        }
+
+        /**
+         * @brief 現在位置の取得
+         */
+        inline const Pose2D<T> &getPose() const { return _pose; }
+
+        /**
+         * @brief 現在の速度（遅れと制限を適用した後のロボット座標系の速度，雑音は含まない）の取得
+         */
+        inline const Pose2D<T> &getVelocity() const { return _vel; }
+
+        /**
+         * @brief 経過時間[s]の取得
+         */
+        inline T getTime() const { return static_cast<T>(_steps) * _param.dt; }
+
+        /**
+         * @brief 経過ステップ数の取得
+         */
+        inline std::uint64_t getSteps() const { return _steps; }
+
+    private:
+        inline T limit(T v, T prev, T v_max, T a_max) const;
+        inline T gaussian();
+        inline std::uint64_t nextRandom();
+
+        param_t _param;
+        Pose2D<T> _pose;
+        T _sin, _cos; // 姿勢角のsin, cos（ステップごとに回転させて更新する）
+        Pose2D<T> _vel;
+        std::vector<Pose2D<T>> _delay; // 遅れのバッファ（delay_steps個のリング）
+        std::size_t _delay_head = 0;
+        std::uint64_t _steps = 0;
+        std::uint64_t _rng[4];
+        T _spare = 0;
+        bool _has_spare = false;
+    };
+
+    template <typename T>
+    inline const Pose2D<T> &KinematicSimulator<T>::step(const Pose2D<T> &cmd)
+    {
+        const T dt = _param.dt;
+
+        // 遅れ: delay_steps前の指令を取り出し，今回の指令と入れ替える
+        Pose2D<T> u = cmd;
+        if (!_delay.empty())
+        {
+            Pose2D<T> &slot = _delay[_delay_head];
+            u = slot;
+            slot = cmd;
+            _delay_head = (_delay_head + 1 == _delay.size()) ? 0 : _delay_head + 1;
+        }
+        if (_param.mode == Mode::diff)
+            u.y = 0;
+
+        // 速度，加速度の制限
+        if (_param.need_saturation)
+        {
+            u.x = limit(u.x, _vel.x, _param.vel_max.x, _param.accel_max.x * dt);
+            u.y = limit(u.y, _vel.y, _param.vel_max.y, _param.accel_max.y * dt);
+            u.theta = limit(u.theta, _vel.theta, _param.vel_max.theta, _param.accel_max.theta * dt);
+        }
+        _vel = u;
+
+        // 雑音（次のステップの加速度制限には雑音を含まない速度を使う）
+        if (_param.noise_stddev.x > 0)
+            u.x += _param.noise_stddev.x * gaussian();
+        if (_param.noise_stddev.y > 0 && _param.mode == Mode::omni)
+            u.y += _param.noise_stddev.y * gaussian();
+        if (_param.noise_stddev.theta > 0)
+            u.theta += _param.noise_stddev.theta * gaussian();
+
+        // 角速度一定の円弧に沿って積分する
+        // ロボット座標系での移動量 = [sin(a)/w, -(1-cos(a))/w; (1-cos(a))/w, sin(a)/w] * (vx, vy)，a = w * dt
+        const T a = u.theta * dt;
+        T sa, ca;
+        trigSinCos(a, sa, ca);
+        T k_sin, k_cos; // sin(a)/a, (1-cos(a))/a
+        if (std::abs(a) < T(1e-4))
+        {
+            const T a2 = a * a;
+            k_sin = 1 - a2 / 6;
+            k_cos = a / 2 - a * a2 / 24;
+        }
+        else
+        {
+            k_sin = sa / a;
+            k_cos = (1 - ca) / a;
+        }
+        const T dx = (k_sin * u.x - k_cos * u.y) * dt;
+        const T dy = (k_cos * u.x + k_sin * u.y) * dt;
+        _pose.x += _cos * dx - _sin * dy;
+        _pose.y += _sin * dx + _cos * dy;
+
+        // 姿勢角のsin, cosを回転させ，大きさを1に戻す（ニュートン法1回）
+        const T c = _cos * ca - _sin * sa;
+        const T s = _sin * ca + _cos * sa;
+        const T scale = (3 - (c * c + s * s)) / 2;
+        _cos = c * scale;
+        _sin = s * scale;
+        // 1ステップの回転は通常πより小さいため，fmodを使わずに範囲へ戻す
+        T theta = _pose.theta + a;
+        if (std::abs(a) <= T(PI))
+        {
+            theta = (theta > T(PI)) ? theta - T(2 * PI) : theta;
+            theta = (theta <= -T(PI)) ? theta + T(2 * PI) : theta;
+        }
+        else
+            theta = normalizeAngle(theta);
+        _pose.theta = theta;
+
+        _steps++;
+        return _pose;
+    }
+
+    template <typename T>
+    inline T KinematicSimulator<T>::limit(T v, T prev, T v_max, T a_max) const
+    {
+        if (a_max > 0)
+            v = guard(v, prev - a_max, prev + a_max);
+        return guard(v, -v_max, v_max);
+    }
+
+    // xoshiro256+
+    template <typename T>
+    inline std::uint64_t KinematicSimulator<T>::nextRandom()
+    {
+        const std::uint64_t result = _rng[0] + _rng[3];
+        const std::uint64_t t = _rng[1] << 17;
+        _rng[2] ^= _rng[0];
+        _rng[3] ^= _rng[1];
+        _rng[1] ^= _rng[2];
+        _rng[0] ^= _rng[3];
+        _rng[2] ^= t;
+        _rng[3] = (_rng[3] << 45) | (_rng[3] >> 19);
+        return result;
+    }
+
+    // 標準正規分布（Marsaglia polar法，2つずつ生成する）
+    template <typename T>
+    inline T KinematicSimulator<T>::gaussian()
+    {
+        if (_has_spare)
+        {
+            _has_spare = false;
+            return _spare;
+        }
+        T u, v, s;
+        do
+        {
+            u = static_cast<T>(static_cast<double>(nextRandom() >> 11) * (2.0 / 9007199254740992.0) - 1.0);
+            v = static_cast<T>(static_cast<double>(nextRandom() >> 11) * (2.0 / 9007199254740992.0) - 1.0);
+            s = u * u + v * v;
+        } while (s >= 1 || s == 0);
+        const T m = std::sqrt(-2 * std::log(s) / s);
+        _spare = v * m;
+        _has_spare = true;
+        return u * m;
+    }
+} // namespace myStd
+
+#endif // KinematicSimulator_h
@@ -0,0 +1,284 @@
+/**
+ * @file PathFile.h
+ * @brief 経路データのバイナリファイル
+ * @attention PC向けのためControl.hからはincludeされない．使う場合はこのファイルを直接includeすること
+**/
+#ifndef PathFile_h
+#define PathFile_h
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "./../Vector/Vector.h"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace myStd
+{
+    /**
+     * @brief 経路データのバイナリファイル
+     * @details ファイルの構成（数値は書き出した環境のバイト順．endianが一致しない場合は読み込まない）
+     *          - ヘッダ（header_t，64byte）
+     *          - 経路データ: Pose2D<T>（x, y, theta）をcount個（先頭からpose_offset[byte]）
+     *          - 弧長（省略可）: 各点までの累積弧長Tをcount個（先頭からarc_length_offset[byte]，省略時は0）
+     *
+     *          open()はファイルをメモリマップし，経路データをコピーせずにdata()で参照できるようにする．
+     *          PurePursuitControl::setPathView(file.data(), file.size(), file.arcLength())で直接追従に使える
+     *          （弧長を含むファイルでは弧長テーブルを平方根の計算なしで作る）．
+     *          メモリマップが使えない環境ではファイル全体を読み込む．
+     * @tparam T: 数値型（float, double）ファイルの要素型と一致している必要がある
+    **/
+    template <typename T>
+    class PathFile
+    {
+    public:
+        static constexpr std::uint16_t VERSION = 1; /**< ファイル形式のバージョン */
+
+        /**
+         * @brief 要素型リスト
+         */
+        enum class ElementType : std::uint8_t
+        {
+            float32 = 1, /**< float */
+            float64 = 2  /**< double */
+        };
+
+        /**
+         * @brief ファイルのヘッダ
+         */
+        struct header_t
+        {
+            char magic[8];                    /**< "MSLPATH"（終端文字を含む） */
+            std::uint32_t endian;             /**< 0x01020304（エンディアンの確認用） */
+            std::uint16_t version;            /**< ファイル形式のバージョン */
+            std::uint8_t element_type;        /**< 要素型（ElementType） */
+            std::uint8_t reserved0;           /**< 予約 */
+            std::uint64_t count;              /**< 経路データの要素数 */
+            std::uint64_t pose_offset;        /**< 経路データの位置[byte] */
+            std::uint64_t arc_length_offset;  /**< 弧長の位置[byte]（弧長を含まない場合は0） */
+            std::uint8_t reserved1[24];       /**< 予約 */
+        };
+        static_assert(sizeof(header_t) == 64, "header_t must be 64 bytes");
+        static_assert(sizeof(Pose2D<T>) == 3 * sizeof(T), "Pose2D<T> must be three packed T");
+
+        PathFile() = default;
+        PathFile(const PathFile &) = delete;
+        PathFile &operator=(const PathFile &) = delete;
+        ~PathFile() { close(); }
+
+        /**
+         * @brief ファイルを開く
+         * @param filename: ファイル名
+         * @return 成功した場合true（形式や要素型が異なる場合もfalse）
+         */
+        bool open(const std::string &filename);
+
+        /**
+         * @brief ファイルを閉じる（data()で得たポインタは無効になる）
+         */
+        void close();
+
+        /**
+         * @brief 経路データの先頭ポインタの取得
+         */
+        inline const Pose2D<T> *data() const { return _poses; }
+
+        /**
+         * @brief 経路データの要素数の取得
+         */
+        inline std::size_t size() const { return _count; }
+
+        /**
+         * @brief 累積弧長の先頭ポインタの取得
+         * @return 累積弧長（ファイルが弧長を含まない場合はnullptr）
+         */
+        inline const T *arcLength() const { return _arc_length; }
+
+        /**
+         * @brief 経路データをファイルに書き出す
+         * @param filename: ファイル名
+         * @param path: 経路データの先頭ポインタ
+         * @param num: 経路データの要素数
+         * @param with_arc_length: 累積弧長を含めるか
+         * @return 成功した場合true
+         */
+        static bool write(const std::string &filename, const Pose2D<T> *path, std::size_t num, bool with_arc_length = true);
+
+    private:
+        static constexpr std::uint32_t ENDIAN_MARK = 0x01020304;
+        static constexpr ElementType elementType() { return sizeof(T) == 4 ? ElementType::float32 : ElementType::float64; }
+        static inline std::uint64_t alignUp(std::uint64_t v) { return (v + 63) / 64 * 64; }
+
+        bool parse(const unsigned char *bytes, std::size_t length);
+
+        const Pose2D<T> *_poses = nullptr;
+        const T *_arc_length = nullptr;
+        std::size_t _count = 0;
+
+        void *_map = nullptr;  // メモリマップの先頭
+        std::size_t _map_size = 0;
+        std::vector<unsigned char> _buffer; // メモリマップを使えない場合の読み込み先
+    };
+
+    template <typename T>
+    bool PathFile<T>::parse(const unsigned char *bytes, std::size_t length)
+    {
+        header_t header;
+        if (length < sizeof(header))
+            return false;
+        std::memcpy(&header, bytes, sizeof(header));
+
+        if (std::memcmp(header.magic, "MSLPATH", 8) != 0 || header.endian != ENDIAN_MARK ||
+            header.version != VERSION || header.element_type != static_cast<std::uint8_t>(elementType()))
+            return false;
+
+        // count * sizeやoffset + bytesは不正なヘッダで桁あふれし得るため，残りの長さに収まる要素数で比べる
+        if (header.pose_offset % alignof(Pose2D<T>) != 0 || header.pose_offset > length ||
+            header.count > (length - header.pose_offset) / sizeof(Pose2D<T>))
+            return false;
+        if (header.arc_length_offset != 0 &&
+            (header.arc_length_offset % alignof(T) != 0 || header.arc_length_offset > length ||
+             header.count > (length - header.arc_length_offset) / sizeof(T)))
+            return false;
+
+        _poses = reinterpret_cast<const Pose2D<T> *>(bytes + header.pose_offset);
+        _arc_length = header.arc_length_offset ? reinterpret_cast<const T *>(bytes + header.arc_length_offset) : nullptr;
+        _count = static_cast<std::size_t>(header.count);
+        return true;
+    }
+
+    template <typename T>
+    bool PathFile<T>::open(const std::string &filename)
+    {
+        close();
+
+#if defined(_WIN32)
+        HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+        LARGE_INTEGER file_size;
+        HANDLE mapping = nullptr;
+        if (GetFileSizeEx(file, &file_size) && file_size.QuadPart > 0)
+            mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (!mapping)
+            return false;
+        _map = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+        if (!_map)
+            return false;
+        _map_size = static_cast<std::size_t>(file_size.QuadPart);
+#elif defined(__unix__) || defined(__APPLE__)
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size <= 0)
+        {
+            ::close(fd);
+            return false;
+        }
+        void *map = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (map == MAP_FAILED)
+            return false;
+        _map = map;
+        _map_size = static_cast<std::size_t>(st.st_size);
+#endif
+
+        if (_map)
+        {
+            if (!parse(static_cast<const unsigned char *>(_map), _map_size))
+            {
+                close();
+                return false;
+            }
+            return true;
+        }
+
+        // メモリマップを使えない環境ではファイル全体を読み込む
+        std::ifstream ifs(filename, std::ios::binary);
+        if (!ifs)
+            return false;
+        _buffer.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+        if (!parse(_buffer.data(), _buffer.size()))
+        {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    template <typename T>
+    void PathFile<T>::close()
+    {
+#if defined(_WIN32)
+        if (_map)
+            UnmapViewOfFile(_map);
+#elif defined(__unix__) || defined(__APPLE__)
+        if (_map)
+            munmap(_map, _map_size);
+#endif
+        _map = nullptr;
+        _map_size = 0;
+        _buffer.clear();
+        _poses = nullptr;
+        _arc_length = nullptr;
+        _count = 0;
+    }
+
+    template <typename T>
+    bool PathFile<T>::write(const std::string &filename, const Pose2D<T> *path, std::size_t num, bool with_arc_length)
+    {
+        header_t header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, "MSLPATH", 8);
+        header.endian = ENDIAN_MARK;
+        header.version = VERSION;
+        header.element_type = static_cast<std::uint8_t>(elementType());
+        header.count = num;
+        header.pose_offset = alignUp(sizeof(header));
+        header.arc_length_offset = with_arc_length ? alignUp(header.pose_offset + num * sizeof(Pose2D<T>)) : 0;
+
+        std::ofstream ofs(filename, std::ios::binary | std::ios::trunc);
+        if (!ofs)
+            return false;
+
+        const char zero[64] = {};
+        ofs.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        ofs.write(zero, static_cast<std::streamsize>(header.pose_offset - sizeof(header)));
+        ofs.write(reinterpret_cast<const char *>(path), static_cast<std::streamsize>(num * sizeof(Pose2D<T>)));
+
+        if (with_arc_length)
+        {
+            const std::uint64_t end = header.pose_offset + num * sizeof(Pose2D<T>);
+            ofs.write(zero, static_cast<std::streamsize>(header.arc_length_offset - end));
+            T s = 0;
+            for (std::size_t i = 0; i < num; i++)
+            {
+                if (i > 0)
+                    s += Pose2D<T>::getDistance(path[i - 1], path[i]);
+                ofs.write(reinterpret_cast<const char *>(&s), sizeof(s));
+            }
+        }
+        return static_cast<bool>(ofs);
+    }
+
+} // namespace myStd
+
+#endif // PathFile_h
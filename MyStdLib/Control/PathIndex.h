@@ -0,0 +1,285 @@
+/**
+ * @file PathIndex.h
+ * @brief 経路の最近傍線分を探索するための空間インデックス
+**/
+#ifndef PathIndex_h
+#define PathIndex_h
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "./../MyStdFunctions.h"
+#include "./../Vector/Vector.h"
+
+namespace myStd
+{
+    /**
+     * @brief 経路の最近傍線分を探索するための空間インデックス（一様グリッド）
+     * @details 各線分（path[i]からpath[i + 1]）を通過するセルに登録しておき，
+     *          クエリ点のセルから外側へリング状に探索する．
+     *          セルの大きさは線分の平均長とするため，経路近傍の点に対する探索は経路長によらずほぼ一定時間で終わる．
+     *          インデックスは座標を保持しないため，探索時には構築時と同じ経路データを渡す．
+     *          経路データはpath[i]で点を取得できるもの（Pose2D<T>のポインタ，PoseArrayなど）を渡せる．
+     * @tparam T: 数値型
+    **/
+    template <typename T>
+    class PathIndex
+    {
+    public:
+        /**
+         * @brief 探索結果の構造体
+         */
+        struct result_t
+        {
+            int idx;    /**< 最近傍線分の始点のインデックス（線分はpath[idx]からpath[idx + 1]，経路が1点のみの場合は0） */
+            T t;        /**< 線分上の最近傍点の媒介変数（0: 始点, 1: 終点） */
+            T distance; /**< 最近傍点までの距離 */
+        };
+
+        /**
+         * @brief コンストラクタ
+         */
+        PathIndex() = default;
+
+        /**
+         * @brief インデックスの構築
+         * @param path: 経路データ（先頭ポインタ，PoseArrayなど）
+         * @param num: 経路データの要素数
+         */
+        template <typename P>
+        void build(const P &path, std::size_t num);
+
+        /**
+         * @brief インデックスの破棄
+         */
+        void clear();
+
+        /**
+         * @brief 最近傍線分の探索
+         * @param path: 構築時と同じ経路データ（先頭ポインタ，PoseArrayなど）
+         * @param num: 経路データの要素数
+         * @param p: クエリ点
+         * @return 探索結果（経路が空の場合はidx = -1，同じ距離の線分が複数ある場合はインデックスの小さい方）
+         */
+        template <typename P>
+        result_t nearest(const P &path, std::size_t num, const Vector2<T> &p) const;
+
+    private:
+        using cell_t = std::int64_t;
+
+        inline cell_t cellOf(T v, T origin) const { return static_cast<cell_t>(std::floor((v - origin) / _cell_size)); }
+        inline std::size_t bucketOf(cell_t cx, cell_t cy) const
+        {
+            std::uint64_t h = static_cast<std::uint64_t>(cx) * 0x9E3779B97F4A7C15ULL ^ static_cast<std::uint64_t>(cy) * 0xC2B2AE3D27D4EB4FULL;
+            return static_cast<std::size_t>(h >> 32) & (_bucket_start.size() - 2);
+        }
+
+        template <typename F>
+        void traverse(const Pose2D<T> &a, const Pose2D<T> &b, F func) const;
+
+        template <typename P>
+        static inline void checkSegment(const P &path, std::size_t i, const Vector2<T> &p, result_t &best, T &best_sq);
+
+        T _cell_size = 1;
+        T _origin_x = 0, _origin_y = 0;
+        cell_t _num_x = 0, _num_y = 0;          // 経路を含むセルの範囲 [0, _num_x] x [0, _num_y]
+        std::vector<std::uint32_t> _bucket_start; // バケットごとの_itemsの開始位置（要素数はバケット数 + 1）
+        std::vector<std::uint32_t> _items;        // バケットごとに並べた線分のインデックス
+    };
+
+    template <typename T>
+    template <typename F>
+    void PathIndex<T>::traverse(const Pose2D<T> &a, const Pose2D<T> &b, F func) const
+    {
+        // 線分が通過するセルを順に列挙する（Amanatides-Wooのアルゴリズム）
+        cell_t x = cellOf(a.x, _origin_x), y = cellOf(a.y, _origin_y);
+        const cell_t end_x = cellOf(b.x, _origin_x), end_y = cellOf(b.y, _origin_y);
+        const T dx = b.x - a.x, dy = b.y - a.y;
+        const cell_t step_x = (dx > 0) ? 1 : -1, step_y = (dy > 0) ? 1 : -1;
+        const T inf = std::numeric_limits<T>::infinity();
+        T t_max_x = (dx != 0) ? ((x + (step_x > 0 ? 1 : 0)) * _cell_size + _origin_x - a.x) / dx : inf;
+        T t_max_y = (dy != 0) ? ((y + (step_y > 0 ? 1 : 0)) * _cell_size + _origin_y - a.y) / dy : inf;
+        const T t_delta_x = (dx != 0) ? _cell_size / std::abs(dx) : inf;
+        const T t_delta_y = (dy != 0) ? _cell_size / std::abs(dy) : inf;
+
+        cell_t remain = std::abs(end_x - x) + std::abs(end_y - y);
+        func(x, y);
+        for (; remain > 0; remain--)
+        {
+            if (t_max_x < t_max_y)
+            {
+                x += step_x;
+                t_max_x += t_delta_x;
+            }
+            else
+            {
+                y += step_y;
+                t_max_y += t_delta_y;
+            }
+            func(x, y);
+        }
+        // 丸め誤差で終点のセルに届かなかった場合に備えて終点も登録する
+        if (x != end_x || y != end_y)
+            func(end_x, end_y);
+    }
+
+    template <typename T>
+    void PathIndex<T>::clear()
+    {
+        _bucket_start.clear();
+        _items.clear();
+        _num_x = _num_y = 0;
+    }
+
+    template <typename T>
+    template <typename P>
+    void PathIndex<T>::build(const P &path, std::size_t num)
+    {
+        clear();
+        if (num < 2)
+            return;
+
+        // 範囲と線分の平均長からセルの大きさを決める
+        T min_x = path[0].x, max_x = path[0].x, min_y = path[0].y, max_y = path[0].y;
+        T length = 0;
+        for (std::size_t i = 1; i < num; i++)
+        {
+            min_x = min(min_x, path[i].x);
+            max_x = max(max_x, path[i].x);
+            min_y = min(min_y, path[i].y);
+            max_y = max(max_y, path[i].y);
+            length += Pose2D<T>::getDistance(path[i - 1], path[i]);
+        }
+        _cell_size = length / (num - 1);
+        if (!(_cell_size > 0))
+            _cell_size = 1;
+        _origin_x = min_x;
+        _origin_y = min_y;
+        _num_x = cellOf(max_x, _origin_x);
+        _num_y = cellOf(max_y, _origin_y);
+
+        // (バケット, 線分)の組を列挙してバケット順に並べる
+        std::size_t num_bucket = 1;
+        while (num_bucket < 2 * num)
+            num_bucket <<= 1;
+        _bucket_start.assign(num_bucket + 1, 0);
+
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> entries;
+        entries.reserve(3 * num);
+        for (std::size_t i = 0; i + 1 < num; i++)
+        {
+            traverse(path[i], path[i + 1], [&](cell_t cx, cell_t cy) {
+                entries.emplace_back(static_cast<std::uint32_t>(bucketOf(cx, cy)), static_cast<std::uint32_t>(i));
+            });
+        }
+
+        for (const auto &e : entries)
+            _bucket_start[e.first + 1]++;
+        for (std::size_t b = 0; b < num_bucket; b++)
+            _bucket_start[b + 1] += _bucket_start[b];
+
+        _items.resize(entries.size());
+        std::vector<std::uint32_t> pos(_bucket_start.begin(), _bucket_start.end() - 1);
+        for (const auto &e : entries)
+            _items[pos[e.first]++] = e.second;
+    }
+
+    template <typename T>
+    template <typename P>
+    inline void PathIndex<T>::checkSegment(const P &path, std::size_t i, const Vector2<T> &p, result_t &best, T &best_sq)
+    {
+        const Pose2D<T> &a = path[i];
+        const Pose2D<T> &b = path[i + 1];
+        const T vx = b.x - a.x, vy = b.y - a.y;
+        const T sq_len = vx * vx + vy * vy;
+        T t = (sq_len > 0) ? ((p.x - a.x) * vx + (p.y - a.y) * vy) / sq_len : T(0);
+        t = guard<T>(t, 0, 1);
+        const T ex = a.x + vx * t - p.x, ey = a.y + vy * t - p.y;
+        const T sq = ex * ex + ey * ey;
+        if (sq < best_sq || (sq == best_sq && static_cast<int>(i) < best.idx))
+        {
+            best_sq = sq;
+            best.idx = static_cast<int>(i);
+            best.t = t;
+        }
+    }
+
+    template <typename T>
+    template <typename P>
+    typename PathIndex<T>::result_t PathIndex<T>::nearest(const P &path, std::size_t num, const Vector2<T> &p) const
+    {
+        result_t best = {-1, 0, std::numeric_limits<T>::infinity()};
+        T best_sq = std::numeric_limits<T>::infinity();
+        if (num == 0)
+            return best;
+        if (num == 1)
+        {
+            best.idx = 0;
+            best.distance = Vector2<T>::getDistance(Vector2<T>(path[0].x, path[0].y), p);
+            return best;
+        }
+
+        // インデックス未構築の場合は全探索
+        if (_bucket_start.empty())
+        {
+            for (std::size_t i = 0; i + 1 < num; i++)
+                checkSegment(path, i, p, best, best_sq);
+            best.distance = std::sqrt(best_sq);
+            return best;
+        }
+
+        const cell_t cx = cellOf(p.x, _origin_x), cy = cellOf(p.y, _origin_y);
+        auto visit = [&](cell_t x, cell_t y) {
+            const std::size_t b = bucketOf(x, y);
+            for (std::uint32_t k = _bucket_start[b]; k < _bucket_start[b + 1]; k++)
+                checkSegment(path, _items[k], p, best, best_sq);
+        };
+
+        // 経路の範囲に最初に触れるリングから探索を始める
+        const cell_t ring_begin = max(max(max(-cx, cx - _num_x), max(-cy, cy - _num_y)), cell_t(0));
+        const cell_t ring_end = max(max(cx, _num_x - cx), max(cy, _num_y - cy));
+        std::size_t visited = 0;
+        const std::size_t budget = _bucket_start.size() * 2;
+
+        for (cell_t r = ring_begin; r <= ring_end; r++)
+        {
+            const cell_t x0 = max(cx - r, cell_t(0)), x1 = min(cx + r, _num_x);
+            const cell_t y0 = max(cy - r + 1, cell_t(0)), y1 = min(cy + r - 1, _num_y);
+            if (cy - r >= 0)
+                for (cell_t x = x0; x <= x1; x++)
+                    visit(x, cy - r);
+            if (r > 0 && cy + r <= _num_y)
+                for (cell_t x = x0; x <= x1; x++)
+                    visit(x, cy + r);
+            if (cx - r >= 0)
+                for (cell_t y = y0; y <= y1; y++)
+                    visit(cx - r, y);
+            if (r > 0 && cx + r <= _num_x)
+                for (cell_t y = y0; y <= y1; y++)
+                    visit(cx + r, y);
+
+            // 未探索のセルはすべてr * _cell_size以上離れている
+            const T reach = r * _cell_size;
+            if (best_sq < reach * reach)
+                break;
+
+            // 経路から遠いクエリ点で探索セル数が増えすぎた場合は全探索に切り替える
+            visited += static_cast<std::size_t>((x1 - x0 + 1) * 2 + max(y1 - y0 + 1, cell_t(0)) * 2);
+            if (visited > budget)
+            {
+                for (std::size_t i = 0; i + 1 < num; i++)
+                    checkSegment(path, i, p, best, best_sq);
+                break;
+            }
+        }
+
+        best.distance = std::sqrt(best_sq);
+        return best;
+    }
+
+} // namespace myStd
+
+#endif // PathIndex_h
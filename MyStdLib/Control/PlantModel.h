@@ -0,0 +1,150 @@
+/**
+ * @file PlantModel.h
+ * @brief PIDの調整，検証用の制御対象のモデル（固定ステップ）
+ * @attention オフラインの検証用のためControl.hからはincludeされない．使う場合はこのファイルを直接includeすること
+**/
+#ifndef PlantModel_h
+#define PlantModel_h
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include "./../MyStdFunctions.h"
+
+namespace myStd
+{
+    /**
+     * @brief 一次遅れ＋むだ時間系（FOPDT）
+     * @details 伝達関数 K * exp(-L s) / (tau s + 1)．入力はステップ間で一定（零次ホールド）として厳密に離散化する．
+     *          むだ時間Lはdtの整数倍に丸め，そのステップ数のバッファをコンストラクタで確保する．
+     *          step()はメモリ確保を行わない．
+     * @tparam T: 数値型
+    **/
+    template <typename T>
+    class FOPDTPlant
+    {
+    public:
+        /**
+         * @brief コンストラクタ
+         * @param gain: ゲインK
+         * @param tau: 時定数[s]
+         * @param dead_time: むだ時間L[s]
+         * @param dt: 刻み幅[s]
+         */
+        FOPDTPlant(T gain, T tau, T dead_time, T dt)
+            : _gain(gain), _dt(dt), _a(std::exp(-dt / tau)),
+              _delay(static_cast<std::size_t>(max(std::round(dead_time / dt), T(0))), T(0))
+        {
+            reset();
+        }
+
+        /**
+         * @brief 初期化（出力，むだ時間のバッファを0にする）
+         */
+        void reset()
+        {
+            _y = 0;
+            for (T &u : _delay)
+                u = 0;
+            _head = 0;
+        }
+
+        /**
+         * @brief 1ステップ進める
+         * @param u: 入力
+         * @return 出力
+         */
+        inline T step(T u)
+        {
+            if (!_delay.empty())
+            {
+                const T delayed = _delay[_head];
+                _delay[_head] = u;
+                _head = (_head + 1 == _delay.size()) ? 0 : _head + 1;
+                u = delayed;
+            }
+            _y = _a * _y + _gain * (1 - _a) * u;
+            return _y;
+        }
+
+        /**
+         * @brief 出力の取得
+         */
+        inline T getOutput() const { return _y; }
+
+        /**
+         * @brief 刻み幅[s]の取得
+         */
+        inline T getDt() const { return _dt; }
+
+    private:
+        T _gain;
+        T _dt;
+        T _a; // exp(-dt / tau)
+        std::vector<T> _delay;
+        std::size_t _head = 0;
+        T _y = 0;
+    };
+
+    /**
+     * @brief 二重積分系（質量に力を加える，慣性に回転力を加える）
+     * @details 伝達関数 K / s^2．入力はステップ間で一定（零次ホールド）として厳密に離散化する．
+     * @tparam T: 数値型
+    **/
+    template <typename T>
+    class DoubleIntegratorPlant
+    {
+    public:
+        /**
+         * @brief コンストラクタ
+         * @param gain: ゲインK（質量の逆数など）
+         * @param dt: 刻み幅[s]
+         */
+        DoubleIntegratorPlant(T gain, T dt) : _gain(gain), _dt(dt) { reset(); }
+
+        /**
+         * @brief 初期化（位置，速度を0にする）
+         */
+        void reset()
+        {
+            _x = 0;
+            _v = 0;
+        }
+
+        /**
+         * @brief 1ステップ進める
+         * @param u: 入力
+         * @return 出力（位置）
+         */
+        inline T step(T u)
+        {
+            const T a = _gain * u;
+            _x += (_v + a * _dt / 2) * _dt;
+            _v += a * _dt;
+            return _x;
+        }
+
+        /**
+         * @brief 出力（位置）の取得
+         */
+        inline T getOutput() const { return _x; }
+
+        /**
+         * @brief 速度の取得
+         */
+        inline T getVelocity() const { return _v; }
+
+        /**
+         * @brief 刻み幅[s]の取得
+         */
+        inline T getDt() const { return _dt; }
+
+    private:
+        T _gain;
+        T _dt;
+        T _x = 0;
+        T _v = 0;
+    };
+} // namespace myStd
+
+#endif // PlantModel_h
@@ -7,29 +7,50 @@
 
 #include <iostream>
 #include <cmath>
+#include <limits>
 #include <string>
+#include <utility>
 #include <vector>
+#if defined(__has_include)
+#if __has_include(<span>)
+#include <span>
+#endif
+#endif
 #include "./../MyStdFunctions.h"
+#include "./../Instrument.h"
+#include "./../Trace.h"
 #include "./../Vector/Vector.h"
 #include "./FBController/FBController.h"
+#include "PathIndex.h"
+#include "ArcLengthTable.h"
+#include "StreamingPath.h"
 
 namespace myStd
 {
+    /**
+     * @brief PurePursuit制御のモードリスト（KinematicSimulatorと共通）
+     */
+    enum class PurePursuitMode
+    {
+        diff = 0, /**< 2DoF（差動二輪型） */
+        omni      /**< 3DoF（全方位移動型） */
+    };
+
     /**
      * @brief PurePursuit制御（単純追従制御）
+     * @tparam T: 数値型
+     * @tparam T_fbc: 追従用のフィードバックコントローラ（PID，AnyControllerなど）
     **/
     template <typename T, typename T_fbc>
     class PurePursuitControl
     {
+        static_assert(isFBController<T_fbc, T>::value, "T_fbc must have update(T, T, T) and getControlVal()");
+
     public:
         /**
          * @brief モードリスト
          */
-        enum class Mode
-        {
-            diff = 0, /**< 2DoF（差動二輪型） */
-            omni      /**< 3DoF（全方位移動型） */
-        };
+        using Mode = PurePursuitMode;
 
         /**
          * @brief パラメータ構造体
@@ -50,13 +71,82 @@ namespace myStd
          * @brief コンストラクタ 経路データで初期化
          * @param path: 経路データ
          */
-        PurePursuitControl(std::vector<Pose2D<T>> path) { setPath(path); }
+        PurePursuitControl(std::vector<Pose2D<T>> path) { setPath(std::move(path)); }
 
         /**
          * @brief 経路データの設定
+         * @param path: 経路データ（右辺値を渡した場合はコピーせずに引き継ぐ）
+         */
+        inline void setPath(std::vector<Pose2D<T>> path);
+
+        /**
+         * @brief 所有しない経路データの設定
+         * @details 経路データをコピーせずに参照する．経路データは追従中に破棄，変更しないこと．
+         *          この状態でpush_back()した場合は，参照先をコピーしてから追加する．
+         * @param path: 経路データの先頭ポインタ
+         * @param num: 経路データの要素数
+         */
+        inline void setPathView(const Pose2D<T> *path, std::size_t num);
+
+        /**
+         * @brief 所有しない経路データと累積弧長の設定
+         * @details 弧長テーブルを累積弧長から作るため，線分ごとの長さの計算（平方根）を省ける．
+         *          PathFile::arcLength()を渡す場合に使う．
+         * @param path: 経路データの先頭ポインタ
+         * @param num: 経路データの要素数
+         * @param arc_length: 各点までの累積弧長（nullptrの場合は経路データから計算する）
+         */
+        inline void setPathView(const Pose2D<T> *path, std::size_t num, const T *arc_length)
+        {
+            setPathView(path, num);
+            if (arc_length)
+                _table.assign(arc_length, num);
+        }
+
+        /**
+         * @brief 所有しないSoAの経路データの設定
+         * @details PoseArrayをコピーせずに参照する．経路データは追従中に破棄，変更しないこと．
+         *          この状態でpush_back()した場合は，参照先をstd::vector<Pose2D<T>>にコピーしてから追加する．
          * @param path: 経路データ
          */
-        inline void setPath(const std::vector<Pose2D<T>> path);
+        inline void setPathView(const PoseArray<T> &path)
+        {
+            setPathView(nullptr, 0);
+            _view_array = &path;
+        }
+
+        /**
+         * @brief 所有しない経路データと構築済みの空間インデックス，弧長テーブルの設定
+         * @details 同じ経路を追従する多数のコントローラで，経路データから作るインデックスとテーブルを1つずつ共有するために使う．
+         *          経路データ，インデックス，テーブルは追従中に破棄，変更しないこと．
+         *          この状態でpush_back()した場合は，経路データをコピーしてインデックスとテーブルを作り直す．
+         * @param path: 経路データの先頭ポインタ
+         * @param num: 経路データの要素数
+         * @param index: pathで構築した空間インデックス
+         * @param table: pathで構築した弧長テーブル
+         */
+        inline void setPathView(const Pose2D<T> *path, std::size_t num, const PathIndex<T> &index, const ArcLengthTable<T> &table)
+        {
+            setPathView(path, num);
+            _shared_index = &index;
+            _shared_table = &table;
+        }
+
+        /**
+         * @brief ストリーミングモードの設定
+         * @details 経路データを容量固定のリングバッファで保持し，push_back()で逐次追加しながら追従する．
+         *          カーソルより後ろの点はupdate()の度に自動で解放されるため，終わりのない経路でもメモリ使用量は一定．
+         *          インデックスは追加した順の通し番号で，解放後も変わらない．
+         *          setPath()，setPathView()を呼ぶとストリーミングモードは解除される．
+         * @param capacity: 保持できる点の数（2のべき乗に切り上げる）
+         * @attention カーソルの初期位置は保持している範囲の線形探索で求める（空間インデックスは使わない）
+         */
+        inline void setStreaming(std::size_t capacity);
+
+        /**
+         * @brief ストリーミングモードかどうかの取得
+         */
+        inline bool isStreaming() const { return _streaming; }
 
         /**
          * @brief パラメータの設定
@@ -80,14 +170,41 @@ namespace myStd
         /**
          * @brief 経路データを末尾に追加
          * @param path: 経路データ
+         * @return 追加できた場合true（ストリーミングモードで空きが足りない場合は1点も追加せずにfalse）
+         */
+        inline bool push_back(const std::vector<Pose2D<T>> &path) { return push_back(path.data(), path.size()); }
+
+        /**
+         * @brief 経路データを末尾に追加
+         * @param path: 経路データの先頭ポインタ
+         * @param num: 経路データの要素数
+         * @return 追加できた場合true（ストリーミングモードで空きが足りない場合は1点も追加せずにfalse）
          */
-        inline void push_back(std::vector<Pose2D<T>> path);
+        inline bool push_back(const Pose2D<T> *path, std::size_t num);
+
+#if defined(__cpp_lib_span) && __cpp_lib_span >= 202002L
+        /**
+         * @brief 経路データを末尾に追加
+         * @param path: 経路データ
+         * @return 追加できた場合true（ストリーミングモードで空きが足りない場合は1点も追加せずにfalse）
+         */
+        inline bool push_back(std::span<const Pose2D<T>> path) { return push_back(path.data(), path.size()); }
+#endif
 
         /**
          * @brief 経路データの末尾に座標を追加
          * @param pose: 座標
+         * @return 追加できた場合true（ストリーミングモードで空きがない場合はfalse）
          */
-        inline void push_back(Pose2D<T> pose) { _path.push_back(pose); }
+        inline bool push_back(Pose2D<T> pose)
+        {
+            if (_streaming)
+                return _stream.push_back(pose);
+            ownPath();
+            _path.push_back(pose);
+            _need_index_update = true;
+            return true;
+        }
 
         /**
          * @brief 値の更新
@@ -97,6 +214,55 @@ namespace myStd
          */
         inline void update(int idx, myStd::Pose2D<T> now_pose, T dt);
 
+        /**
+         * @brief 値の更新（目標点は現在位置から自動で決定）
+         * @details 経路上の追従位置（カーソル）を前回の位置から探索窓の範囲内で前方にのみ進め，
+         *          そこから弧長で先読み距離だけ進んだ点を目標点とする．
+         *          カーソルの初期位置のみ空間インデックスで経路全体から探索する．
+         *          先読み距離が0の場合はカーソルのある線分の終点を目標点とする．
+         * @param now_pose: 現在位置
+         * @param dt: 前回この関数をコールしてからの経過時間
+         * @attention 経路データが空の場合は何もしない
+         */
+        inline void update(myStd::Pose2D<T> now_pose, T dt);
+
+        /**
+         * @brief 先読み距離の設定
+         * @param distance: 先読み距離（経路に沿った弧長）
+         */
+        inline void setLookahead(T distance) { _lookahead = distance; }
+
+        /**
+         * @brief カーソルの探索窓の設定
+         * @param num: 1回のupdate()でカーソルを探索する線分の数
+         */
+        inline void setSearchWindow(int num) { _search_window = max(num, 1); }
+
+        /**
+         * @brief カーソルの初期化（次回のupdate()で経路全体から追従位置を探し直す）
+         */
+        inline void resetTracking() { _cursor = -1; }
+
+        /**
+         * @brief カーソル（追従中の線分のインデックス）の取得
+         * @return 追従中の線分の始点のインデックス（未初期化の場合は-1）
+         */
+        inline int getCursor() const { return _cursor; }
+
+        /**
+         * @brief 目標点（先読み点）の取得
+         * @return 前回のupdate()で使用した目標点
+         */
+        inline Pose2D<T> getLookaheadPose() { return _lookahead_pose; }
+
+        /**
+         * @brief 現在位置に対する目標点のインデックスの取得
+         * @details 現在位置に最も近い線分の終点を目標点とする
+         * @param now_pose: 現在位置
+         * @return 経路データのインデックス（経路データが空の場合は-1）
+         */
+        inline int getTargetIndex(const myStd::Pose2D<T> &now_pose);
+
         /**
          * @brief 制御量（計算結果）の取得
          * @return 制御量（計算結果）
@@ -104,25 +270,144 @@ namespace myStd
          */
         inline Pose2D<T> getControlVal() { return output; }
 
+#if defined(MYSTD_TRACE)
+        /**
+         * @brief トレースの書き込み先の設定（MYSTD_TRACEを定義した場合のみ）
+         * @details update()の度にTraceKind::PurePursuitのレコードを書き込む
+         *          （並進，回転のコントローラのトレースはそれぞれのsetTrace()で設定する）
+         * @param ring: 書き込み先（update()を呼ぶスレッドのリング，nullptrで書き込みを止める）
+         * @param source: 記録元の番号
+         */
+        inline void setTrace(TraceRing *ring, std::uint32_t source)
+        {
+            _trace = ring;
+            _trace_source = source;
+        }
+#endif
+
+#if defined(MYSTD_INSTRUMENTATION)
+        /**
+         * @brief 計測値の取得（MYSTD_INSTRUMENTATIONを定義した場合のみ）
+         * @return update()の処理時間（並進，回転のコントローラの計測値はそれぞれのgetProbe()で取得する）
+         */
+        inline ControllerProbe &getProbe() { return _probe; }
+        inline const ControllerProbe &getProbe() const { return _probe; }
+#endif
+
     private:
         param_t _param;
         Pose2D<T> output;
         std::vector<Pose2D<T>> _path; // 通過点のリスト
+        const Pose2D<T> *_view_data = nullptr; // 所有しない経路データ（nullptrの場合は_pathを使う）
+        std::size_t _view_size = 0;
+        const PoseArray<T> *_view_array = nullptr; // 所有しないSoAの経路データ（_view_dataより優先）
+        PathIndex<T> _index;          // 最近傍線分の探索用
+        bool _need_index_update = true;
+        ArcLengthTable<T> _table;     // 線分ごとの弧長
+        const PathIndex<T> *_shared_index = nullptr;      // 共有するインデックス（nullptrの場合は_indexを使う）
+        const ArcLengthTable<T> *_shared_table = nullptr; // 共有するテーブル（nullptrの場合は_tableを使う）
+
+        T _lookahead = 0;        // 先読み距離
+        int _search_window = 16; // カーソルの探索窓
+        int _cursor = -1;        // 追従中の線分のインデックス（-1: 未初期化）
+        int _lookahead_seg = 0;  // 先読み点のある線分のインデックス
+        Pose2D<T> _lookahead_pose;
+
+        StreamingPath<T> _stream; // ストリーミングモードの経路データ
+        bool _streaming = false;
+        MYSTD_PROBE_MEMBER(_probe)
+        MYSTD_TRACE_MEMBER(_trace, _trace_source)
+
+        inline const Pose2D<T> *pathData() const { return _view_data ? _view_data : _path.data(); }
+        inline std::size_t pathSize() const { return _view_array ? _view_array->size() : (_view_data ? _view_size : _path.size()); }
+        inline const ArcLengthTable<T> &table() const { return _shared_table ? *_shared_table : _table; }
+        inline void ownPath();
+        inline void updateByTarget(const Pose2D<T> &target, const Pose2D<T> &now_pose, T dt);
+        inline typename PathIndex<T>::result_t findNearest(const Pose2D<T> &now_pose);
+        template <typename P>
+        inline void track(const P &path, std::size_t begin, std::size_t end, const Pose2D<T> &now_pose, T dt);
+        template <typename P>
+        inline int nearestSegment(const P &path, int first, int last, const Vector2<T> &p, T &t) const;
 
     }; // namespace myStd
 
     template <typename T, typename T_fbc>
     inline void PurePursuitControl<T, T_fbc>::setPath(std::vector<Pose2D<T>> path)
     {
+        _view_array = nullptr;
+        _shared_index = nullptr;
+        _shared_table = nullptr;
+        _path = std::move(path);
+        _view_data = nullptr;
+        _view_size = 0;
+        _streaming = false;
+        _table.clear();
+        _cursor = -1;
+        _need_index_update = true;
+    }
+
+    template <typename T, typename T_fbc>
+    inline void PurePursuitControl<T, T_fbc>::setPathView(const Pose2D<T> *path, std::size_t num)
+    {
+        _view_array = nullptr;
+        _shared_index = nullptr;
+        _shared_table = nullptr;
+        _path.clear();
+        _path.shrink_to_fit();
+        _view_data = path;
+        _view_size = num;
+        _streaming = false;
+        _table.clear();
+        _cursor = -1;
+        _need_index_update = true;
+    }
+
+    template <typename T, typename T_fbc>
+    inline void PurePursuitControl<T, T_fbc>::setStreaming(std::size_t capacity)
+    {
+        _view_array = nullptr;
+        _shared_index = nullptr;
+        _shared_table = nullptr;
         _path.clear();
-        push_back(path);
+        _path.shrink_to_fit();
+        _view_data = nullptr;
+        _view_size = 0;
+        _stream.setCapacity(capacity);
+        _streaming = true;
+        _table.clear();
+        _cursor = -1;
+        _need_index_update = true;
+    }
+
+    template <typename T, typename T_fbc>
+    inline void PurePursuitControl<T, T_fbc>::ownPath()
+    {
+        if (_view_array)
+            _path.assign(_view_array->begin(), _view_array->end());
+        else if (_view_data)
+            _path.assign(_view_data, _view_data + _view_size);
+        else
+            return;
+        _view_array = nullptr;
+        _view_data = nullptr;
+        _view_size = 0;
+
+        // 共有していたインデックスとテーブルは次のupdate()で自分のものとして作り直す
+        _shared_index = nullptr;
+        _shared_table = nullptr;
     }
 
     template <typename T, typename T_fbc>
-    inline void PurePursuitControl<T, T_fbc>::push_back(std::vector<Pose2D<T>> path)
+    inline bool PurePursuitControl<T, T_fbc>::push_back(const Pose2D<T> *path, std::size_t num)
     {
-        for (auto p : path)
-            _path.push_back(p);
+        if (_streaming)
+            return _stream.push_back(path, num);
+
+        // 範囲を指定したinsertは必要な容量を一度に確保する
+        ownPath();
+        _path.insert(_path.end(), path, path + num);
+        _need_index_update = true;
+        return true;
     }
 
     template <typename T, typename T_fbc>
@@ -134,17 +419,173 @@ namespace myStd
 
     template <typename T, typename T_fbc>
     inline void PurePursuitControl<T, T_fbc>::update(int idx, myStd::Pose2D<T> now_pose, T dt)
+    {
+        MYSTD_PROBE_SCOPE(_probe);
+        updateByTarget(_streaming ? _stream[idx] : (_view_array ? (*_view_array)[idx] : pathData()[idx]), now_pose, dt);
+    }
+
+    template <typename T, typename T_fbc>
+    inline void PurePursuitControl<T, T_fbc>::updateByTarget(const Pose2D<T> &target, const Pose2D<T> &now_pose, T dt)
     {
         Pose2D<T> error; // 偏差
         // 目標までの距離に対してフィードバック制御
-        error.x = Pose2D<T>::getDistance(now_pose, _path[idx]);
+        error.x = Pose2D<T>::getDistance(now_pose, target);
         _param.fbc_linear.update(0, error.x, dt);
         output.x = -_param.fbc_linear.getControlVal();
 
         // 目標までの角度に対してフィードバック制御
-        error.theta = Pose2D<T>::getAngle(now_pose, _path[idx]) - now_pose.theta;
+        error.theta = Pose2D<T>::getAngle(now_pose, target) - now_pose.theta;
         _param.fbc_angular.update(0, error.theta, dt);
         output.theta = -_param.fbc_angular.getControlVal();
+
+        MYSTD_TRACE_WRITE(_trace, _trace_source, TraceKind::PurePursuit, now_pose.x, now_pose.y, now_pose.theta,
+                          error.x, error.theta, output.x, output.theta);
+    }
+
+    template <typename T, typename T_fbc>
+    inline void PurePursuitControl<T, T_fbc>::update(myStd::Pose2D<T> now_pose, T dt)
+    {
+        MYSTD_PROBE_SCOPE(_probe);
+        if (!_streaming)
+        {
+            if (_view_array)
+                track(*_view_array, 0, pathSize(), now_pose, dt);
+            else
+                track(pathData(), 0, pathSize(), now_pose, dt);
+            return;
+        }
+
+        track(_stream, _stream.begin(), _stream.end(), now_pose, dt);
+        // カーソルより後ろの点はもう参照しないので解放する
+        if (_cursor > 0)
+        {
+            _stream.release(_cursor);
+            _table.release(_cursor);
+        }
+    }
+
+    template <typename T, typename T_fbc>
+    template <typename P>
+    inline void PurePursuitControl<T, T_fbc>::track(const P &path, std::size_t begin, std::size_t end, const Pose2D<T> &now_pose, T dt)
+    {
+        if (end == begin)
+            return;
+        if (end - begin == 1)
+        {
+            _lookahead_pose = path[begin];
+            updateByTarget(_lookahead_pose, now_pose, dt);
+            return;
+        }
+
+        // 末尾に追加された経路の分だけ弧長テーブルを伸ばす（共有するテーブルは構築済み）
+        if (!_shared_table)
+            _table.extend(path, begin, end);
+        const ArcLengthTable<T> &table = this->table();
+        const int last_seg = static_cast<int>(table.end()) - 1;
+        const Vector2<T> p(now_pose.x, now_pose.y);
+        T cursor_t = 0;
+
+        // カーソルの初期位置は経路全体から探す
+        if (_cursor < 0)
+        {
+            _cursor = _streaming ? nearestSegment(path, static_cast<int>(begin), last_seg, p, cursor_t)
+                                 : findNearest(now_pose).idx;
+            _lookahead_seg = _cursor;
+        }
+
+        // 探索窓の範囲内で最も近い線分までカーソルを進める
+        _cursor = nearestSegment(path, _cursor, min(_cursor + _search_window, last_seg), p, cursor_t);
+
+        if (_lookahead > 0)
+        {
+            // カーソル位置から弧長で先読み距離だけ進んだ点を目標点とする
+            const T s_target = table[_cursor].s + table[_cursor].length * cursor_t + _lookahead;
+            int j = max(_lookahead_seg, _cursor);
+            while (j < last_seg && table[j + 1].s <= s_target)
+                j++;
+            while (j > _cursor && table[j].s > s_target)
+                j--;
+            _lookahead_seg = j;
+            const T len = table[j].length;
+            const T u = (len > 0) ? (s_target - table[j].s) / len : T(1);
+            _lookahead_pose = Pose2D<T>::leap(path[j], path[j + 1], u);
+        }
+        else
+        {
+            _lookahead_seg = _cursor;
+            _lookahead_pose = path[_cursor + 1];
+        }
+
+        updateByTarget(_lookahead_pose, now_pose, dt);
+    }
+
+    template <typename T, typename T_fbc>
+    template <typename P>
+    inline int PurePursuitControl<T, T_fbc>::nearestSegment(const P &path, int first, int last, const Vector2<T> &p, T &t) const
+    {
+        // 同じ距離の場合は後ろの線分を優先する（線分のつなぎ目でカーソルが止まらないように）
+        const ArcLengthTable<T> &table = this->table();
+        int best = first;
+        T best_sq = std::numeric_limits<T>::infinity();
+        for (int i = first; i <= last; i++)
+        {
+            const Pose2D<T> &a = path[i];
+            const Pose2D<T> &b = path[i + 1];
+            const T len = table[i].length;
+            const T vx = b.x - a.x, vy = b.y - a.y;
+            T u = (len > 0) ? ((p.x - a.x) * vx + (p.y - a.y) * vy) / (len * len) : T(0);
+            u = guard<T>(u, 0, 1);
+            const T ex = a.x + vx * u - p.x, ey = a.y + vy * u - p.y;
+            const T sq = ex * ex + ey * ey;
+            if (sq <= best_sq)
+            {
+                best_sq = sq;
+                best = i;
+                t = u;
+            }
+        }
+        return best;
+    }
+
+    template <typename T, typename T_fbc>
+    inline int PurePursuitControl<T, T_fbc>::getTargetIndex(const myStd::Pose2D<T> &now_pose)
+    {
+        if (_streaming)
+        {
+            if (_stream.size() == 0)
+                return -1;
+            if (_stream.size() == 1)
+                return static_cast<int>(_stream.begin());
+            _table.extend(_stream, _stream.begin(), _stream.end());
+            T t;
+            const int seg = nearestSegment(_stream, static_cast<int>(_table.begin()), static_cast<int>(_table.end()) - 1,
+                                           Vector2<T>(now_pose.x, now_pose.y), t);
+            return seg + 1;
+        }
+
+        auto nearest = findNearest(now_pose);
+        if (nearest.idx < 0)
+            return -1;
+        return min(nearest.idx + 1, static_cast<int>(pathSize()) - 1);
+    }
+
+    template <typename T, typename T_fbc>
+    inline typename PathIndex<T>::result_t PurePursuitControl<T, T_fbc>::findNearest(const Pose2D<T> &now_pose)
+    {
+        const Vector2<T> p(now_pose.x, now_pose.y);
+        if (_shared_index)
+            return _shared_index->nearest(pathData(), pathSize(), p);
+
+        // 経路データが変更されていればインデックスを作り直す
+        if (_need_index_update)
+        {
+            if (_view_array)
+                _index.build(*_view_array, pathSize());
+            else
+                _index.build(pathData(), pathSize());
+            _need_index_update = false;
+        }
+        return _view_array ? _index.nearest(*_view_array, pathSize(), p) : _index.nearest(pathData(), pathSize(), p);
     }
 
 } // namespace myStd
@@ -0,0 +1,136 @@
+/**
+ * @file StreamingPath.h
+ * @brief 容量固定のリングバッファで保持する経路データ
+**/
+#ifndef StreamingPath_h
+#define StreamingPath_h
+
+#include <cstddef>
+#include <vector>
+#include "./../Vector/Vector.h"
+
+namespace myStd
+{
+    /**
+     * @brief 容量固定のリングバッファで保持する経路データ
+     * @details 終わりのない経路を逐次追加しながら追従するために使う．
+     *          インデックスは追加した順の通し番号で，古い点を解放しても変わらない．
+     *          保持しているのは[begin(), end())の範囲の点のみで，メモリ使用量は容量分で一定．
+     * @tparam T: 数値型
+    **/
+    template <typename T>
+    class StreamingPath
+    {
+    public:
+        /**
+         * @brief コンストラクタ
+         */
+        StreamingPath() = default;
+
+        /**
+         * @brief コンストラクタ 容量で初期化
+         * @param capacity: 保持できる点の数（2のべき乗に切り上げる）
+         */
+        explicit StreamingPath(std::size_t capacity) { setCapacity(capacity); }
+
+        /**
+         * @brief 容量の設定（保持している点はすべて破棄され，インデックスは0から始まる）
+         * @param capacity: 保持できる点の数（2のべき乗に切り上げる）
+         */
+        void setCapacity(std::size_t capacity)
+        {
+            std::size_t n = 1;
+            while (n < capacity)
+                n <<= 1;
+            _buf.assign(n, Pose2D<T>());
+            _mask = n - 1;
+            clear();
+        }
+
+        /**
+         * @brief 保持している点をすべて破棄（インデックスは0から始まる）
+         */
+        inline void clear() { _begin = _end = 0; }
+
+        /**
+         * @brief 保持できる点の数の取得
+         */
+        inline std::size_t capacity() const { return _buf.size(); }
+
+        /**
+         * @brief 保持している最も古い点のインデックスの取得
+         */
+        inline std::size_t begin() const { return _begin; }
+
+        /**
+         * @brief 最も新しい点の次のインデックスの取得
+         */
+        inline std::size_t end() const { return _end; }
+
+        /**
+         * @brief 保持している点の数の取得
+         */
+        inline std::size_t size() const { return _end - _begin; }
+
+        /**
+         * @brief 追加できる点の数の取得
+         */
+        inline std::size_t available() const { return capacity() - size(); }
+
+        /**
+         * @brief 末尾に点を追加
+         * @param pose: 座標
+         * @return 追加できた場合true（空きがない場合は追加せずにfalse）
+         */
+        inline bool push_back(const Pose2D<T> &pose)
+        {
+            if (available() == 0)
+                return false;
+            _buf[_end & _mask] = pose;
+            _end++;
+            return true;
+        }
+
+        /**
+         * @brief 末尾に経路データを追加
+         * @param path: 経路データの先頭ポインタ
+         * @param num: 経路データの要素数
+         * @return 追加できた場合true（空きが足りない場合は1点も追加せずにfalse）
+         */
+        inline bool push_back(const Pose2D<T> *path, std::size_t num)
+        {
+            if (available() < num)
+                return false;
+            for (std::size_t i = 0; i < num; i++)
+                _buf[(_end + i) & _mask] = path[i];
+            _end += num;
+            return true;
+        }
+
+        /**
+         * @brief 指定したインデックスより前の点を解放
+         * @param idx: 残す点のうち最も古い点のインデックス
+         */
+        inline void release(std::size_t idx)
+        {
+            if (idx > _end)
+                idx = _end;
+            if (idx > _begin)
+                _begin = idx;
+        }
+
+        /**
+         * @brief 点の取得
+         * @param idx: インデックス（begin()以上end()未満）
+         */
+        inline const Pose2D<T> &operator[](std::size_t idx) const { return _buf[idx & _mask]; }
+
+    private:
+        std::vector<Pose2D<T>> _buf;
+        std::size_t _mask = 0;
+        std::size_t _begin = 0, _end = 0;
+    };
+
+} // namespace myStd
+
+#endif // StreamingPath_h
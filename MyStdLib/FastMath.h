@@ -0,0 +1,354 @@
+/**
+ * @file FastMath.h
+ * @brief 三角関数の多項式近似と角度の正規化
+ * @details MYSTD_FAST_MATHを定義してからincludeすると，Vector2，Pose2Dの三角関数が近似版になる．
+ *          さらにMYSTD_FAST_MATH_LOW_ACCURACYを定義すると低精度版になる．
+ *
+ *          最大誤差（一様乱数4e6点をlong doubleの結果と比較した絶対誤差の上限，test/test_fast_math.cppで確認）
+ *          |                              | float       | double（High） | double（Low） |
+ *          |------------------------------|-------------|----------------|---------------|
+ *          | fastSinCos（|angle| <= 1e4）  | 1e-7        | 2e-16          | 3e-9          |
+ *          | fastSinCos（|angle| <= 1e5）  | 1e-6        | 2e-16          | 3e-9          |
+ *          | fastAtan2 [rad]              | 3e-7        | 5e-16          | 1e-8          |
+ *
+ *          floatでは|angle|が1e4を超えると範囲縮約の誤差が増える（1e5を超える角度は想定しない）．
+ *          NaN，無限大の入力に対する結果は未定義．
+**/
+#ifndef FastMath_h
+#define FastMath_h
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include "./MyStdFunctions.h"
+
+namespace myStd
+{
+    /**
+     * @brief 近似の精度リスト
+     */
+    enum class TrigAccuracy
+    {
+        High = 0, /**< Tの精度に合わせた多項式（floatとdoubleで次数が異なる） */
+        Low       /**< Tによらずfloat相当の多項式（doubleでも次数が少なく速い） */
+    };
+
+    namespace fastmath_detail
+    {
+        template <typename T, TrigAccuracy A>
+        struct isHigh
+        {
+            static constexpr bool value = (A == TrigAccuracy::High) && (sizeof(T) > sizeof(float));
+        };
+
+        /**
+         * @brief [-pi/4, pi/4]でのsinとcos（Cephesの係数）
+         */
+        template <typename T, TrigAccuracy A>
+        inline void sinCosKernel(T r, T &s, T &c)
+        {
+            const T z = r * r;
+            if (isHigh<T, A>::value)
+            {
+                s = r + r * z * (((((T(1.58962301576546568060E-10) * z + T(-2.50507477628578072866E-8)) * z + T(2.75573136213857245213E-6)) * z + T(-1.98412698295895385996E-4)) * z + T(8.33333333332211858878E-3)) * z + T(-1.66666666666666307295E-1));
+                c = T(1) - T(0.5) * z + z * z * (((((T(-1.13585365213876817300E-11) * z + T(2.08757008419747316778E-9)) * z + T(-2.75573141792967388112E-7)) * z + T(2.48015872888517045348E-5)) * z + T(-1.38888888888730564116E-3)) * z + T(4.16666666666665929218E-2));
+            }
+            else
+            {
+                s = r + r * z * ((T(-1.9515295891E-4) * z + T(8.3321608736E-3)) * z + T(-1.6666654611E-1));
+                c = T(1) - T(0.5) * z + z * z * ((T(2.443315711809948E-5) * z + T(-1.388731625493765E-3)) * z + T(4.166664568298827E-2));
+            }
+        }
+
+        /**
+         * @brief [0, tan(pi/8)]でのatan（Cephesの係数）
+         */
+        template <typename T, TrigAccuracy A>
+        inline T atanKernel(T x)
+        {
+            const T z = x * x;
+            if (isHigh<T, A>::value)
+            {
+                const T p = (((T(-8.750608600031904122785E-1) * z + T(-1.615753718733365076637E1)) * z + T(-7.500855792314704667340E1)) * z + T(-1.228866684490136173410E2)) * z + T(-6.485021904942025371773E1);
+                const T q = ((((z + T(2.485846490142306297962E1)) * z + T(1.650270098316988542046E2)) * z + T(4.328810604912902668951E2)) * z + T(4.853903996359136964868E2)) * z + T(1.945506571482613964425E2);
+                return x + x * z * p / q;
+            }
+            return x + x * z * (((T(8.05374449538E-2) * z + T(-1.38776856032E-1)) * z + T(1.99777106478E-1)) * z + T(-3.33329491539E-1));
+        }
+    } // namespace fastmath_detail
+
+    /**
+     * @brief sinとcosを同時に計算（多項式近似）
+     * @details 分岐を含まないため，配列に対するループは自動ベクトル化される
+     * @param angle: 角度[rad]
+     * @param s: sin(angle)の出力先
+     * @param c: cos(angle)の出力先
+     * @tparam A: 精度
+     */
+    template <typename T, TrigAccuracy A = TrigAccuracy::High>
+    inline void fastSinCos(T angle, T &s, T &c)
+    {
+        // angle = k * pi/2 + r（|r| <= pi/4）に分解する．pi/2は複数の定数に分けて桁落ちを防ぐ（Cody-Waite）
+        const T fk = angle * T(0.63661977236758134308) + (angle >= 0 ? T(0.5) : T(-0.5));
+        const std::int32_t k = static_cast<std::int32_t>(fk);
+        const T kf = static_cast<T>(k);
+        T r;
+        if (fastmath_detail::isHigh<T, A>::value)
+            r = (angle - kf * T(1.57079632673412561417E+0)) - kf * T(6.07710050650619224932E-11);
+        else
+            r = ((angle - kf * T(1.5703125)) - kf * T(4.837512969970703125E-4)) - kf * T(7.54978995489188216E-8);
+
+        T sr, cr;
+        fastmath_detail::sinCosKernel<T, A>(r, sr, cr);
+
+        // 象限に応じてsinとcosを入れ替え，符号を反転する
+        const bool swap = (k & 1) != 0;
+        const T s0 = swap ? cr : sr;
+        const T c0 = swap ? sr : cr;
+        s = (k & 2) ? -s0 : s0;
+        c = ((k + 1) & 2) ? -c0 : c0;
+    }
+
+    /**
+     * @brief sin（多項式近似）
+     * @param angle: 角度[rad]
+     */
+    template <typename T, TrigAccuracy A = TrigAccuracy::High>
+    inline T fastSin(T angle)
+    {
+        T s, c;
+        fastSinCos<T, A>(angle, s, c);
+        return s;
+    }
+
+    /**
+     * @brief cos（多項式近似）
+     * @param angle: 角度[rad]
+     */
+    template <typename T, TrigAccuracy A = TrigAccuracy::High>
+    inline T fastCos(T angle)
+    {
+        T s, c;
+        fastSinCos<T, A>(angle, s, c);
+        return c;
+    }
+
+    /**
+     * @brief atan2（多項式近似）
+     * @details 分岐を含まないため，配列に対するループは自動ベクトル化される
+     * @param y: y成分
+     * @param x: x成分
+     * @return 角度[rad]（-pi～pi，x = y = 0の場合は0）
+     */
+    template <typename T, TrigAccuracy A = TrigAccuracy::High>
+    inline T fastAtan2(T y, T x)
+    {
+        const T ax = std::fabs(x);
+        const T ay = std::fabs(y);
+        const T num = ax < ay ? ax : ay;
+        const T den = ax < ay ? ay : ax;
+        T a = (den > 0) ? num / den : T(0); // [0, 1]
+
+        // tan(pi/8)より大きい場合はatan(a) = pi/4 + atan((a - 1) / (a + 1))で[-tan(pi/8), tan(pi/8)]に縮約
+        const bool big = a > T(0.41421356237309504880);
+        a = big ? (a - T(1)) / (a + T(1)) : a;
+        T r = fastmath_detail::atanKernel<T, A>(a) + (big ? T(0.78539816339744830962) : T(0));
+
+        r = (ay > ax) ? T(1.57079632679489661923) - r : r;
+        r = (x < 0) ? T(3.14159265358979323846) - r : r;
+        return std::copysign(r, y);
+    }
+
+    /**
+     * @brief sinとcosを配列に対してまとめて計算（多項式近似）
+     * @param angle: 角度[rad]の配列
+     * @param s: sinの出力先（angleと重ならないこと）
+     * @param c: cosの出力先（angleと重ならないこと）
+     * @param num: 要素数
+     */
+    template <typename T, TrigAccuracy A = TrigAccuracy::High>
+    inline void fastSinCos(const T *__restrict angle, T *__restrict s, T *__restrict c, std::size_t num)
+    {
+        for (std::size_t i = 0; i < num; i++)
+            fastSinCos<T, A>(angle[i], s[i], c[i]);
+    }
+
+    /**
+     * @brief atan2を配列に対してまとめて計算（多項式近似）
+     * @param y: y成分の配列
+     * @param x: x成分の配列
+     * @param out: 角度[rad]の出力先（x，yと重ならないこと）
+     * @param num: 要素数
+     */
+    template <typename T, TrigAccuracy A = TrigAccuracy::High>
+    inline void fastAtan2(const T *__restrict y, const T *__restrict x, T *__restrict out, std::size_t num)
+    {
+        for (std::size_t i = 0; i < num; i++)
+            out[i] = fastAtan2<T, A>(y[i], x[i]);
+    }
+
+    /**
+     * @brief 角度を-pi～piに正規化（分岐なし）
+     * @details normalizeAngle()と同じく(-pi, pi]を返す．fmodを使わず，周回数を丸めて引く．
+     *          誤差は約|angle| * 2^-52（double）で，数周以内の入力を想定する（|angle| < 2^31周）．
+     *          範囲の分からない入力にはnormalizeAngle()を使う
+     * @param angle: 角度[rad]
+     */
+    template <typename T>
+    inline T fastNormalizeAngle(T angle)
+    {
+        // std::ceil，std::floorは自動ベクトル化されないことがあるので，整数への変換で周回数を丸める
+        const T fk = angle * T(0.15915494309189533577);
+        const T k = static_cast<T>(static_cast<std::int32_t>(fk + (fk >= 0 ? T(0.5) : T(-0.5))));
+        const T a = angle - k * T(6.28318530717958647693);
+        // 丸め誤差で範囲外になった場合の補正（選択命令になる）
+        const T b = (a > T(3.14159265358979323846)) ? a - T(6.28318530717958647693) : a;
+        return (b <= T(-3.14159265358979323846)) ? b + T(6.28318530717958647693) : b;
+    }
+
+    /**
+     * @brief 角度を0～2piに正規化（分岐なし）
+     * @details normalizeAnglePositive()と同じく[0, 2pi)を返す．誤差と入力範囲はfastNormalizeAngle()と同じ
+     * @param angle: 角度[rad]
+     */
+    template <typename T>
+    inline T fastNormalizeAnglePositive(T angle)
+    {
+        const T k = static_cast<T>(static_cast<std::int32_t>(angle * T(0.15915494309189533577)));
+        const T a = angle - k * T(6.28318530717958647693);
+        // 0に向かって丸めているので負の場合は1周足す．丸め誤差で2piになった場合も補正する（選択命令になる）
+        const T b = (a < 0) ? a + T(6.28318530717958647693) : a;
+        return (b >= T(6.28318530717958647693)) ? b - T(6.28318530717958647693) : b;
+    }
+
+    /**
+     * @brief 角度を-pi/2～pi/2に正規化（分岐なし）
+     * @details normalizeAbs90deg()と同じく[-pi/2, pi/2)を返す．誤差と入力範囲はfastNormalizeAngle()と同じ
+     * @param angle: 角度[rad]
+     */
+    template <typename T>
+    inline T fastNormalizeAbs90deg(T angle)
+    {
+        const T fk = angle * T(0.31830988618379067154);
+        const T k = static_cast<T>(static_cast<std::int32_t>(fk + (fk >= 0 ? T(0.5) : T(-0.5))));
+        const T a = angle - k * T(3.14159265358979323846);
+        // 丸め誤差で範囲外になった場合の補正（選択命令になる）
+        const T b = (a >= T(1.57079632679489661923)) ? a - T(3.14159265358979323846) : a;
+        return (b < T(-1.57079632679489661923)) ? b + T(3.14159265358979323846) : b;
+    }
+
+    /**
+     * @brief fromからtoへの最短の角度差（分岐なし）
+     * @details shortestAngularDistance()と同じく(-pi, pi]を返す
+     * @param from: 始点の角度[rad]
+     * @param to: 終点の角度[rad]
+     */
+    template <typename T>
+    inline T fastShortestAngularDistance(T from, T to)
+    {
+        return fastNormalizeAngle(to - from);
+    }
+
+    /**
+     * @brief 角度の配列をまとめて-pi～piに正規化（上書き）
+     * @param angles: 角度[rad]の配列
+     * @param num: 要素数
+     */
+    template <typename T>
+    inline void fastNormalizeAngle(T *angles, std::size_t num)
+    {
+        for (std::size_t i = 0; i < num; i++)
+            angles[i] = fastNormalizeAngle(angles[i]);
+    }
+
+    /**
+     * @brief 角度の配列をまとめて-pi～piに正規化
+     * @param in: 角度[rad]の配列
+     * @param out: 出力先（inと重ならないこと．同じ配列の場合は上書きの方を使う）
+     * @param num: 要素数
+     */
+    template <typename T>
+    inline void fastNormalizeAngle(const T *__restrict in, T *__restrict out, std::size_t num)
+    {
+        for (std::size_t i = 0; i < num; i++)
+            out[i] = fastNormalizeAngle(in[i]);
+    }
+
+    /**
+     * @brief 角度の配列をまとめて0～2piに正規化（上書き）
+     * @param angles: 角度[rad]の配列
+     * @param num: 要素数
+     */
+    template <typename T>
+    inline void fastNormalizeAnglePositive(T *angles, std::size_t num)
+    {
+        for (std::size_t i = 0; i < num; i++)
+            angles[i] = fastNormalizeAnglePositive(angles[i]);
+    }
+
+    /**
+     * @brief 角度の配列をまとめて0～2piに正規化
+     * @param in: 角度[rad]の配列
+     * @param out: 出力先（inと重ならないこと．同じ配列の場合は上書きの方を使う）
+     * @param num: 要素数
+     */
+    template <typename T>
+    inline void fastNormalizeAnglePositive(const T *__restrict in, T *__restrict out, std::size_t num)
+    {
+        for (std::size_t i = 0; i < num; i++)
+            out[i] = fastNormalizeAnglePositive(in[i]);
+    }
+
+    /**
+     * @brief 角度の差の配列をまとめて計算（out[i] = fastShortestAngularDistance(from[i], to[i])）
+     * @param from: 始点の角度[rad]の配列
+     * @param to: 終点の角度[rad]の配列
+     * @param out: 出力先（入力と重ならないこと）
+     * @param num: 要素数
+     */
+    template <typename T>
+    inline void fastShortestAngularDistance(const T *__restrict from, const T *__restrict to, T *__restrict out, std::size_t num)
+    {
+        for (std::size_t i = 0; i < num; i++)
+            out[i] = fastShortestAngularDistance(from[i], to[i]);
+    }
+
+    /**
+     * @brief sinとcosを同時に計算（MYSTD_FAST_MATHの定義に応じてstd::sin，std::cosか近似版を使う）
+     * @param angle: 角度[rad]
+     * @param s: sin(angle)の出力先
+     * @param c: cos(angle)の出力先
+     */
+    template <typename T>
+    inline void trigSinCos(T angle, T &s, T &c)
+    {
+#if defined(MYSTD_FAST_MATH) && defined(MYSTD_FAST_MATH_LOW_ACCURACY)
+        fastSinCos<T, TrigAccuracy::Low>(angle, s, c);
+#elif defined(MYSTD_FAST_MATH)
+        fastSinCos<T, TrigAccuracy::High>(angle, s, c);
+#else
+        s = std::sin(angle);
+        c = std::cos(angle);
+#endif
+    }
+
+    /**
+     * @brief atan2（MYSTD_FAST_MATHの定義に応じてstd::atan2か近似版を使う）
+     * @param y: y成分
+     * @param x: x成分
+     */
+    template <typename T>
+    inline T trigAtan2(T y, T x)
+    {
+#if defined(MYSTD_FAST_MATH) && defined(MYSTD_FAST_MATH_LOW_ACCURACY)
+        return fastAtan2<T, TrigAccuracy::Low>(y, x);
+#elif defined(MYSTD_FAST_MATH)
+        return fastAtan2<T, TrigAccuracy::High>(y, x);
+#else
+        return std::atan2(y, x);
+#endif
+    }
+
+} // namespace myStd
+
+#endif // FastMath_h
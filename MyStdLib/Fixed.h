@@ -0,0 +1,425 @@
+/**
+ * @file Fixed.h
+ * @brief 飽和演算の固定小数点数
+ * @details FPUのないマイコン向け．PID，Vector2，Pose2D，constrain()，map()などのTにそのまま使える．
+ *          sqrt，sin，cos，atan2は整数演算のみで計算する（浮動小数点数を使うのは定数からの変換だけ）．
+ *
+ *          最大誤差（Fixed<15, 16>，1LSB = 1.5e-5，doubleの結果との差）
+ *          | 関数    | 誤差                                        |
+ *          |---------|---------------------------------------------|
+ *          | sqrt    | 0.5LSB（最も近い値に丸める）                |
+ *          | sin/cos | 1LSB未満（|angle| <= 100），角度に比例して増加 |
+ *          | atan2   | 1LSB未満                                    |
+**/
+#ifndef Fixed_h
+#define Fixed_h
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include "./MyStdFunctions.h"
+
+namespace myStd
+{
+    namespace fixed_detail
+    {
+        /**
+         * @brief 符号付き整数をSビット右シフト（S > 0は最も近い値に丸め，S <= 0は左シフト）
+         */
+        template <int S>
+        inline std::int64_t shift(std::int64_t v, std::true_type)
+        {
+            return (v + (std::int64_t(1) << (S - 1))) >> S;
+        }
+
+        template <int S>
+        inline std::int64_t shift(std::int64_t v, std::false_type)
+        {
+            return v * (std::int64_t(1) << -S);
+        }
+
+        /**
+         * @brief 小数部Fromビットの値を小数部Toビットに変換
+         */
+        template <int From, int To>
+        inline std::int64_t rescale(std::int64_t v)
+        {
+            return shift<From - To>(v, std::integral_constant<bool, (From > To)>());
+        }
+
+        /**
+         * @brief 整数の平方根（最も近い整数に丸める）
+         */
+        inline std::uint64_t isqrt(std::uint64_t n)
+        {
+            if (n == 0)
+                return 0;
+            std::uint64_t res = 0;
+#if defined(__GNUC__)
+            std::uint64_t bit = std::uint64_t(1) << ((63 - __builtin_clzll(n)) & ~1);
+#else
+            std::uint64_t bit = std::uint64_t(1) << 62;
+            while (bit > n)
+                bit >>= 2;
+#endif
+            while (bit != 0)
+            {
+                // 分岐予測が外れやすいので条件付き代入にする
+                const std::uint64_t t = res + bit;
+                const bool ge = n >= t;
+                n -= ge ? t : 0;
+                res = (res >> 1) + (ge ? bit : 0);
+                bit >>= 2;
+            }
+            return n > res ? res + 1 : res;
+        }
+
+        /**
+         * @brief sin(pi/2 * z)（z: [0, 1]のQ30，戻り値もQ30）
+         */
+        inline std::int64_t sinQuarter(std::int64_t z)
+        {
+            // テイラー展開の13次まで（打ち切り誤差 < 1e-9）
+            const std::int64_t z2 = (z * z) >> 30;
+            std::int64_t p = 61;
+            p = -3864 + ((p * z2) >> 30);
+            p = 172272 + ((p * z2) >> 30);
+            p = -5026995 + ((p * z2) >> 30);
+            p = 85569306 + ((p * z2) >> 30);
+            p = -693598668 + ((p * z2) >> 30);
+            p = 1686629713 + ((p * z2) >> 30);
+            const std::int64_t s = (p * z) >> 30;
+            return s > (std::int64_t(1) << 30) ? (std::int64_t(1) << 30) : s;
+        }
+
+        /**
+         * @brief 1周を2^32とした位相からsinとcosを計算（Q30）
+         */
+        inline void sinCosPhase(std::uint32_t phase, std::int64_t &s, std::int64_t &c)
+        {
+            const std::int64_t one = std::int64_t(1) << 30;
+            const std::uint32_t quadrant = phase >> 30;
+            const std::int64_t r = phase & (one - 1);
+            const std::int64_t a = sinQuarter(r);       // sin(r)
+            const std::int64_t b = sinQuarter(one - r); // cos(r)
+            switch (quadrant)
+            {
+            case 0:
+                s = a;
+                c = b;
+                break;
+            case 1:
+                s = b;
+                c = -a;
+                break;
+            case 2:
+                s = -a;
+                c = -b;
+                break;
+            default:
+                s = -b;
+                c = a;
+                break;
+            }
+        }
+
+        /**
+         * @brief atan2（y, x: 同じ小数部ビット数の値，戻り値はQ30の角度[rad]）
+         */
+        inline std::int64_t atan2Q30(std::int64_t y, std::int64_t x)
+        {
+            const std::int64_t one = std::int64_t(1) << 30;
+            const std::int64_t ax = x < 0 ? -x : x;
+            const std::int64_t ay = y < 0 ? -y : y;
+            if (ax == 0 && ay == 0)
+                return 0;
+
+            // 1/8周に縮約: t = min / max（[0, 1]），tan(pi/8)より大きい場合はatan(t) = pi/4 + atan((t - 1) / (t + 1))
+            const bool swap = ay > ax;
+            const std::int64_t t = (swap ? ax : ay) * one / (swap ? ay : ax);
+            const bool big = t > 444758426; // tan(pi/8)
+            const std::int64_t u = big ? (t - one) * one / (t + one) : t;
+            const std::int64_t z = (u * u) >> 30;
+
+            // Cephesのatanfの係数
+            std::int64_t p = 86476423;
+            p = -149010515 + ((p * z) >> 30);
+            p = 214509035 + ((p * z) >> 30);
+            p = -357909816 + ((p * z) >> 30);
+            std::int64_t a = u + ((u * ((z * p) >> 30)) >> 30) + (big ? 843314857 : 0); // + pi/4
+
+            if (swap)
+                a = 1686629713 - a; // pi/2 - a
+            if (x < 0)
+                a = 3373259426LL - a; // pi - a
+            return y < 0 ? -a : a;
+        }
+    } // namespace fixed_detail
+
+    /**
+     * @brief 飽和演算の固定小数点数（符号1ビット + 整数部IntBitsビット + 小数部FracBitsビット）
+     * @details 表せる範囲は±(2^IntBits - 2^-FracBits)で，範囲外の結果は端の値に飽和する（正負で対称）．
+     *          0除算の結果は被除数の符号側の端の値．
+     *          整数と浮動小数点数から暗黙に変換できるため，Tを使う既存のテンプレートでは定数をそのまま書ける．
+     *          浮動小数点数からの変換は実行時に浮動小数点演算を使うので，定数以外には使わないこと．
+     * @tparam IntBits: 整数部のビット数（符号ビットを含まない）
+     * @tparam FracBits: 小数部のビット数
+     */
+    template <int IntBits, int FracBits>
+    class Fixed
+    {
+        static_assert(IntBits >= 0 && FracBits >= 0 && IntBits + FracBits <= 31, "Fixed supports up to 32 bits including the sign bit");
+
+    public:
+        /**
+         * @brief 内部表現の型（16bitに収まる場合はint16_t，それ以外はint32_t）
+         */
+        using raw_t = typename std::conditional<(IntBits + FracBits <= 15), std::int16_t, std::int32_t>::type;
+
+        /**
+         * @brief 乗除算の途中結果の型
+         */
+        using wide_t = typename std::conditional<(IntBits + FracBits <= 15), std::int32_t, std::int64_t>::type;
+
+        static constexpr int int_bits = IntBits;   /**< 整数部のビット数 */
+        static constexpr int frac_bits = FracBits; /**< 小数部のビット数 */
+
+        /**
+         * @brief コンストラクタ（値は0）
+         */
+        constexpr Fixed() = default;
+
+        /**
+         * @brief コンストラクタ 整数，浮動小数点数で初期化（範囲外の値は飽和する）
+         */
+        template <typename U, typename std::enable_if<std::is_arithmetic<U>::value, int>::type = 0>
+        constexpr Fixed(U v) : _raw(convert(v, std::is_floating_point<U>())) {}
+
+        /**
+         * @brief コンストラクタ 他の形式の固定小数点数から変換
+         */
+        template <int I, int F>
+        explicit Fixed(Fixed<I, F> v) : _raw(saturate(fixed_detail::rescale<F, FracBits>(v.getRaw()))) {}
+
+        /**
+         * @brief 内部表現から生成
+         * @param raw: 値 * 2^FracBits
+         */
+        static constexpr Fixed fromRaw(raw_t raw)
+        {
+            return Fixed(raw, RawTag());
+        }
+
+        /**
+         * @brief 内部表現（値 * 2^FracBits）の取得
+         */
+        constexpr raw_t getRaw() const { return _raw; }
+
+        /**
+         * @brief 表せる最大値
+         */
+        static constexpr Fixed maxValue() { return fromRaw(RAW_MAX); }
+
+        /**
+         * @brief 表せる最小値（-maxValue()）
+         */
+        static constexpr Fixed minValue() { return fromRaw(-RAW_MAX); }
+
+        /**
+         * @brief 分解能（1LSB）
+         */
+        static constexpr Fixed epsilon() { return fromRaw(1); }
+
+        /**
+         * @brief doubleに変換
+         */
+        constexpr double toDouble() const { return static_cast<double>(_raw) / (wide_t(1) << FracBits); }
+
+        /**
+         * @brief floatに変換
+         */
+        constexpr float toFloat() const { return static_cast<float>(_raw) / static_cast<float>(wide_t(1) << FracBits); }
+
+        /**
+         * @brief 整数に変換（0方向に切り捨て）
+         */
+        constexpr int toInt() const { return static_cast<int>(_raw / (wide_t(1) << FracBits)); }
+
+        /**
+         * @brief 文字列に変換（std::to_string(double)と同じ形式）
+         */
+        friend std::string to_string(Fixed v) { return std::to_string(v.toDouble()); }
+
+        explicit constexpr operator double() const { return toDouble(); }
+        explicit constexpr operator float() const { return toFloat(); }
+
+        constexpr Fixed operator+() const { return *this; }
+        constexpr Fixed operator-() const { return fromRaw(static_cast<raw_t>(-_raw)); }
+
+        friend constexpr Fixed operator+(Fixed a, Fixed b) { return fromRaw(saturate(wide_t(a._raw) + b._raw)); }
+        friend constexpr Fixed operator-(Fixed a, Fixed b) { return fromRaw(saturate(wide_t(a._raw) - b._raw)); }
+        friend Fixed operator*(Fixed a, Fixed b)
+        {
+            return fromRaw(saturate(fixed_detail::rescale<2 * FracBits, FracBits>(std::int64_t(a._raw) * b._raw)));
+        }
+        friend Fixed operator/(Fixed a, Fixed b)
+        {
+            if (b._raw == 0)
+                return a._raw < 0 ? minValue() : maxValue();
+            return fromRaw(saturate(std::int64_t(a._raw) * (std::int64_t(1) << FracBits) / b._raw));
+        }
+
+        Fixed &operator+=(Fixed v) { return *this = *this + v; }
+        Fixed &operator-=(Fixed v) { return *this = *this - v; }
+        Fixed &operator*=(Fixed v) { return *this = *this * v; }
+        Fixed &operator/=(Fixed v) { return *this = *this / v; }
+
+        friend constexpr bool operator==(Fixed a, Fixed b) { return a._raw == b._raw; }
+        friend constexpr bool operator!=(Fixed a, Fixed b) { return a._raw != b._raw; }
+        friend constexpr bool operator<(Fixed a, Fixed b) { return a._raw < b._raw; }
+        friend constexpr bool operator<=(Fixed a, Fixed b) { return a._raw <= b._raw; }
+        friend constexpr bool operator>(Fixed a, Fixed b) { return a._raw > b._raw; }
+        friend constexpr bool operator>=(Fixed a, Fixed b) { return a._raw >= b._raw; }
+
+        /**
+         * @brief 絶対値
+         */
+        friend constexpr Fixed abs(Fixed v) { return v._raw < 0 ? -v : v; }
+
+        /**
+         * @brief 平方根（負の値は0）
+         */
+        friend Fixed sqrt(Fixed v)
+        {
+            if (v._raw <= 0)
+                return Fixed();
+            return fromRaw(saturate(static_cast<std::int64_t>(fixed_detail::isqrt(std::uint64_t(v._raw) << FracBits))));
+        }
+
+        /**
+         * @brief sin
+         * @param angle: 角度[rad]
+         */
+        friend Fixed sin(Fixed angle)
+        {
+            Fixed s, c;
+            sinCos(angle, s, c);
+            return s;
+        }
+
+        /**
+         * @brief cos
+         * @param angle: 角度[rad]
+         */
+        friend Fixed cos(Fixed angle)
+        {
+            Fixed s, c;
+            sinCos(angle, s, c);
+            return c;
+        }
+
+        /**
+         * @brief sinとcosを同時に計算
+         * @param angle: 角度[rad]
+         * @param s: sin(angle)の出力先
+         * @param c: cos(angle)の出力先
+         */
+        friend void sinCos(Fixed angle, Fixed &s, Fixed &c)
+        {
+            // 1周を2^32とする位相に変換（2^34 / 2pi = 2734261102）して，2^32で折り返す
+            const std::int64_t turns = (std::int64_t(angle._raw) * 2734261102LL) >> (FracBits + 2);
+            std::int64_t s30, c30;
+            fixed_detail::sinCosPhase(static_cast<std::uint32_t>(turns), s30, c30);
+            s = fromRaw(saturate(fixed_detail::rescale<30, FracBits>(s30)));
+            c = fromRaw(saturate(fixed_detail::rescale<30, FracBits>(c30)));
+        }
+
+        /**
+         * @brief atan2
+         * @param y: y成分
+         * @param x: x成分
+         * @return 角度[rad]（-pi～pi，x = y = 0の場合は0．IntBitsが2未満の場合は飽和する）
+         */
+        friend Fixed atan2(Fixed y, Fixed x)
+        {
+            return fromRaw(saturate(fixed_detail::rescale<30, FracBits>(fixed_detail::atan2Q30(y._raw, x._raw))));
+        }
+
+    private:
+        struct RawTag
+        {
+        };
+
+        static constexpr raw_t RAW_MAX = static_cast<raw_t>((std::int64_t(1) << (IntBits + FracBits)) - 1);
+
+        constexpr Fixed(raw_t raw, RawTag) : _raw(raw) {}
+
+        static constexpr raw_t saturate(std::int64_t v)
+        {
+            return v > RAW_MAX ? RAW_MAX : (v < -RAW_MAX ? static_cast<raw_t>(-RAW_MAX) : static_cast<raw_t>(v));
+        }
+
+        template <typename U>
+        static constexpr raw_t convert(U v, std::false_type)
+        {
+            return convertInt(static_cast<long long>(v));
+        }
+
+        static constexpr raw_t convertInt(long long v)
+        {
+            return v > (RAW_MAX >> FracBits) ? RAW_MAX : (v < -(RAW_MAX >> FracBits) ? static_cast<raw_t>(-RAW_MAX) : static_cast<raw_t>(v * (1LL << FracBits)));
+        }
+
+        template <typename U>
+        static constexpr raw_t convert(U v, std::true_type)
+        {
+            return convertScaled(static_cast<double>(v) * static_cast<double>(1LL << FracBits));
+        }
+
+        static constexpr raw_t convertScaled(double s)
+        {
+            return s >= RAW_MAX ? RAW_MAX : (s <= -RAW_MAX ? static_cast<raw_t>(-RAW_MAX) : static_cast<raw_t>(s >= 0 ? s + 0.5 : s - 0.5));
+        }
+
+        raw_t _raw = 0; /**< 値 * 2^FracBits */
+    };
+
+    template <int IntBits, int FracBits>
+    constexpr typename Fixed<IntBits, FracBits>::raw_t Fixed<IntBits, FracBits>::RAW_MAX;
+
+    /**
+     * @brief Q15.16（int32_t，±32768，分解能1.5e-5）
+     */
+    using fixed32_t = Fixed<15, 16>;
+
+    /**
+     * @brief Q7.8（int16_t，±128，分解能3.9e-3）
+     */
+    using fixed16_t = Fixed<7, 8>;
+
+    /**
+     * @brief sinとcosを同時に計算（固定小数点数版）
+     */
+    template <int IntBits, int FracBits>
+    inline void trigSinCos(Fixed<IntBits, FracBits> angle, Fixed<IntBits, FracBits> &s, Fixed<IntBits, FracBits> &c)
+    {
+        sinCos(angle, s, c);
+    }
+
+    /**
+     * @brief atan2（固定小数点数版）
+     */
+    template <int IntBits, int FracBits>
+    inline Fixed<IntBits, FracBits> trigAtan2(Fixed<IntBits, FracBits> y, Fixed<IntBits, FracBits> x)
+    {
+        return atan2(y, x);
+    }
+
+    template <typename Char, int IntBits, int FracBits>
+    inline std::basic_ostream<Char> &operator<<(std::basic_ostream<Char> &os, const Fixed<IntBits, FracBits> &v)
+    {
+        return os << v.toDouble();
+    }
+} // namespace myStd
+#endif // Fixed_h
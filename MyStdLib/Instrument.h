@@ -0,0 +1,414 @@
+/**
+ * @file Instrument.h
+ * @brief 制御ループの計測（処理時間のヒストグラム，飽和と積分値のカウンタ）
+ * @details MYSTD_INSTRUMENTATIONを定義してからincludeすると，PID，PurePursuitControlがインスタンスごとに
+ *          ControllerProbeを持ち，update()の処理時間，出力制限（guard()）で飽和した回数，積分値の大きさを記録する．
+ *          記録した値はgetProbe().snapshot()で取り出す．
+ *          定義しない場合は計測のコード（MYSTD_PROBE_*）とメンバが全て消え，計測しない場合と同じコードになる．
+ * @attention MYSTD_INSTRUMENTATIONは全ての翻訳単位で揃えること（クラスの大きさが変わるため）
+**/
+#ifndef Instrument_h
+#define Instrument_h
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <string>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "./MyStdFunctions.h"
+
+namespace myStd
+{
+    namespace instrument
+    {
+        /**
+         * @brief 時刻の読み出し（x86はTSC，AArch64は仮想カウンタ，その他はsteady_clockのns）
+         * @details 単位は環境によって異なるため，秒に直す場合はticksPerSecond()を使う
+         */
+        inline std::uint64_t readTicks()
+        {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+            return __rdtsc();
+#elif defined(__x86_64__) || defined(__i386__)
+            return __rdtsc();
+#elif defined(__aarch64__)
+            std::uint64_t v;
+            asm volatile("mrs %0, cntvct_el0" : "=r"(v));
+            return v;
+#else
+            return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                  std::chrono::steady_clock::now().time_since_epoch())
+                                                  .count());
+#endif
+        }
+
+        /**
+         * @brief 1秒あたりのreadTicks()の増分
+         * @details 初回の呼び出しでsteady_clockと比べて測る（約10msビジーウェイトする）．2回目以降は保存した値を返す
+         */
+        inline double ticksPerSecond()
+        {
+            static const double freq = [] {
+                const auto t0 = std::chrono::steady_clock::now();
+                const std::uint64_t c0 = readTicks();
+                auto t1 = t0;
+                while (t1 - t0 < std::chrono::milliseconds(10))
+                    t1 = std::chrono::steady_clock::now();
+                const std::uint64_t c1 = readTicks();
+                return static_cast<double>(c1 - c0) / std::chrono::duration<double>(t1 - t0).count();
+            }();
+            return freq;
+        }
+
+        inline int floorLog2(std::uint64_t v)
+        {
+#if defined(__GNUC__)
+            return 63 - __builtin_clzll(v);
+#else
+            int e = 0;
+            while (v >>= 1)
+                e++;
+            return e;
+#endif
+        }
+    } // namespace instrument
+
+    /**
+     * @brief 値の分布を一定の相対誤差で記録するヒストグラム（HDR Histogram方式）
+     * @details 2のべき乗ごとの区間をさらに2^SubBits個に等分したビンに数える．
+     *          record()はビンの番号をビット演算で求めて加算するだけで，メモリ確保は行わない．
+     *          percentile()の相対誤差は2^-SubBits以下（SubBits = 3で12.5%）．
+     *          2^MaxBits以上の値は最後のビンに数える（getMax()は正確な値を返す）．
+     * @tparam SubBits: 2のべき乗の区間を分割するビット数
+     * @tparam MaxBits: 区別できる値の上限のビット数
+    **/
+    template <int SubBits = 3, int MaxBits = 32>
+    class LatencyHistogram
+    {
+        static_assert(SubBits >= 1 && SubBits < MaxBits && MaxBits <= 63, "invalid LatencyHistogram range");
+
+    public:
+        static constexpr int NUM_SUB = 1 << SubBits;
+        static constexpr int NUM_BINS = (MaxBits - SubBits + 1) * NUM_SUB;
+
+        LatencyHistogram() { reset(); }
+
+        /**
+         * @brief リセット
+         */
+        void reset()
+        {
+            for (std::uint64_t &c : _bins)
+                c = 0;
+            _count = 0;
+            _sum = 0;
+            _min_v = std::numeric_limits<std::uint64_t>::max();
+            _max_v = 0;
+        }
+
+        /**
+         * @brief 値の記録
+         * @param v: 値
+         */
+        inline void record(std::uint64_t v)
+        {
+            _bins[binIndex(v)]++;
+            _count++;
+            _sum += v;
+            _min_v = v < _min_v ? v : _min_v;
+            _max_v = v > _max_v ? v : _max_v;
+        }
+
+        /**
+         * @brief 別のヒストグラムを加える
+         * @param other: ヒストグラム
+         */
+        void merge(const LatencyHistogram &other)
+        {
+            for (int i = 0; i < NUM_BINS; i++)
+                _bins[i] += other._bins[i];
+            _count += other._count;
+            _sum += other._sum;
+            _min_v = other._min_v < _min_v ? other._min_v : _min_v;
+            _max_v = other._max_v > _max_v ? other._max_v : _max_v;
+        }
+
+        /**
+         * @brief パーセンタイル値
+         * @param q: 割合[%]（0～100）
+         * @return q%の値がそれ以下となる値（ビンの上端，記録が無い場合は0）
+         */
+        std::uint64_t percentile(double q) const
+        {
+            if (_count == 0)
+                return 0;
+            q = guard(q, 0.0, 100.0);
+            std::uint64_t rank = static_cast<std::uint64_t>(std::ceil(q / 100.0 * static_cast<double>(_count)));
+            rank = rank < 1 ? 1 : rank;
+            std::uint64_t seen = 0;
+            for (int i = 0; i < NUM_BINS; i++)
+            {
+                seen += _bins[i];
+                if (seen >= rank)
+                {
+                    const std::uint64_t upper = binLower(i) + binWidth(i) - 1;
+                    return upper < _max_v ? (upper > _min_v ? upper : _min_v) : _max_v;
+                }
+            }
+            return _max_v;
+        }
+
+        /**
+         * @brief 記録した回数
+         */
+        inline std::uint64_t count() const { return _count; }
+
+        /**
+         * @brief 記録した値の合計
+         */
+        inline std::uint64_t sum() const { return _sum; }
+
+        /**
+         * @brief 平均値（記録が無い場合は0）
+         */
+        inline double mean() const { return _count > 0 ? static_cast<double>(_sum) / static_cast<double>(_count) : 0.0; }
+
+        /**
+         * @brief 最小値（記録が無い場合は0）
+         */
+        inline std::uint64_t getMin() const { return _count > 0 ? _min_v : 0; }
+
+        /**
+         * @brief 最大値（記録が無い場合は0）
+         */
+        inline std::uint64_t getMax() const { return _max_v; }
+
+        /**
+         * @brief ビンの番号
+         * @param v: 値
+         */
+        static inline int binIndex(std::uint64_t v)
+        {
+            const std::uint64_t limit = (std::uint64_t(1) << MaxBits) - 1;
+            v = v < limit ? v : limit;
+            if (v < static_cast<std::uint64_t>(NUM_SUB))
+                return static_cast<int>(v);
+            const int e = instrument::floorLog2(v);
+            return (e - SubBits + 1) * NUM_SUB + static_cast<int>((v >> (e - SubBits)) - NUM_SUB);
+        }
+
+        /**
+         * @brief ビンの下端
+         * @param i: ビンの番号
+         */
+        static inline std::uint64_t binLower(int i)
+        {
+            if (i < NUM_SUB)
+                return static_cast<std::uint64_t>(i);
+            const int e = i / NUM_SUB + SubBits - 1;
+            return static_cast<std::uint64_t>(NUM_SUB + i % NUM_SUB) << (e - SubBits);
+        }
+
+        /**
+         * @brief ビンの幅
+         * @param i: ビンの番号
+         */
+        static inline std::uint64_t binWidth(int i)
+        {
+            return i < NUM_SUB ? 1 : std::uint64_t(1) << (i / NUM_SUB - 1);
+        }
+
+    private:
+        std::uint64_t _bins[NUM_BINS];
+        std::uint64_t _count;
+        std::uint64_t _sum;
+        std::uint64_t _min_v;
+        std::uint64_t _max_v;
+    };
+
+    /**
+     * @brief コントローラ1つ分の計測値
+     * @details update()を呼ぶスレッドだけが書き込む（アトミック操作を使わない）．
+     *          別のスレッドから読む場合は，書き込むスレッドでsnapshot()を取ってLatestValueなどで渡すこと．
+    **/
+    class ControllerProbe
+    {
+    public:
+        /**
+         * @brief 計測値のスナップショット（時間の単位はinstrument::readTicks()）
+         */
+        struct snapshot_t
+        {
+            std::uint64_t calls;           /**< update()の回数 */
+            std::uint64_t ticks_total;     /**< 処理時間の合計 */
+            double ticks_mean;             /**< 処理時間の平均 */
+            std::uint64_t ticks_min;       /**< 処理時間の最小値 */
+            std::uint64_t ticks_p50;       /**< 処理時間の中央値 */
+            std::uint64_t ticks_p90;       /**< 処理時間の90パーセンタイル値 */
+            std::uint64_t ticks_p99;       /**< 処理時間の99パーセンタイル値 */
+            std::uint64_t ticks_p999;      /**< 処理時間の99.9パーセンタイル値 */
+            std::uint64_t ticks_max;       /**< 処理時間の最大値 */
+            std::uint64_t saturated_low;   /**< 出力が最小値で制限された回数 */
+            std::uint64_t saturated_high;  /**< 出力が最大値で制限された回数 */
+            std::uint64_t integral_over;   /**< 積分値の絶対値が閾値を超えた回数 */
+            double integral_abs_mean;      /**< 積分値の絶対値の平均 */
+            double integral_abs_max;       /**< 積分値の絶対値の最大値 */
+
+            /**
+             * @brief JSON形式の文字列に変換
+             */
+            std::string toString() const
+            {
+                return "{\"calls\":" + std::to_string(calls) +
+                       ",\"ticks_total\":" + std::to_string(ticks_total) +
+                       ",\"ticks_mean\":" + std::to_string(ticks_mean) +
+                       ",\"ticks_min\":" + std::to_string(ticks_min) +
+                       ",\"ticks_p50\":" + std::to_string(ticks_p50) +
+                       ",\"ticks_p90\":" + std::to_string(ticks_p90) +
+                       ",\"ticks_p99\":" + std::to_string(ticks_p99) +
+                       ",\"ticks_p999\":" + std::to_string(ticks_p999) +
+                       ",\"ticks_max\":" + std::to_string(ticks_max) +
+                       ",\"saturated_low\":" + std::to_string(saturated_low) +
+                       ",\"saturated_high\":" + std::to_string(saturated_high) +
+                       ",\"integral_over\":" + std::to_string(integral_over) +
+                       ",\"integral_abs_mean\":" + std::to_string(integral_abs_mean) +
+                       ",\"integral_abs_max\":" + std::to_string(integral_abs_max) + "}";
+            }
+        };
+
+        /**
+         * @brief update()の処理時間を計るスコープ（デストラクタで記録する）
+         */
+        class Scope
+        {
+        public:
+            explicit Scope(ControllerProbe &probe) : _probe(probe), _start(instrument::readTicks()) {}
+            ~Scope() { _probe.recordTicks(instrument::readTicks() - _start); }
+            Scope(const Scope &) = delete;
+            Scope &operator=(const Scope &) = delete;
+
+        private:
+            ControllerProbe &_probe;
+            std::uint64_t _start;
+        };
+
+        ControllerProbe() { reset(); }
+
+        /**
+         * @brief 計測値のリセット（積分値の閾値は保持する）
+         */
+        void reset()
+        {
+            _hist.reset();
+            _saturated_low = _saturated_high = 0;
+            _integral_count = _integral_over = 0;
+            _integral_abs_sum = _integral_abs_max = 0;
+        }
+
+        /**
+         * @brief 積分値の閾値の設定（超えた回数をintegral_overに数える，既定値は無限大）
+         * @param threshold: 閾値（絶対値）
+         */
+        inline void setIntegralThreshold(double threshold) { _integral_threshold = threshold; }
+
+        /**
+         * @brief 処理時間の記録
+         * @param ticks: 処理時間
+         */
+        inline void recordTicks(std::uint64_t ticks) { _hist.record(ticks); }
+
+        /**
+         * @brief 出力制限の記録（guard(v, min_v, max_v)の前に呼ぶ）
+         * @param v: 制限前の値
+         * @param min_v: 最小値
+         * @param max_v: 最大値
+         */
+        template <typename T>
+        inline void recordSaturation(const T &v, const T &min_v, const T &max_v)
+        {
+            _saturated_low += (v < min_v) ? 1 : 0;
+            _saturated_high += (v > max_v) ? 1 : 0;
+        }
+
+        /**
+         * @brief 積分値の記録
+         * @param integral: 積分値
+         */
+        template <typename T>
+        inline void recordIntegral(const T &integral)
+        {
+            using std::abs; // Fixedなどは実引数依存の名前探索で見つかるabs()を使う
+            const double a = static_cast<double>(abs(integral));
+            _integral_count++;
+            _integral_abs_sum += a;
+            _integral_abs_max = a > _integral_abs_max ? a : _integral_abs_max;
+            _integral_over += (a > _integral_threshold) ? 1 : 0;
+        }
+
+        /**
+         * @brief 処理時間のヒストグラムの取得
+         */
+        inline const LatencyHistogram<> &getHistogram() const { return _hist; }
+
+        /**
+         * @brief 計測値のスナップショット
+         */
+        snapshot_t snapshot() const
+        {
+            snapshot_t s;
+            s.calls = _hist.count();
+            s.ticks_total = _hist.sum();
+            s.ticks_mean = _hist.mean();
+            s.ticks_min = _hist.getMin();
+            s.ticks_p50 = _hist.percentile(50);
+            s.ticks_p90 = _hist.percentile(90);
+            s.ticks_p99 = _hist.percentile(99);
+            s.ticks_p999 = _hist.percentile(99.9);
+            s.ticks_max = _hist.getMax();
+            s.saturated_low = _saturated_low;
+            s.saturated_high = _saturated_high;
+            s.integral_over = _integral_over;
+            s.integral_abs_mean = _integral_count > 0 ? _integral_abs_sum / static_cast<double>(_integral_count) : 0.0;
+            s.integral_abs_max = _integral_abs_max;
+            return s;
+        }
+
+    private:
+        LatencyHistogram<> _hist;
+        std::uint64_t _saturated_low;
+        std::uint64_t _saturated_high;
+        std::uint64_t _integral_count;
+        std::uint64_t _integral_over;
+        double _integral_abs_sum;
+        double _integral_abs_max;
+        double _integral_threshold = std::numeric_limits<double>::infinity();
+    };
+
+    template <typename Char>
+    inline std::basic_ostream<Char> &operator<<(std::basic_ostream<Char> &os, const ControllerProbe::snapshot_t &s)
+    {
+        return os << s.toString().c_str();
+    }
+} // namespace myStd
+
+// 計測のフック（MYSTD_INSTRUMENTATIONを定義しない場合は何も生成しない）
+#if defined(MYSTD_INSTRUMENTATION)
+#define MYSTD_PROBE_MEMBER(probe) ::myStd::ControllerProbe probe;
+#define MYSTD_PROBE_SCOPE(probe) ::myStd::ControllerProbe::Scope mystd_probe_scope_(probe)
+#define MYSTD_PROBE_SATURATION(probe, v, min_v, max_v) (probe).recordSaturation(v, min_v, max_v)
+#define MYSTD_PROBE_INTEGRAL(probe, integral) (probe).recordIntegral(integral)
+#else
+#define MYSTD_PROBE_MEMBER(probe)
+#define MYSTD_PROBE_SCOPE(probe) ((void)0)
+#define MYSTD_PROBE_SATURATION(probe, v, min_v, max_v) ((void)0)
+#define MYSTD_PROBE_INTEGRAL(probe, integral) ((void)0)
+#endif
+
+#endif // Instrument_h
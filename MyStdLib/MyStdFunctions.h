@@ -5,10 +5,19 @@
 #ifndef MyStdFunctions_h
 #define MyStdFunctions_h
 
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <cmath>
 #include <string>
+#include <type_traits>
+
+// C++14以降でのみconstexprにできる関数（メンバの変更を含むもの）に付ける
+#if defined(__cpp_constexpr) && __cpp_constexpr >= 201304L
+#define MYSTD_CONSTEXPR14 constexpr
+#else
+#define MYSTD_CONSTEXPR14
+#endif
 
 constexpr double PI = 3.1415926535897932384626433832795;
 constexpr double HALF_PI = PI / 2.0;
@@ -24,6 +33,30 @@ constexpr double gfm2Nm = GRAVITY;
 constexpr double mNm2gfcm = (Nm2gfm * 100);
 constexpr double gfcm2mNm = (gfm2Nm / 100);
 
+// 型Tの定数（floatの計算にdoubleの定数が混ざって倍精度に昇格しないよう，計算する型に合わせて使う）
+// 例: x * pi<float>()
+template <typename T>
+constexpr T pi() { return static_cast<T>(3.1415926535897932384626433832795L); }
+template <typename T>
+constexpr T halfPi() { return static_cast<T>(3.1415926535897932384626433832795L / 2); }
+template <typename T>
+constexpr T twoPi() { return static_cast<T>(3.1415926535897932384626433832795L * 2); }
+template <typename T>
+constexpr T degToRad() { return static_cast<T>(3.1415926535897932384626433832795L / 180); }
+template <typename T>
+constexpr T radToDeg() { return static_cast<T>(180 / 3.1415926535897932384626433832795L); }
+template <typename T>
+constexpr T euler() { return static_cast<T>(2.718281828459045235360287471352L); }
+
+namespace myStd
+{
+    /**
+     * @brief Tが浮動小数点型ならT，整数型ならdouble（角度の変換など結果が小数になる関数の戻り値の型）
+     */
+    template <typename T>
+    using real_t = typename std::conditional<std::is_floating_point<T>::value, T, double>::type;
+} // namespace myStd
+
 //#define min(a,b) ((a)<(b)?(a):(b))
 using std::min;
 
@@ -44,13 +77,13 @@ static inline T sq(T x)
 }
 
 template <typename T>
-static inline T constrain(T x, T min, T max)
+static constexpr inline T constrain(T x, T min, T max)
 {
     return ((x) < (min) ? (min) : ((x) > (max) ? (max) : (x)));
 }
 
 template <typename T>
-static inline T guard(T x, T min, T max)
+static constexpr inline T guard(T x, T min, T max)
 {
     return constrain<T>(x, min, max);
 }
@@ -68,15 +101,15 @@ static inline T guardAbs(T x, T max)
 }
 
 template <typename T>
-static inline double radians(T deg)
+static inline myStd::real_t<T> radians(T deg)
 {
-    return (deg * DEG_TO_RAD);
+    return (deg * degToRad<myStd::real_t<T>>());
 }
 
 template <typename T>
-static inline double degrees(T rad)
+static inline myStd::real_t<T> degrees(T rad)
 {
-    return (rad * RAD_TO_DEG);
+    return (rad * radToDeg<myStd::real_t<T>>());
 }
 
 template <typename T>
@@ -133,40 +166,87 @@ static inline T map(T x, T in_min, T in_max, T out_min, T out_max)
     return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
 }
 
+// 浮動小数点型はその型のまま計算し，整数や型の混在した引数はdouble版を使う
+template <typename T, typename std::enable_if<std::is_floating_point<T>::value, int>::type = 0>
+static inline T leap(T a, T b, T t)
+{
+    t = guard<T>(t, 0, 1);
+    return (a + (b - a) * t);
+}
+
 static inline double leap(double a, double b, double t)
 {
-    t = guard(t, 0.0, 1.0);
+    return leap<double>(a, b, t);
+}
+
+template <typename T, typename std::enable_if<std::is_floating_point<T>::value, int>::type = 0>
+static inline T leapUnclamped(T a, T b, T t)
+{
     return (a + (b - a) * t);
 }
 
 static inline double leapUnclamped(double a, double b, double t)
 {
-    return (a + (b - a) * t);
+    return leapUnclamped<double>(a, b, t);
+}
+
+// fmod(fmod(angle, 2pi) + 2pi, 2pi)と同じ結果をfmod1回で求める
+// |angle|が数周以内とわかっている場合はmyStd::fastNormalizeAnglePositive()（FastMath.h）が速い
+template <typename T, typename std::enable_if<std::is_floating_point<T>::value, int>::type = 0>
+static inline T normalizeAnglePositive(T angle)
+{
+    T a = std::fmod(angle, twoPi<T>());
+    if (a < 0)
+    {
+        a += twoPi<T>();
+        if (a >= twoPi<T>())
+            a -= twoPi<T>();
+    }
+    return a;
 }
 
 static inline double normalizeAnglePositive(double angle)
 {
-    return fmod(fmod(angle, 2.0 * PI) + 2.0 * PI, 2.0 * PI);
+    return normalizeAnglePositive<double>(angle);
 }
 
-static inline double normalizeAngle(double angle)
+template <typename T, typename std::enable_if<std::is_floating_point<T>::value, int>::type = 0>
+static inline T normalizeAngle(T angle)
 {
-    double a = normalizeAnglePositive(angle);
-    if (a > PI)
-        a -= 2.0 * PI;
+    T a = normalizeAnglePositive<T>(angle);
+    if (a > pi<T>())
+        a -= twoPi<T>();
     return a;
 }
 
+static inline double normalizeAngle(double angle)
+{
+    return normalizeAngle<double>(angle);
+}
+
+template <typename T, typename std::enable_if<std::is_floating_point<T>::value, int>::type = 0>
+static inline T shortestAngularDistance(T from, T to)
+{
+    return normalizeAngle<T>(to - from);
+}
+
 static inline double shortestAngularDistance(double from, double to)
 {
-    return normalizeAngle(to - from);
+    return shortestAngularDistance<double>(from, to);
+}
+
+template <typename T, typename std::enable_if<std::is_floating_point<T>::value, int>::type = 0>
+static inline T normalizeAbs90deg(T angle)
+{
+    return std::fmod(std::fmod(angle + halfPi<T>(), pi<T>()) + pi<T>(), pi<T>()) - halfPi<T>();
 }
 
 static inline double normalizeAbs90deg(double angle)
 {
-    return fmod(fmod(angle + HALF_PI, PI) + PI, PI) - HALF_PI;
+    return normalizeAbs90deg<double>(angle);
 }
 
+// 要素の移動がO(num)なので，大きな窓にはmyStd::RingBufferを使う
 template <typename T>
 void dataShiftToLast(T new_data, T *data_array, int num)
 {
@@ -175,4 +255,164 @@ void dataShiftToLast(T new_data, T *data_array, int num)
     data_array[0] = new_data;
 }
 
+namespace myStd
+{
+    /**
+     * @brief 容量固定のリングバッファ（移動平均などの窓用）
+     * @details dataShiftToLast()と同じく[0]が最新，[N - 1]が最古の順で参照できる．
+     *          push()は合計の更新も含めて最悪O(1)（最小値，最大値は償却O(1)）で，動的なメモリ確保は行わない．
+     *          まだ書き込まれていない要素はT()として読める（0で初期化した配列にdataShiftToLast()した場合と同じ）．
+     *          getSum()，getMean()，getMin()，getMax()は書き込まれた要素（最大N個）のみを対象とする．
+     * @tparam T: 数値型
+     * @tparam N: 容量
+    **/
+    template <typename T, std::size_t N>
+    class RingBuffer
+    {
+        static_assert(N > 0, "RingBuffer capacity must be positive");
+
+    public:
+        /**
+         * @brief コンストラクタ
+         */
+        MYSTD_CONSTEXPR14 RingBuffer() : _data(), _min_seq(), _max_seq() {}
+
+        /**
+         * @brief すべての要素をT()にする
+         */
+        MYSTD_CONSTEXPR14 void clear()
+        {
+            for (std::size_t i = 0; i < N; i++)
+                _data[i] = T();
+            _head = N - 1;
+            _count = 0;
+            _sum = _lap_sum = T();
+            _min_front = _min_len = _max_front = _max_len = 0;
+        }
+
+        /**
+         * @brief 最新の値として追加（最古の値は捨てる）
+         * @param x: 値
+         */
+        MYSTD_CONSTEXPR14 void push(const T &x);
+
+        /**
+         * @brief 値の取得
+         * @param i: 新しい方から数えた位置（0: 最新，N - 1: 最古）
+         */
+        MYSTD_CONSTEXPR14 const T &operator[](std::size_t i) const { return _data[_head >= i ? _head - i : _head + N - i]; }
+
+        /**
+         * @brief 最新の値の取得
+         */
+        MYSTD_CONSTEXPR14 const T &newest() const { return _data[_head]; }
+
+        /**
+         * @brief 最古の値の取得（書き込まれた要素のうち最も古いもの）
+         */
+        MYSTD_CONSTEXPR14 const T &oldest() const { return (*this)[size() == 0 ? 0 : size() - 1]; }
+
+        /**
+         * @brief 容量の取得
+         */
+        constexpr std::size_t capacity() const { return N; }
+
+        /**
+         * @brief 書き込まれた要素の数の取得
+         */
+        constexpr std::size_t size() const { return _count < N ? _count : N; }
+
+        /**
+         * @brief 容量いっぱいまで書き込まれているか
+         */
+        constexpr bool full() const { return _count >= N; }
+
+        /**
+         * @brief 合計の取得
+         */
+        constexpr T getSum() const { return _sum; }
+
+        /**
+         * @brief 平均の取得（要素がない場合はT()）
+         */
+        constexpr T getMean() const { return size() == 0 ? T() : _sum / static_cast<T>(size()); }
+
+        /**
+         * @brief 最小値の取得（要素がない場合はT()）
+         */
+        MYSTD_CONSTEXPR14 T getMin() const { return _min_len == 0 ? T() : _data[_min_seq[_min_front] % N]; }
+
+        /**
+         * @brief 最大値の取得（要素がない場合はT()）
+         */
+        MYSTD_CONSTEXPR14 T getMax() const { return _max_len == 0 ? T() : _data[_max_seq[_max_front] % N]; }
+
+    private:
+        MYSTD_CONSTEXPR14 void pushWedge(std::size_t *seq, std::size_t &front, std::size_t &len, const T &x, bool is_min);
+
+        T _data[N];
+        std::size_t _head = N - 1; // 最新の値の位置
+        std::size_t _count = 0;    // これまでに追加した数（_count - 1番目の値が_data[_head]）
+        T _sum = T();
+        T _lap_sum = T(); // 今の周に追加した値の合計
+
+        // 窓内の最小値，最大値の候補（単調キュー）．追加した順番をリングバッファで保持する
+        std::size_t _min_seq[N];
+        std::size_t _min_front = 0, _min_len = 0;
+        std::size_t _max_seq[N];
+        std::size_t _max_front = 0, _max_len = 0;
+    };
+
+    template <typename T, std::size_t N>
+    MYSTD_CONSTEXPR14 inline void RingBuffer<T, N>::push(const T &x)
+    {
+        _head = (_head + 1 == N) ? 0 : _head + 1;
+        const T old = _data[_head];
+        _data[_head] = x;
+        _count++;
+
+        if (_count > N)
+            _sum -= old;
+        _sum += x;
+        // 浮動小数点数は誤差が溜まらないよう，一周分の値を引き算なしで別に足しておき，一周ごとに合計を置き換える
+        // （_data[0]から順に足した合計と同じになる．1回のpush()で足すのは1要素のみ）
+        if (std::is_floating_point<T>::value)
+        {
+            _lap_sum += x;
+            if (_head == N - 1)
+            {
+                _sum = _lap_sum;
+                _lap_sum = T();
+            }
+        }
+
+        pushWedge(_min_seq, _min_front, _min_len, x, true);
+        pushWedge(_max_seq, _max_front, _max_len, x, false);
+    }
+
+    template <typename T, std::size_t N>
+    MYSTD_CONSTEXPR14 inline void RingBuffer<T, N>::pushWedge(std::size_t *seq, std::size_t &front, std::size_t &len, const T &x, bool is_min)
+    {
+        const std::size_t now = _count - 1;
+        // 窓から外れた候補を捨てる
+        if (len > 0 && seq[front] + N <= now)
+        {
+            front = (front + 1 == N) ? 0 : front + 1;
+            len--;
+        }
+        // 新しい値より悪い候補は二度と選ばれないので捨てる
+        while (len > 0)
+        {
+            const std::size_t back = (front + len - 1) % N;
+            const T &v = _data[seq[back] % N];
+            if (is_min ? !(x < v) : !(v < x))
+                break;
+            len--;
+        }
+        seq[(front + len) % N] = now;
+        len++;
+    }
+
+} // namespace myStd
+
 #endif // MyStdFunctions_h
@@ -2,6 +2,10 @@
 #define MyStdLib_h
 
 #include "./MyStdFunctions.h"
+#include "./FastMath.h"
+#include "./Instrument.h"
+#include "./Trace.h"
+#include "./Fixed.h"
 #include "./Vector/Vector.h"
 #include "./Control/Control.h"
 
@@ -0,0 +1,159 @@
+/**
+ * @file FleetTracker.h
+ * @brief 多数のPurePursuitControlを並列に更新する
+**/
+#ifndef FleetTracker_h
+#define FleetTracker_h
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "./../MyStdFunctions.h"
+#include "./../Vector/Vector.h"
+#include "./../Control/PurePursuitControl.h"
+#include "ThreadPool.h"
+
+namespace myStd
+{
+    /**
+     * @brief 多数のPurePursuitControlを並列に更新する
+     * @details コントローラは連続した配列に保持し，update()でロボットの番号の範囲をスレッドプールで分担して更新する．
+     *          各ロボットの更新は自分のコントローラと出力だけを書き換えるため，
+     *          結果はスレッド数や分担によらず逐次に更新した場合とビット単位で一致する．
+     *
+     *          経路データと，それから作る空間インデックス，弧長テーブルはFleetTrackerが経路ごとに1つずつ保持し，
+     *          同じ経路を追従するロボットはsetPathView()でそれらを共有する．経路は登録後に変更できない．
+     * @tparam T: 数値型
+     * @tparam T_fbc: 追従用のフィードバックコントローラ
+    **/
+    template <typename T, typename T_fbc>
+    class FleetTracker
+    {
+    public:
+        using controller_t = PurePursuitControl<T, T_fbc>;
+
+        /**
+         * @brief コンストラクタ
+         * @param num_threads: 呼び出したスレッドを含むスレッド数（0の場合はハードウェアのスレッド数）
+         */
+        explicit FleetTracker(std::size_t num_threads = 0) : _pool(num_threads) {}
+
+        /**
+         * @brief 経路データの登録
+         * @param path: 経路データ（右辺値を渡した場合はコピーせずに引き継ぐ）
+         * @return 経路の番号
+         */
+        int addPath(std::vector<Pose2D<T>> path)
+        {
+            path_t *p = new path_t;
+            p->poses = std::move(path);
+            p->index.build(p->poses.data(), p->poses.size());
+            p->table.build(p->poses.data(), p->poses.size());
+            _paths.emplace_back(p);
+            return static_cast<int>(_paths.size() - 1);
+        }
+
+        /**
+         * @brief ロボットの登録
+         * @param path_id: 追従する経路の番号（addPath()の戻り値）
+         * @param controller: ロボットのコントローラ（ゲイン，先読み距離などを設定したもの，経路は上書きする）
+         * @return ロボットの番号（経路の番号が不正な場合は-1）
+         */
+        int addRobot(int path_id, controller_t controller)
+        {
+            if (path_id < 0 || path_id >= static_cast<int>(_paths.size()))
+                return -1;
+            const path_t &path = *_paths[path_id];
+            controller.setPathView(path.poses.data(), path.poses.size(), path.index, path.table);
+            _controllers.push_back(std::move(controller));
+            _outputs.push_back(Pose2D<T>());
+            return static_cast<int>(_controllers.size() - 1);
+        }
+
+        /**
+         * @brief 全てのロボットを予約（addRobot()での再確保を防ぐ）
+         * @param num: ロボットの数
+         */
+        void reserve(std::size_t num)
+        {
+            _controllers.reserve(num);
+            _outputs.reserve(num);
+        }
+
+        /**
+         * @brief 一度に1スレッドが取り出すロボットの数の設定
+         * @param grain: ロボットの数（1以上，既定値は64）
+         */
+        inline void setGrain(std::size_t grain) { _grain = max<std::size_t>(grain, 1); }
+
+        /**
+         * @brief 全てのロボットの更新（PurePursuitControl::update(now_pose, dt)）
+         * @param now_poses: ロボットごとの現在位置（ロボットの数の要素）
+         * @param dt: 前回この関数をコールしてからの経過時間
+         */
+        void update(const Pose2D<T> *now_poses, T dt)
+        {
+            controller_t *controllers = _controllers.data();
+            Pose2D<T> *outputs = _outputs.data();
+            _pool.parallelFor(0, _controllers.size(), _grain, [=](std::size_t first, std::size_t last) {
+                for (std::size_t i = first; i < last; i++)
+                {
+                    controllers[i].update(now_poses[i], dt);
+                    outputs[i] = controllers[i].getControlVal();
+                }
+            });
+        }
+
+        /**
+         * @brief 全てのロボットの更新
+         * @param now_poses: ロボットごとの現在位置
+         * @param dt: 前回この関数をコールしてからの経過時間
+         */
+        inline void update(const std::vector<Pose2D<T>> &now_poses, T dt) { update(now_poses.data(), dt); }
+
+        /**
+         * @brief ロボットの数
+         */
+        inline std::size_t size() const { return _controllers.size(); }
+
+        /**
+         * @brief スレッド数
+         */
+        inline std::size_t getNumThreads() const { return _pool.size(); }
+
+        /**
+         * @brief ロボットのコントローラの取得
+         * @param id: ロボットの番号
+         */
+        inline controller_t &getController(int id) { return _controllers[id]; }
+
+        /**
+         * @brief 制御量（update()の結果）の取得
+         * @param id: ロボットの番号
+         */
+        inline const Pose2D<T> &getControlVal(int id) const { return _outputs[id]; }
+
+        /**
+         * @brief 全てのロボットの制御量（ロボットの番号順）
+         */
+        inline const std::vector<Pose2D<T>> &getControlVals() const { return _outputs; }
+
+    private:
+        // 経路データと，全てのロボットで共有する空間インデックス，弧長テーブル
+        struct path_t
+        {
+            std::vector<Pose2D<T>> poses;
+            PathIndex<T> index;
+            ArcLengthTable<T> table;
+        };
+
+        ThreadPool _pool;
+        std::vector<std::unique_ptr<const path_t>> _paths; // 経路ごとのデータ（要素のアドレスは変わらない）
+        std::vector<controller_t> _controllers;
+        std::vector<Pose2D<T>> _outputs;
+        std::size_t _grain = 64;
+    };
+} // namespace myStd
+
+#endif // FleetTracker_h
@@ -0,0 +1,141 @@
+/**
+ * @file LatestValue.h
+ * @brief 最新値を受け渡す待ち無しのセル（1スレッド書き込み，複数スレッド読み出し）
+**/
+#ifndef LatestValue_h
+#define LatestValue_h
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "./../MyStdFunctions.h"
+#include "./../AlignedAllocator.h"
+
+namespace myStd
+{
+    /**
+     * @brief 最新値を受け渡す待ち無しのセル（seqlock）
+     * @details 自己位置推定のスレッドが書いたPose2Dを制御スレッドが読む場合などに，mutexの代わりに使う．
+     *          書き込みは待ち無し（wait-free）で，読み出しが書き込みを妨げることはない．
+     *          読み出しは書き込みと重なった場合だけ読み直す．読み直しを許さない場合はtryLoad()を使う
+     *          （重なった場合はすぐにfalseを返す）．
+     *
+     *          値はstd::atomicの語の配列として保持し，読み書きはその語ごとの原子的な操作で行うため
+     *          データ競合にならず，途中まで書かれた値（torn read）を返すことはない．
+     *
+     *          書き込み側と読み出し側が同じキャッシュラインを共有しないよう64byte境界に揃える．
+     *          C++11のnewはalignof(std::max_align_t)（16byte）を超える境界を保証しないため，newで確保した場合も
+     *          揃うようにクラスのoperator newを定義している．std::make_shared()やstd::vectorなど
+     *          標準のアロケータを通す確保ではC++17より前は揃わないため，std::unique_ptrとnewを使うか，メンバや静的変数として置くこと．
+     * @attention 書き込むスレッドは1つだけにすること
+     * @tparam T: 値の型（Pose2D，Vector2，数値型などトリビアルにコピーできる型）
+    **/
+    template <typename T>
+    class alignas(64) LatestValue
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "LatestValue requires a trivially copyable type");
+
+    public:
+        /**
+         * @brief コンストラクタ（値はT()，version()は0）
+         */
+        LatestValue()
+        {
+            const T init = T();
+            writeWords(init);
+        }
+
+        LatestValue(const LatestValue &) = delete;
+        LatestValue &operator=(const LatestValue &) = delete;
+
+        /**
+         * @brief 64byte境界に揃えた確保（C++11のnewでは揃わないため）
+         */
+        static void *operator new(std::size_t size) { return AlignedAllocator<unsigned char, 64>().allocate(size); }
+        static void *operator new[](std::size_t size) { return AlignedAllocator<unsigned char, 64>().allocate(size); }
+        static void operator delete(void *p) { AlignedAllocator<unsigned char, 64>().deallocate(static_cast<unsigned char *>(p), 0); }
+        static void operator delete[](void *p) { AlignedAllocator<unsigned char, 64>().deallocate(static_cast<unsigned char *>(p), 0); }
+
+        /**
+         * @brief 値の書き込み（書き込むスレッドからのみ呼ぶ）
+         * @param value: 値
+         */
+        void store(const T &value)
+        {
+            const std::uint32_t seq = _seq.load(std::memory_order_relaxed);
+            _seq.store(seq + 1, std::memory_order_relaxed); // 奇数: 書き込み中
+            std::atomic_thread_fence(std::memory_order_release);
+            writeWords(value);
+            _seq.store(seq + 2, std::memory_order_release);
+        }
+
+        /**
+         * @brief 最新値の読み出し（書き込みと重なった場合は読み直す）
+         * @attention 書き込むスレッドが書き込みの途中でプリエンプトされると，再開して書き終えるまで上限なく回り続ける．
+         *            制御周期など待てる時間に上限がある場合はtryLoad()を使い，失敗したら前回の値を使うこと
+         * @return 最新値
+         */
+        T load() const
+        {
+            T value;
+            while (!tryLoad(value))
+            {
+            }
+            return value;
+        }
+
+        /**
+         * @brief 最新値の読み出しを1回だけ試す（待ち無し）
+         * @param value: 読み出した値の出力先（失敗した場合は変更しない）
+         * @param version: 読み出した値の番号の出力先（書き込みの回数，省略可）
+         * @return 読み出せたか（書き込みと重なった場合はfalse）
+         */
+        bool tryLoad(T &value, std::uint32_t *version = nullptr) const
+        {
+            const std::uint32_t s1 = _seq.load(std::memory_order_acquire);
+            if (s1 & 1)
+                return false;
+            T tmp;
+            readWords(tmp);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (_seq.load(std::memory_order_relaxed) != s1)
+                return false;
+            value = tmp;
+            if (version)
+                *version = s1 / 2;
+            return true;
+        }
+
+        /**
+         * @brief 書き込みの回数（値を更新したかの確認用，2^31回で0に戻る）
+         */
+        inline std::uint32_t version() const { return _seq.load(std::memory_order_acquire) / 2; }
+
+    private:
+        using word_t = std::uint64_t;
+        static constexpr std::size_t NUM_WORDS = (sizeof(T) + sizeof(word_t) - 1) / sizeof(word_t);
+
+        void writeWords(const T &value)
+        {
+            word_t buf[NUM_WORDS] = {};
+            std::memcpy(buf, &value, sizeof(T));
+            for (std::size_t i = 0; i < NUM_WORDS; i++)
+                _data[i].store(buf[i], std::memory_order_relaxed);
+        }
+
+        void readWords(T &value) const
+        {
+            word_t buf[NUM_WORDS];
+            for (std::size_t i = 0; i < NUM_WORDS; i++)
+                buf[i] = _data[i].load(std::memory_order_relaxed);
+            std::memcpy(&value, buf, sizeof(T));
+        }
+
+        std::atomic<std::uint32_t> _seq{0}; /**< 書き込み回数 * 2（書き込み中は奇数） */
+        std::atomic<word_t> _data[NUM_WORDS];
+    };
+} // namespace myStd
+
+#endif // LatestValue_h
@@ -0,0 +1,462 @@
+/**
+ * @file PIDAutotuner.h
+ * @brief 制御対象のモデルに対するPIDゲインの並列自動調整
+**/
+#ifndef PIDAutotuner_h
+#define PIDAutotuner_h
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+#include "./../MyStdFunctions.h"
+#include "./../Control/FBController/PID.h"
+#include "ThreadPool.h"
+
+namespace myStd
+{
+    /**
+     * @brief 制御対象のモデルに対するPIDゲインの並列自動調整
+     * @details ステップ応答のIAE，ISE，オーバーシュート，整定時間の重み付き和を評価値とし，これを最小にするゲインを探す．
+     *          ゲインの範囲を格子状に評価し，評価値の良い点から順にnum_starts個の点を始点としてNelder-Mead法で局所探索する．
+     *          探索は各軸を[0, 1]に正規化した空間で行い，下限が正の軸は対数で等間隔にする．
+     *
+     *          格子点の評価と各始点からの局所探索はスレッドプールで分担する．
+     *          PIDと制御対象の作業用のコピーはスレッドごとにコンストラクタで確保し，評価の度に初期化して使い回す．
+     *          各評価は独立しているため，結果はスレッド数や分担によらず一致する．
+     * @tparam T: 数値型
+     * @tparam T_plant: 制御対象のモデル（コピー可能でreset()，T step(T u)，T getOutput()，T getDt()を持つもの）
+    **/
+    template <typename T, typename T_plant>
+    class PIDAutotuner
+    {
+    public:
+        using controller_t = PID<T>;
+        using gain_t = typename controller_t::gain_t;
+        using Mode = typename controller_t::Mode;
+
+        /**
+         * @brief パラメータ構造体
+         */
+        struct param_t
+        {
+            Mode mode;                  /**< PIDモード */
+            T duration;                 /**< ステップ応答の時間[s] */
+            T setpoint;                 /**< 目標値（0以外） */
+            bool need_saturation;       /**< 出力制限を行うか */
+            T output_min;               /**< 出力制限時の最小値 */
+            T output_max;               /**< 出力制限時の最大値 */
+            gain_t gain_min;            /**< ゲインの下限（下限が正の軸は対数で探索する） */
+            gain_t gain_max;            /**< ゲインの上限（下限以下の軸は下限の値に固定する） */
+            std::size_t grid_size;      /**< 格子の1軸あたりの点数 */
+            std::size_t num_starts;     /**< 局所探索の始点の数 */
+            std::size_t max_iterations; /**< 局所探索の1始点あたりの最大反復回数 */
+            T settling_band;            /**< 整定とみなす偏差（目標値に対する比） */
+            T divergence;               /**< 発散とみなす出力の大きさ（目標値に対する比） */
+            T w_iae;                    /**< IAEの重み */
+            T w_ise;                    /**< ISEの重み */
+            T w_overshoot;              /**< オーバーシュート（目標値に対する比）の重み */
+            T w_settling;               /**< 整定時間[s]の重み */
+        };
+
+        /**
+         * @brief ステップ応答の評価指標
+         */
+        struct metrics_t
+        {
+            T iae;           /**< 偏差の絶対値の積分 */
+            T ise;           /**< 偏差の2乗の積分 */
+            T overshoot;     /**< 最大のオーバーシュート（目標値に対する比） */
+            T settling_time; /**< 整定時間[s]（整定しなかった場合はduration） */
+            bool stable;     /**< 発散しなかったか */
+        };
+
+        /**
+         * @brief 調整結果
+         */
+        struct result_t
+        {
+            gain_t gain;             /**< 最良のゲイン */
+            metrics_t metrics;       /**< 最良のゲインでの評価指標 */
+            T cost;                  /**< 最良のゲインでの評価値 */
+            T grid_cost;             /**< 格子探索での最良の評価値 */
+            std::size_t evaluations; /**< 評価した回数 */
+        };
+
+        /**
+         * @brief デフォルトのパラメータ
+         */
+        static param_t defaultParam()
+        {
+            param_t param;
+            param.mode = Mode::pPID;
+            param.duration = 5;
+            param.setpoint = 1;
+            param.need_saturation = true;
+            param.output_min = -10;
+            param.output_max = 10;
+            param.gain_min = {T(0.01), T(0.01), T(0.0001)};
+            param.gain_max = {T(100), T(100), T(10)};
+            param.grid_size = 8;
+            param.num_starts = 4;
+            param.max_iterations = 200;
+            param.settling_band = T(0.02);
+            param.divergence = 100;
+            param.w_iae = 1;
+            param.w_ise = 0;
+            param.w_overshoot = 1;
+            param.w_settling = T(0.1);
+            return param;
+        }
+
+        /**
+         * @brief コンストラクタ
+         * @param plant: 制御対象のモデル（スレッドごとにコピーする）
+         * @param param: パラメータ構造体
+         * @param num_threads: 呼び出したスレッドを含むスレッド数（0の場合はハードウェアのスレッド数）
+         */
+        PIDAutotuner(const T_plant &plant, const param_t &param = defaultParam(), std::size_t num_threads = 0)
+            : _pool(num_threads), _work(_pool.size(), workspace_t(plant))
+        {
+            setParam(param);
+        }
+
+        /**
+         * @brief パラメータの設定
+         * @param param: パラメータ構造体
+         */
+        void setParam(const param_t &param)
+        {
+            _param = param;
+            _dims = 0;
+            for (std::size_t i = 0; i < 3; i++)
+            {
+                T gain_t::*const k = gainAxis(i);
+                if (_param.gain_max.*k > _param.gain_min.*k)
+                    _axes[_dims++] = i;
+            }
+        }
+
+        /**
+         * @brief パラメータの取得
+         */
+        inline const param_t &getParam() const { return _param; }
+
+        /**
+         * @brief スレッド数の取得
+         */
+        inline std::size_t getNumThreads() const { return _pool.size(); }
+
+        /**
+         * @brief 1つのゲインのステップ応答を評価する
+         * @param gain: ゲイン
+         * @return 評価指標
+         * @attention tune()と同時に呼ばないこと
+         */
+        metrics_t evaluate(const gain_t &gain) { return simulate(_work[0], gain); }
+
+        /**
+         * @brief 評価指標から評価値を計算する
+         * @param m: 評価指標
+         * @return 評価値（発散した場合は無限大）
+         */
+        T cost(const metrics_t &m) const
+        {
+            const T c = _param.w_iae * m.iae + _param.w_ise * m.ise + _param.w_overshoot * m.overshoot + _param.w_settling * m.settling_time;
+            return (m.stable && std::isfinite(c)) ? c : std::numeric_limits<T>::infinity();
+        }
+
+        /**
+         * @brief ゲインを調整する
+         * @return 調整結果（探索する軸が無い場合は下限のゲインの評価）
+         */
+        result_t tune()
+        {
+            typedef std::array<T, 3> point_t;
+
+            // 格子点の評価
+            const std::size_t n = max<std::size_t>(_param.grid_size, 1);
+            std::size_t num_points = 1;
+            for (std::size_t d = 0; d < _dims; d++)
+                num_points *= n;
+            _grid_cost.resize(num_points);
+            _pool.parallelForWorker(0, num_points, 4, [&](std::size_t worker, std::size_t first, std::size_t last) {
+                for (std::size_t i = first; i < last; i++)
+                    _grid_cost[i] = cost(simulate(_work[worker], toGain(gridPoint(i, n))));
+            });
+
+            // 評価値の良い順（同じ場合は番号順）に始点を選ぶ
+            _order.resize(num_points);
+            for (std::size_t i = 0; i < num_points; i++)
+                _order[i] = i;
+            const std::size_t num_starts = (_dims == 0) ? 1 : guard<std::size_t>(_param.num_starts, 1, num_points);
+            std::partial_sort(_order.begin(), _order.begin() + num_starts, _order.end(), [&](std::size_t a, std::size_t b) {
+                return _grid_cost[a] < _grid_cost[b] || (_grid_cost[a] == _grid_cost[b] && a < b);
+            });
+
+            // 各始点からの局所探索（初期の単体の大きさは格子の間隔の半分）
+            const T step = (n > 1) ? T(0.5) / (n - 1) : T(0.25);
+            _starts.resize(num_starts);
+            _pool.parallelForWorker(0, num_starts, 1, [&](std::size_t worker, std::size_t first, std::size_t last) {
+                for (std::size_t s = first; s < last; s++)
+                {
+                    point_t x = gridPoint(_order[s], n);
+                    _starts[s].evaluations = nelderMead(_work[worker], x, _grid_cost[_order[s]], step, _starts[s].cost);
+                    _starts[s].x = x;
+                }
+            });
+
+            result_t result;
+            result.grid_cost = _grid_cost[_order[0]];
+            result.evaluations = num_points;
+            std::size_t best = 0;
+            for (std::size_t s = 0; s < num_starts; s++)
+            {
+                result.evaluations += _starts[s].evaluations;
+                if (_starts[s].cost < _starts[best].cost)
+                    best = s;
+            }
+            result.gain = toGain(_starts[best].x);
+            result.metrics = simulate(_work[0], result.gain);
+            result.cost = cost(result.metrics);
+            return result;
+        }
+
+    private:
+        // スレッドごとの作業領域（隣のスレッドの作業領域とキャッシュラインを共有しないよう詰め物をする）
+        struct workspace_t
+        {
+            controller_t pid;
+            T_plant plant;
+            char pad[64];
+
+            explicit workspace_t(const T_plant &p) : plant(p) {}
+        };
+
+        struct start_t
+        {
+            std::array<T, 3> x;
+            T cost;
+            std::size_t evaluations;
+        };
+
+        /**
+         * @brief ステップ応答を計算して評価指標を求める（メモリ確保を行わない）
+         */
+        metrics_t simulate(workspace_t &w, const gain_t &gain) const
+        {
+            w.pid.setParam({_param.mode, gain, _param.need_saturation, _param.output_min, _param.output_max});
+            w.pid.reset();
+            w.plant.reset();
+
+            const T dt = w.plant.getDt();
+            const T r = _param.setpoint;
+            const T r_abs = std::fabs(r);
+            const T sign = (r < 0) ? T(-1) : T(1);
+            const T band = _param.settling_band * r_abs;
+            const T limit = _param.divergence * r_abs;
+            const std::size_t num_steps = static_cast<std::size_t>(std::round(_param.duration / dt));
+
+            metrics_t m = {0, 0, 0, 0, true};
+            T y = w.plant.getOutput();
+            T peak = 0;
+            std::size_t last_out = 0;
+            for (std::size_t k = 0; k < num_steps; k++)
+            {
+                w.pid.update(r, y, dt);
+                y = w.plant.step(w.pid.getControlVal());
+                const T e = r - y;
+                const T e_abs = std::fabs(e);
+                m.iae += e_abs;
+                m.ise += e * e;
+                peak = max(peak, -sign * e);
+                if (e_abs > band)
+                    last_out = k + 1;
+                // NaNも発散とみなす
+                if (!(std::fabs(y) <= limit))
+                {
+                    m.stable = false;
+                    break;
+                }
+            }
+            m.iae *= dt;
+            m.ise *= dt;
+            m.overshoot = peak / r_abs;
+            m.settling_time = last_out * dt;
+            return m;
+        }
+
+        /**
+         * @brief 番号から格子点の正規化した座標を求める
+         */
+        std::array<T, 3> gridPoint(std::size_t index, std::size_t n) const
+        {
+            std::array<T, 3> x = {0, 0, 0};
+            for (std::size_t d = 0; d < _dims; d++)
+            {
+                x[d] = (n > 1) ? T(index % n) / (n - 1) : T(0.5);
+                index /= n;
+            }
+            return x;
+        }
+
+        /**
+         * @brief 正規化した座標からゲインを求める
+         */
+        gain_t toGain(const std::array<T, 3> &x) const
+        {
+            gain_t gain = _param.gain_min;
+            for (std::size_t d = 0; d < _dims; d++)
+            {
+                T gain_t::*const k = gainAxis(_axes[d]);
+                const T lo = _param.gain_min.*k, hi = _param.gain_max.*k;
+                const T u = guard(x[d], T(0), T(1));
+                gain.*k = (lo > 0) ? lo * std::pow(hi / lo, u) : lo + (hi - lo) * u;
+            }
+            return gain;
+        }
+
+        /**
+         * @brief 軸の番号に対応するゲインのメンバ（0: Kp, 1: Ki, 2: Kd）
+         */
+        static T gain_t::*gainAxis(std::size_t axis)
+        {
+            static T gain_t::*const axes[3] = {&gain_t::Kp, &gain_t::Ki, &gain_t::Kd};
+            return axes[axis];
+        }
+
+        /**
+         * @brief Nelder-Mead法による局所探索（座標は[0, 1]に制限する）
+         * @param w: 作業領域
+         * @param x: 始点，探索結果
+         * @param fx: 始点の評価値
+         * @param step: 初期の単体の大きさ
+         * @param f_out: 探索結果の評価値
+         * @return 評価した回数
+         */
+        std::size_t nelderMead(workspace_t &w, std::array<T, 3> &x, T fx, T step, T &f_out) const
+        {
+            typedef std::array<T, 3> point_t;
+            const std::size_t d = _dims;
+            std::size_t evaluations = 0;
+            auto f = [&](const point_t &p) {
+                evaluations++;
+                return cost(simulate(w, toGain(p)));
+            };
+            auto clamp = [&](point_t p) {
+                for (std::size_t i = 0; i < d; i++)
+                    p[i] = guard(p[i], T(0), T(1));
+                return p;
+            };
+            // p = a + c * (b - a)
+            auto lerp = [&](const point_t &a, const point_t &b, T c) {
+                point_t p = a;
+                for (std::size_t i = 0; i < d; i++)
+                    p[i] += c * (b[i] - a[i]);
+                return clamp(p);
+            };
+
+            if (d == 0)
+            {
+                f_out = fx;
+                return 0;
+            }
+
+            // 始点と，各軸の方向に（範囲の内側へ）ずらしたd点で単体を作る
+            std::array<point_t, 4> v;
+            std::array<T, 4> fv;
+            v[0] = x;
+            fv[0] = fx;
+            for (std::size_t i = 0; i < d; i++)
+            {
+                v[i + 1] = x;
+                v[i + 1][i] += (x[i] + step <= 1) ? step : -step;
+                fv[i + 1] = f(v[i + 1]);
+            }
+
+            std::array<std::size_t, 4> idx = {0, 1, 2, 3};
+            for (std::size_t iter = 0; iter < _param.max_iterations; iter++)
+            {
+                std::sort(idx.begin(), idx.begin() + d + 1, [&](std::size_t a, std::size_t b) {
+                    return fv[a] < fv[b] || (fv[a] == fv[b] && a < b);
+                });
+                const std::size_t best = idx[0], worst = idx[d], second = idx[d - 1];
+
+                // 単体が十分小さくなったら終了
+                T size = 0;
+                for (std::size_t j = 1; j <= d; j++)
+                    for (std::size_t i = 0; i < d; i++)
+                        size = max(size, std::fabs(v[idx[j]][i] - v[best][i]));
+                if (size < T(1e-4))
+                    break;
+
+                // 最悪の点以外の重心
+                point_t c = {0, 0, 0};
+                for (std::size_t j = 0; j < d; j++)
+                    for (std::size_t i = 0; i < d; i++)
+                        c[i] += v[idx[j]][i] / d;
+
+                const point_t xr = lerp(c, v[worst], T(-1)); // 反射
+                const T fr = f(xr);
+                if (fr < fv[best])
+                {
+                    const point_t xe = lerp(c, v[worst], T(-2)); // 拡大
+                    const T fe = f(xe);
+                    v[worst] = (fe < fr) ? xe : xr;
+                    fv[worst] = (fe < fr) ? fe : fr;
+                }
+                else if (fr < fv[second])
+                {
+                    v[worst] = xr;
+                    fv[worst] = fr;
+                }
+                else
+                {
+                    // 収縮（反射点が最悪の点より良ければ外側，そうでなければ内側）
+                    const bool outside = fr < fv[worst];
+                    const point_t xc = outside ? lerp(c, xr, T(0.5)) : lerp(c, v[worst], T(0.5));
+                    const T fc = f(xc);
+                    if (fc < (outside ? fr : fv[worst]))
+                    {
+                        v[worst] = xc;
+                        fv[worst] = fc;
+                    }
+                    else
+                    {
+                        // 最良の点に向けて縮小
+                        for (std::size_t j = 1; j <= d; j++)
+                        {
+                            v[idx[j]] = lerp(v[best], v[idx[j]], T(0.5));
+                            fv[idx[j]] = f(v[idx[j]]);
+                        }
+                    }
+                }
+            }
+
+            std::size_t best = 0;
+            for (std::size_t j = 1; j <= d; j++)
+            {
+                if (fv[j] < fv[best])
+                    best = j;
+            }
+            x = v[best];
+            f_out = fv[best];
+            return evaluations;
+        }
+
+        ThreadPool _pool;
+        std::vector<workspace_t> _work;
+        param_t _param;
+        std::array<std::size_t, 3> _axes = {0, 1, 2}; // 探索する軸（0: Kp, 1: Ki, 2: Kd）
+        std::size_t _dims = 0;                        // 探索する軸の数
+
+        // tune()の作業領域
+        std::vector<T> _grid_cost;
+        std::vector<std::size_t> _order;
+        std::vector<start_t> _starts;
+    };
+} // namespace myStd
+
+#endif // PIDAutotuner_h
@@ -0,0 +1,15 @@
+/**
+ * @file RealTime.h
+ * @brief スレッドを使う実行時の機能のヘッダ（MyStdLib.hには含めない）
+**/
+#ifndef RealTime_h
+#define RealTime_h
+
+#include "Scheduler.h"
+#include "LatestValue.h"
+#include "ThreadPool.h"
+#include "FleetTracker.h"
+#include "TraceRecorder.h"
+#include "PIDAutotuner.h"
+
+#endif // RealTime_h
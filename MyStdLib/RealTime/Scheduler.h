@@ -0,0 +1,483 @@
+/**
+ * @file Scheduler.h
+ * @brief 周期の異なる制御ループを実行するスケジューラ
+ * @details std::threadを使うため，MyStdLib.hには含めない（ホストPC，組み込みLinux向け）．
+**/
+#ifndef Scheduler_h
+#define Scheduler_h
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+#include "./../MyStdFunctions.h"
+
+namespace myStd
+{
+    /**
+     * @brief 周期の異なる制御ループを実行するスケジューラ
+     * @details 登録したタスクをワーカースレッドで周期的に呼び出し，実際の経過時間をdtとして渡す．
+     *          同じワーカーのタスクは周期の短い順（レートモノトニック）に実行され，
+     *          ワーカーのスレッド優先度も担当するタスクの最短周期が短い順に高くする．
+     *          タスクごとに起動の遅れ（ジッタ），実行時間，デッドラインミスを記録する．
+     *
+     *          周期の起点は前回の予定時刻なので，処理時間によって周期がずれることはない．
+     *          実行が周期を超えて遅れた場合は間に合わなかった周期を飛ばし（skippedに記録），位相を保つ．
+     *
+     *          例: 1kHzの電流制御，200Hzの速度制御，50Hzの経路追従を2つのワーカーで実行
+     * @code
+     *          myStd::Scheduler<double> sched(2);
+     *          sched.setAffinity(0, 2);
+     *          sched.addController(current_pid, 0.001, [&] { return current_ref; }, [&] { return readCurrent(); });
+     *          sched.addController(velocity_pid, 0.005, [&] { return velocity_ref; }, [&] { return readVelocity(); });
+     *          sched.addTask(0.02, [&](double dt) { ppc.update(idx, readPose(), dt); }, 1);
+     *          sched.start();
+     * @endcode
+     * @tparam T: dtの数値型
+    **/
+    template <typename T = double>
+    class Scheduler
+    {
+    public:
+        using clock_type = std::chrono::steady_clock;
+
+        /**
+         * @brief タスクの統計
+         */
+        struct stats_t
+        {
+            std::uint64_t count;   /**< 実行回数 */
+            std::uint64_t misses;  /**< デッドラインまでに終わらなかった回数 */
+            std::uint64_t skipped; /**< 前の実行の遅れで飛ばした周期の数 */
+            T jitter_mean;         /**< 予定時刻から実行開始までの遅れの平均[s] */
+            T jitter_max;          /**< 予定時刻から実行開始までの遅れの最大[s] */
+            T exec_mean;           /**< 実行時間の平均[s] */
+            T exec_max;            /**< 実行時間の最大[s] */
+        };
+
+        /**
+         * @brief コンストラクタ
+         * @param num_workers: ワーカースレッドの数
+         */
+        explicit Scheduler(std::size_t num_workers = 1) : _workers(num_workers > 0 ? num_workers : 1) {}
+
+        Scheduler(const Scheduler &) = delete;
+        Scheduler &operator=(const Scheduler &) = delete;
+
+        ~Scheduler() { stop(); }
+
+        /**
+         * @brief ワーカーを固定するCPUの設定（start()の前に呼ぶ，Linuxのみ有効）
+         * @param worker: ワーカーの番号
+         * @param cpu: CPUの番号（負の値は固定しない）
+         * @return 設定できたか
+         */
+        bool setAffinity(std::size_t worker, int cpu)
+        {
+            if (isRunning() || worker >= _workers.size())
+                return false;
+            _workers[worker].cpu = cpu;
+            return true;
+        }
+
+        /**
+         * @brief リアルタイム優先度（SCHED_FIFO）の設定（start()の前に呼ぶ，Linuxのみ有効）
+         * @details 最短周期が最も短いワーカーがbase_priority + ワーカー数 - 1，最も長いワーカーがbase_priorityになる．
+         *          権限がなく設定できなかった場合も実行は続ける（isRealTime()がfalseになる）
+         * @param enable: 有効にするか
+         * @param base_priority: 最も低いワーカーの優先度
+         */
+        void setRealTimePriority(bool enable, int base_priority = 50)
+        {
+            if (isRunning())
+                return;
+            _realtime = enable;
+            _base_priority = base_priority;
+        }
+
+        /**
+         * @brief 予定時刻の直前に待機をやめて空回りする時間の設定（start()の前に呼ぶ）
+         * @details OSの待機は起床が数十～数百us遅れることがあるため，ジッタを小さくしたい場合に使う．
+         *          その分ワーカーのCPUを消費する
+         * @param spin: 空回りする時間[s]（0の場合は空回りしない）
+         */
+        void setSpinWindow(T spin)
+        {
+            if (isRunning())
+                return;
+            _spin = std::chrono::nanoseconds(spin > 0 ? toNs(spin) : 0);
+        }
+
+        /**
+         * @brief タスクの登録（start()の前に呼ぶ）
+         * @param period: 周期[s]
+         * @param func: 周期ごとに呼び出す関数（引数は前回の実行開始からの経過時間[s]，初回は周期）
+         * @param worker: 実行するワーカーの番号（負の値の場合は負荷（周波数の和）が最も小さいワーカー）
+         * @param deadline: 予定時刻からのデッドライン[s]（0以下の場合は周期）
+         * @return タスクの番号（登録できなかった場合は-1）
+         */
+        template <typename F>
+        int addTask(T period, F &&func, int worker = -1, T deadline = 0);
+
+        /**
+         * @brief フィードバックコントローラの登録（start()の前に呼ぶ）
+         * @details 周期ごとにfbc.update(target(), now_val(), dt)を呼び出す
+         * @param fbc: コントローラ（スケジューラより長く存在すること）
+         * @param period: 周期[s]
+         * @param target: 目標値を返す関数
+         * @param now_val: 現在値を返す関数
+         * @param worker: 実行するワーカーの番号（負の値の場合は自動で選ぶ）
+         * @return タスクの番号（登録できなかった場合は-1）
+         */
+        template <typename C, typename FTarget, typename FNow>
+        int addController(C &fbc, T period, FTarget target, FNow now_val, int worker = -1)
+        {
+            return addTask(
+                period, [&fbc, target, now_val](T dt) mutable { fbc.update(target(), now_val(), dt); }, worker);
+        }
+
+        /**
+         * @brief 実行開始（全てのタスクの初回は開始時刻）
+         * @details 各ワーカーはCPUの固定と優先度を自分で設定してからタスクを実行する．全てのワーカーが設定を終えてから戻る
+         * @return 開始できたか（実行中の場合はfalse）
+         */
+        bool start();
+
+        /**
+         * @brief 実行停止（実行中のタスクが終わるまで待つ）
+         */
+        void stop();
+
+        /**
+         * @brief 実行中か
+         */
+        inline bool isRunning() const { return _running.load(std::memory_order_acquire); }
+
+        /**
+         * @brief 全てのワーカーにリアルタイム優先度を設定できたか
+         */
+        inline bool isRealTime() const { return _realtime_ok; }
+
+        /**
+         * @brief タスク数の取得
+         */
+        inline std::size_t size() const { return _tasks.size(); }
+
+        /**
+         * @brief タスクの統計の取得（実行中も呼び出せる）
+         * @param id: タスクの番号
+         */
+        stats_t getStats(int id) const;
+
+        /**
+         * @brief 全てのタスクの統計を0にする
+         */
+        void resetStats();
+
+    private:
+        struct Task
+        {
+            std::function<void(T)> func;
+            std::int64_t period;   // [ns]
+            std::int64_t deadline; // [ns]
+            std::size_t worker;
+            clock_type::time_point release;
+            clock_type::time_point last_start;
+            bool first;
+
+            // 統計（実行中に他のスレッドから読むため原子的に更新する）
+            std::atomic<std::uint64_t> count{0};
+            std::atomic<std::uint64_t> misses{0};
+            std::atomic<std::uint64_t> skipped{0};
+            std::atomic<std::int64_t> jitter_sum{0};
+            std::atomic<std::int64_t> jitter_max{0};
+            std::atomic<std::int64_t> exec_sum{0};
+            std::atomic<std::int64_t> exec_max{0};
+        };
+
+        struct Worker
+        {
+            int cpu = -1;
+            std::vector<Task *> tasks; // 周期の短い順
+            std::thread thread;
+        };
+
+        void run(std::size_t worker_idx, int priority);
+        void execute(Task &task, clock_type::time_point now);
+        bool applyThreadAttributes(const Worker &worker, int priority); // 呼び出したスレッドに設定する
+
+        static std::int64_t toNs(T s) { return static_cast<std::int64_t>(s * T(1e9)); }
+        static T toSec(std::int64_t ns) { return static_cast<T>(ns) / T(1e9); }
+
+        static void updateMax(std::atomic<std::int64_t> &max_v, std::int64_t v)
+        {
+            // 書き込むのは担当のワーカーだけなので比較と代入を分けてよい
+            if (v > max_v.load(std::memory_order_relaxed))
+                max_v.store(v, std::memory_order_relaxed);
+        }
+
+        std::vector<std::unique_ptr<Task>> _tasks;
+        std::vector<Worker> _workers;
+        std::atomic<bool> _running{false};
+        bool _realtime = false;
+        bool _realtime_ok = false;
+        int _base_priority = 50;
+        std::chrono::nanoseconds _spin{0};
+
+        // stop()でワーカーの待機を起こすため，start()でワーカーの属性の設定を待つため
+        std::mutex _mtx;
+        std::condition_variable _cv;
+        std::size_t _starting = 0; // 属性の設定が終わっていないワーカーの数（_mtxで保護）
+    };
+
+    template <typename T>
+    template <typename F>
+    int Scheduler<T>::addTask(T period, F &&func, int worker, T deadline)
+    {
+        if (isRunning() || !(period > 0) || worker >= static_cast<int>(_workers.size()))
+            return -1;
+
+        std::size_t w = static_cast<std::size_t>(worker);
+        if (worker < 0)
+        {
+            // 周波数の和が最小のワーカー
+            T best = 0;
+            for (std::size_t i = 0; i < _workers.size(); i++)
+            {
+                T load = 0;
+                for (const Task *t : _workers[i].tasks)
+                    load += T(1e9) / static_cast<T>(t->period);
+                if (i == 0 || load < best)
+                {
+                    best = load;
+                    w = i;
+                }
+            }
+        }
+
+        std::unique_ptr<Task> task(new Task());
+        task->func = std::forward<F>(func);
+        task->period = toNs(period);
+        task->deadline = deadline > 0 ? toNs(deadline) : task->period;
+        task->worker = w;
+        task->first = true;
+
+        // レートモノトニック順（周期が同じ場合は登録順）に挿入
+        std::vector<Task *> &tasks = _workers[w].tasks;
+        auto pos = std::upper_bound(tasks.begin(), tasks.end(), task.get(),
+                                    [](const Task *a, const Task *b) { return a->period < b->period; });
+        tasks.insert(pos, task.get());
+
+        _tasks.push_back(std::move(task));
+        return static_cast<int>(_tasks.size() - 1);
+    }
+
+    template <typename T>
+    bool Scheduler<T>::start()
+    {
+        if (isRunning())
+            return false;
+
+        const clock_type::time_point now = clock_type::now();
+        for (auto &task : _tasks)
+        {
+            task->release = now;
+            task->first = true;
+        }
+
+        // 最短周期の短いワーカーほど高い優先度
+        std::vector<std::size_t> order(_workers.size());
+        for (std::size_t i = 0; i < order.size(); i++)
+            order[i] = i;
+        auto shortest = [this](std::size_t w) {
+            return _workers[w].tasks.empty() ? std::numeric_limits<std::int64_t>::max() : _workers[w].tasks.front()->period;
+        };
+        std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return shortest(a) < shortest(b); });
+
+        _running.store(true, std::memory_order_release);
+        std::unique_lock<std::mutex> lock(_mtx);
+        _realtime_ok = _realtime;
+        _starting = order.size();
+        for (std::size_t rank = 0; rank < order.size(); rank++)
+        {
+            const int priority = _base_priority + static_cast<int>(order.size() - 1 - rank);
+            _workers[order[rank]].thread = std::thread(&Scheduler::run, this, order[rank], priority);
+        }
+        // isRealTime()の結果を確定させるため，全てのワーカーが自分の属性を設定し終えるまで待つ
+        _cv.wait(lock, [this] { return _starting == 0; });
+        return true;
+    }
+
+    template <typename T>
+    void Scheduler<T>::stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mtx);
+            if (!_running.load(std::memory_order_acquire))
+                return;
+            _running.store(false, std::memory_order_release);
+        }
+        _cv.notify_all();
+        for (Worker &worker : _workers)
+            if (worker.thread.joinable())
+                worker.thread.join();
+    }
+
+    template <typename T>
+    bool Scheduler<T>::applyThreadAttributes(const Worker &worker, int priority)
+    {
+        bool ok = true;
+#if defined(__linux__)
+        pthread_t handle = pthread_self();
+        if (worker.cpu >= 0)
+        {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(worker.cpu, &set);
+            ok = (pthread_setaffinity_np(handle, sizeof(set), &set) == 0) && ok;
+        }
+        if (_realtime)
+        {
+            sched_param sp;
+            sp.sched_priority = priority;
+            ok = (pthread_setschedparam(handle, SCHED_FIFO, &sp) == 0) && ok;
+        }
+#else
+        (void)worker;
+        (void)priority;
+        ok = !_realtime;
+#endif
+        return ok;
+    }
+
+    template <typename T>
+    void Scheduler<T>::run(std::size_t worker_idx, int priority)
+    {
+        // タスクを実行する前にこのスレッド自身のCPUと優先度を設定する
+        // （生成した側から設定すると，設定前に固定されていない通常優先度のまま実行し得る）
+        const bool attr_ok = applyThreadAttributes(_workers[worker_idx], priority);
+        {
+            std::lock_guard<std::mutex> lock(_mtx);
+            if (!attr_ok)
+                _realtime_ok = false;
+            _starting--;
+        }
+        _cv.notify_all();
+
+        const std::vector<Task *> &tasks = _workers[worker_idx].tasks;
+        if (tasks.empty())
+            return;
+
+        while (isRunning())
+        {
+            // 実行できるタスクのうち最も周期の短いものを1つ実行し，先頭から探し直す
+            clock_type::time_point now = clock_type::now();
+            bool executed = true;
+            while (executed && isRunning())
+            {
+                executed = false;
+                for (Task *task : tasks)
+                {
+                    if (task->release <= now)
+                    {
+                        execute(*task, now);
+                        now = clock_type::now();
+                        executed = true;
+                        break;
+                    }
+                }
+            }
+
+            clock_type::time_point next = tasks.front()->release;
+            for (const Task *task : tasks)
+                next = std::min(next, task->release);
+
+            {
+                std::unique_lock<std::mutex> lock(_mtx);
+                _cv.wait_until(lock, next - _spin, [this] { return !isRunning(); });
+            }
+            while (_spin.count() > 0 && isRunning() && clock_type::now() < next)
+            {
+            }
+        }
+    }
+
+    template <typename T>
+    void Scheduler<T>::execute(Task &task, clock_type::time_point now)
+    {
+        const std::int64_t jitter = std::chrono::duration_cast<std::chrono::nanoseconds>(now - task.release).count();
+        const T dt = task.first ? toSec(task.period) : toSec(std::chrono::duration_cast<std::chrono::nanoseconds>(now - task.last_start).count());
+        task.first = false;
+        task.last_start = now;
+
+        task.func(dt);
+
+        const clock_type::time_point end = clock_type::now();
+        const std::int64_t exec = std::chrono::duration_cast<std::chrono::nanoseconds>(end - now).count();
+        if (end > task.release + std::chrono::nanoseconds(task.deadline))
+            task.misses.fetch_add(1, std::memory_order_relaxed);
+
+        // 次の予定時刻．終了時点で丸ごと過ぎている周期は飛ばす
+        task.release += std::chrono::nanoseconds(task.period);
+        if (task.release + std::chrono::nanoseconds(task.period) <= end)
+        {
+            const std::int64_t skip = std::chrono::duration_cast<std::chrono::nanoseconds>(end - task.release).count() / task.period;
+            task.release += std::chrono::nanoseconds(skip * task.period);
+            task.skipped.fetch_add(static_cast<std::uint64_t>(skip), std::memory_order_relaxed);
+        }
+
+        task.jitter_sum.fetch_add(jitter, std::memory_order_relaxed);
+        updateMax(task.jitter_max, jitter);
+        task.exec_sum.fetch_add(exec, std::memory_order_relaxed);
+        updateMax(task.exec_max, exec);
+        task.count.fetch_add(1, std::memory_order_release);
+    }
+
+    template <typename T>
+    typename Scheduler<T>::stats_t Scheduler<T>::getStats(int id) const
+    {
+        stats_t s = stats_t();
+        if (id < 0 || id >= static_cast<int>(_tasks.size()))
+            return s;
+        const Task &task = *_tasks[id];
+        s.count = task.count.load(std::memory_order_acquire);
+        s.misses = task.misses.load(std::memory_order_relaxed);
+        s.skipped = task.skipped.load(std::memory_order_relaxed);
+        const T n = s.count > 0 ? static_cast<T>(s.count) : T(1);
+        s.jitter_mean = toSec(task.jitter_sum.load(std::memory_order_relaxed)) / n;
+        s.jitter_max = toSec(task.jitter_max.load(std::memory_order_relaxed));
+        s.exec_mean = toSec(task.exec_sum.load(std::memory_order_relaxed)) / n;
+        s.exec_max = toSec(task.exec_max.load(std::memory_order_relaxed));
+        return s;
+    }
+
+    template <typename T>
+    void Scheduler<T>::resetStats()
+    {
+        for (auto &task : _tasks)
+        {
+            task->count.store(0, std::memory_order_relaxed);
+            task->misses.store(0, std::memory_order_relaxed);
+            task->skipped.store(0, std::memory_order_relaxed);
+            task->jitter_sum.store(0, std::memory_order_relaxed);
+            task->jitter_max.store(0, std::memory_order_relaxed);
+            task->exec_sum.store(0, std::memory_order_relaxed);
+            task->exec_max.store(0, std::memory_order_relaxed);
+        }
+    }
+} // namespace myStd
+
+#endif // Scheduler_h
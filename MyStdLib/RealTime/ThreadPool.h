@@ -0,0 +1,272 @@
+/**
+ * @file ThreadPool.h
+ * @brief 範囲を分割して並列に処理するワークスティーリングのスレッドプール
+**/
+#ifndef ThreadPool_h
+#define ThreadPool_h
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "./../MyStdFunctions.h"
+#include "./../AlignedAllocator.h"
+
+namespace myStd
+{
+    /**
+     * @brief 範囲を分割して並列に処理するワークスティーリングのスレッドプール
+     * @details parallelFor()は[begin, end)をスレッド数で等分して各スレッドに割り当て，
+     *          各スレッドは自分の範囲の先頭からgrain個ずつ処理する．
+     *          自分の範囲を処理し終えたスレッドは，残りが最も多いスレッドの範囲の後ろ半分を奪って続ける．
+     *          範囲は(先頭, 末尾)を1語にまとめたstd::atomicで持ち，取り出しと奪取はCASで行う（ロック無し）．
+     *          呼び出したスレッドも処理に加わるため，スレッド数1の場合は呼び出したスレッドだけで逐次処理する．
+     * @attention parallelFor()を同時に複数のスレッドから呼ばないこと．要素数は2^32未満
+    **/
+    class ThreadPool
+    {
+    public:
+        /**
+         * @brief コンストラクタ
+         * @param num_threads: 呼び出したスレッドを含むスレッド数（0の場合はハードウェアのスレッド数）
+         */
+        explicit ThreadPool(std::size_t num_threads = 0)
+        {
+            if (num_threads == 0)
+                num_threads = std::max(1u, std::thread::hardware_concurrency());
+            _ranges = range_vector_t(num_threads);
+            for (std::size_t i = 1; i < num_threads; i++)
+                _threads.emplace_back(&ThreadPool::workerLoop, this, i);
+        }
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        ~ThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mtx);
+                _quit = true;
+            }
+            _cv.notify_all();
+            for (std::thread &t : _threads)
+                t.join();
+        }
+
+        /**
+         * @brief 呼び出したスレッドを含むスレッド数
+         */
+        inline std::size_t size() const { return _ranges.size(); }
+
+        /**
+         * @brief [begin, end)を並列に処理する（全て終わるまで戻らない）
+         * @param begin: 先頭
+         * @param end: 末尾の次
+         * @param grain: 一度に取り出す要素数（1以上）
+         * @param func: func(first, last)で[first, last)を処理する関数（異なる範囲に対して同時に呼ばれる）
+         */
+        template <typename F>
+        void parallelFor(std::size_t begin, std::size_t end, std::size_t grain, F &&func)
+        {
+            run(begin, end, grain, &invoke<typename std::remove_reference<F>::type>, &func);
+        }
+
+        /**
+         * @brief [begin, end)を並列に処理する（処理するスレッドの番号付き）
+         * @details スレッドごとに確保した作業領域を使い回す場合に使う
+         * @param begin: 先頭
+         * @param end: 末尾の次
+         * @param grain: 一度に取り出す要素数（1以上）
+         * @param func: func(worker, first, last)で[first, last)を処理する関数
+         *              （workerは0以上size()未満のスレッドの番号，同じworkerで同時に呼ばれることはない）
+         */
+        template <typename F>
+        void parallelForWorker(std::size_t begin, std::size_t end, std::size_t grain, F &&func)
+        {
+            run(begin, end, grain, &invokeWorker<typename std::remove_reference<F>::type>, &func);
+        }
+
+    private:
+        // 他のスレッドの範囲と同じキャッシュラインに載らないよう64byteごとに置く
+        struct alignas(64) Range
+        {
+            std::atomic<std::uint64_t> v{0};
+
+            Range() = default;
+            Range(const Range &) {}
+        };
+        // std::allocatorはC++11では64byte境界を保証しないため，境界に揃えて確保する
+        using range_vector_t = std::vector<Range, AlignedAllocator<Range, alignof(Range)>>;
+
+        static std::uint64_t pack(std::size_t first, std::size_t last) { return (std::uint64_t(first) << 32) | std::uint64_t(last); }
+        static std::size_t first(std::uint64_t r) { return static_cast<std::size_t>(r >> 32); }
+        static std::size_t last(std::uint64_t r) { return static_cast<std::size_t>(r & 0xffffffffu); }
+
+        using func_t = void (*)(void *, std::size_t, std::size_t, std::size_t);
+
+        template <typename F>
+        static void invoke(void *ctx, std::size_t, std::size_t first, std::size_t last)
+        {
+            (*static_cast<F *>(ctx))(first, last);
+        }
+
+        template <typename F>
+        static void invokeWorker(void *ctx, std::size_t worker, std::size_t first, std::size_t last)
+        {
+            (*static_cast<F *>(ctx))(worker, first, last);
+        }
+
+        void run(std::size_t begin, std::size_t end, std::size_t grain, func_t func, void *ctx)
+        {
+            if (end <= begin)
+                return;
+            assert(end <= 0xffffffffu && "ThreadPool: range must be below 2^32"); // pack()は32bitずつに詰める
+            grain = std::max<std::size_t>(grain, 1);
+            if (size() == 1 || end - begin <= grain)
+            {
+                func(ctx, 0, begin, end);
+                return;
+            }
+
+            // 等分して各スレッドに割り当てる
+            const std::size_t n = end - begin;
+            const std::size_t num = size();
+            for (std::size_t i = 0; i < num; i++)
+                _ranges[i].v.store(pack(begin + n * i / num, begin + n * (i + 1) / num), std::memory_order_relaxed);
+            _grain = grain;
+            _func = func;
+            _ctx = ctx;
+            _remaining.store(n, std::memory_order_relaxed);
+            _active.store(num - 1, std::memory_order_relaxed);
+
+            {
+                std::lock_guard<std::mutex> lock(_mtx);
+                _generation++;
+            }
+            _cv.notify_all();
+
+            work(0);
+
+            // 全ての要素の処理と，全てのワーカーが範囲を参照し終えるのを待つ
+            while (_remaining.load(std::memory_order_acquire) != 0 || _active.load(std::memory_order_acquire) != 0)
+                std::this_thread::yield();
+        }
+
+        /**
+         * @brief 自分の範囲の先頭からgrain個取り出す
+         */
+        bool pop(std::size_t self, std::size_t &first_out, std::size_t &last_out)
+        {
+            std::atomic<std::uint64_t> &range = _ranges[self].v;
+            std::uint64_t r = range.load(std::memory_order_acquire);
+            while (first(r) < last(r))
+            {
+                const std::size_t f = first(r);
+                const std::size_t l = std::min(last(r), f + _grain);
+                if (range.compare_exchange_weak(r, pack(l, last(r)), std::memory_order_acq_rel))
+                {
+                    first_out = f;
+                    last_out = l;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * @brief 残りが最も多いスレッドの範囲の後ろ半分を自分の範囲にする
+         */
+        bool steal(std::size_t self)
+        {
+            while (true)
+            {
+                std::size_t victim = self;
+                std::size_t best = _grain;
+                std::uint64_t r = 0;
+                for (std::size_t i = 0; i < size(); i++)
+                {
+                    const std::uint64_t v = _ranges[i].v.load(std::memory_order_acquire);
+                    if (i != self && first(v) < last(v) && last(v) - first(v) > best)
+                    {
+                        victim = i;
+                        best = last(v) - first(v);
+                        r = v;
+                    }
+                }
+                if (victim == self)
+                    return false;
+
+                const std::size_t mid = first(r) + (last(r) - first(r)) / 2;
+                if (_ranges[victim].v.compare_exchange_strong(r, pack(first(r), mid), std::memory_order_acq_rel))
+                {
+                    _ranges[self].v.store(pack(mid, last(r)), std::memory_order_release);
+                    return true;
+                }
+            }
+        }
+
+        void work(std::size_t self)
+        {
+            std::size_t f, l;
+            do
+            {
+                while (pop(self, f, l))
+                {
+                    _func(_ctx, self, f, l);
+                    _remaining.fetch_sub(l - f, std::memory_order_acq_rel);
+                }
+            } while (steal(self));
+
+            // 奪えるほど残っていない場合も，他のスレッドの残りの1粒を取り出して処理する
+            for (std::size_t i = 0; i < size(); i++)
+            {
+                while (pop(i, f, l))
+                {
+                    _func(_ctx, self, f, l);
+                    _remaining.fetch_sub(l - f, std::memory_order_acq_rel);
+                }
+            }
+        }
+
+        void workerLoop(std::size_t self)
+        {
+            std::uint64_t seen = 0;
+            while (true)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(_mtx);
+                    _cv.wait(lock, [&] { return _quit || _generation != seen; });
+                    if (_quit)
+                        return;
+                    seen = _generation;
+                }
+                work(self);
+                _active.fetch_sub(1, std::memory_order_acq_rel);
+            }
+        }
+
+        range_vector_t _ranges;
+        std::vector<std::thread> _threads;
+
+        // 実行中の処理
+        func_t _func = nullptr;
+        void *_ctx = nullptr;
+        std::size_t _grain = 1;
+        std::atomic<std::size_t> _remaining{0};
+        std::atomic<std::size_t> _active{0};
+
+        std::mutex _mtx;
+        std::condition_variable _cv;
+        std::uint64_t _generation = 0;
+        bool _quit = false;
+    };
+} // namespace myStd
+
+#endif // ThreadPool_h
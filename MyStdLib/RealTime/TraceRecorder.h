@@ -0,0 +1,387 @@
+/**
+ * @file TraceRecorder.h
+ * @brief トレースリング（Trace.h）の中身をバックグラウンドでファイルに書き出す，ファイルをCSVに変換する
+**/
+#ifndef TraceRecorder_h
+#define TraceRecorder_h
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "./../MyStdFunctions.h"
+#include "./../Instrument.h"
+#include "./../Trace.h"
+
+namespace myStd
+{
+    /**
+     * @brief トレースファイルの形式
+     * @details ファイルの構成（数値は書き出した環境のバイト順．endianが一致しない場合は読み込まない）
+     *          - ヘッダ（header_t，64byte）
+     *          - レコードの並び: 時刻（uint64），記録元の番号（uint32），種類（uint16），リングの番号（uint8），
+     *            値の数n（uint8），値（float）をn個．PIDのレコードは44byte
+     *
+     *          レコードはリングごとに時刻順だが，異なるリングのレコードは時刻順に並ばない．
+    **/
+    struct TraceFile
+    {
+        static constexpr std::uint16_t VERSION = 1; /**< ファイル形式のバージョン */
+        static constexpr std::uint32_t ENDIAN_MARK = 0x01020304;
+        static constexpr std::size_t RECORD_HEADER_SIZE = 16;
+
+        /**
+         * @brief ファイルのヘッダ
+         */
+        struct header_t
+        {
+            char magic[8];              /**< "MSLTRCE"（終端文字を含む） */
+            std::uint32_t endian;       /**< 0x01020304（エンディアンの確認用） */
+            std::uint16_t version;      /**< ファイル形式のバージョン */
+            std::uint16_t reserved0;    /**< 予約 */
+            double ticks_per_second;    /**< 1秒あたりの時刻の増分（instrument::ticksPerSecond()） */
+            std::uint64_t start_ticks;  /**< 記録開始の時刻 */
+            std::uint8_t reserved1[32]; /**< 予約 */
+        };
+        static_assert(sizeof(header_t) == 64, "header_t must be 64 bytes");
+    };
+
+    /**
+     * @brief トレースリングの中身をバックグラウンドでファイルに書き出す
+     * @details 制御ループのスレッドごとにaddRing()でリングを作り，PID::setTrace()などで書き込み先に設定する．
+     *          start()で起動したスレッドが一定周期で全てのリングを読み出してファイルに追記する．
+     *          制御ループ側はリングに書き込むだけで，ロック，メモリ確保，ファイル入出力は行わない．
+     *          書き出しが追いつかずにリングが満杯になった場合，そのレコードは捨てられる（getDropped()）．
+     * @code
+     *          myStd::TraceRecorder rec;
+     *          rec.open("trace.bin");
+     *          myStd::TraceRing *ring = rec.addRing(); // 制御ループのスレッド用
+     *          pid.setTrace(ring, 0);
+     *          ppc.setTrace(ring, 1);
+     *          rec.start();
+     *          // ... 制御ループ ...
+     *          rec.stop();
+     *          myStd::TraceReader::toCSV("trace.bin", "trace.csv");
+     * @endcode
+    **/
+    class TraceRecorder
+    {
+    public:
+        static constexpr std::size_t MAX_RINGS = 256;
+
+        /**
+         * @brief コンストラクタ
+         * @param ring_capacity: 1つのリングの容量（レコード数）
+         */
+        explicit TraceRecorder(std::size_t ring_capacity = 16384) : _ring_capacity(ring_capacity)
+        {
+            _buf.resize(BATCH);
+            _bytes.reserve(BATCH * sizeof(trace_record_t));
+        }
+
+        TraceRecorder(const TraceRecorder &) = delete;
+        TraceRecorder &operator=(const TraceRecorder &) = delete;
+
+        ~TraceRecorder()
+        {
+            stop();
+            close();
+        }
+
+        /**
+         * @brief 書き出すファイルを開く（ヘッダを書き込む）
+         * @param filename: ファイル名
+         * @return 開けたか
+         */
+        bool open(const std::string &filename)
+        {
+            std::lock_guard<std::mutex> lock(_mtx);
+            _ofs.close();
+            _ofs.clear();
+            _ofs.open(filename, std::ios::binary | std::ios::trunc);
+            if (!_ofs)
+                return false;
+            TraceFile::header_t header;
+            std::memset(&header, 0, sizeof(header));
+            std::memcpy(header.magic, "MSLTRCE", 8);
+            header.endian = TraceFile::ENDIAN_MARK;
+            header.version = TraceFile::VERSION;
+            header.ticks_per_second = instrument::ticksPerSecond();
+            header.start_ticks = instrument::readTicks();
+            _ofs.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            return static_cast<bool>(_ofs);
+        }
+
+        /**
+         * @brief ファイルを閉じる（残りのレコードを書き出す）
+         */
+        void close()
+        {
+            drain();
+            std::lock_guard<std::mutex> lock(_mtx);
+            if (_ofs.is_open())
+                _ofs.close();
+        }
+
+        /**
+         * @brief リングの追加（書き込むスレッドごとに1つ）
+         * @return リング（MAX_RINGS個を超える場合はnullptr）．TraceRecorderが破棄されるまで有効
+         */
+        TraceRing *addRing()
+        {
+            std::lock_guard<std::mutex> lock(_mtx);
+            if (_rings.size() >= MAX_RINGS)
+                return nullptr;
+            _rings.emplace_back(new TraceRing(_ring_capacity));
+            return _rings.back().get();
+        }
+
+        /**
+         * @brief 書き出しスレッドの起動
+         * @param period: 書き出しの周期[s]
+         * @return 起動できたか（起動済みの場合はfalse）
+         */
+        bool start(double period = 0.001)
+        {
+            std::lock_guard<std::mutex> lock(_mtx);
+            if (_thread.joinable())
+                return false;
+            _quit = false;
+            _period = std::chrono::nanoseconds(static_cast<std::int64_t>(period * 1e9));
+            _thread = std::thread(&TraceRecorder::run, this);
+            return true;
+        }
+
+        /**
+         * @brief 書き出しスレッドの停止（残りのレコードを書き出してから戻る）
+         */
+        void stop()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mtx);
+                if (!_thread.joinable())
+                    return;
+                _quit = true;
+            }
+            _cv.notify_all();
+            _thread.join();
+            drain();
+        }
+
+        /**
+         * @brief 全てのリングのレコードをファイルに書き出す（書き出しスレッドを使わない場合に呼ぶ）
+         * @return 書き出したレコードの数
+         */
+        std::size_t drain()
+        {
+            std::lock_guard<std::mutex> lock(_mtx);
+            std::size_t total = 0;
+            for (std::size_t r = 0; r < _rings.size(); r++)
+            {
+                std::size_t n;
+                while ((n = _rings[r]->pop(_buf.data(), BATCH)) > 0)
+                {
+                    encode(static_cast<std::uint8_t>(r), n);
+                    total += n;
+                }
+            }
+            _written += total;
+            if (total > 0 && _ofs.is_open())
+                _ofs.flush();
+            return total;
+        }
+
+        /**
+         * @brief 書き出したレコードの数
+         */
+        std::uint64_t getWritten() const
+        {
+            std::lock_guard<std::mutex> lock(_mtx);
+            return _written;
+        }
+
+        /**
+         * @brief リングが満杯で捨てたレコードの数（全てのリングの合計）
+         */
+        std::uint64_t getDropped() const
+        {
+            std::lock_guard<std::mutex> lock(_mtx);
+            std::uint64_t dropped = 0;
+            for (const auto &ring : _rings)
+                dropped += ring->getDropped();
+            return dropped;
+        }
+
+    private:
+        static constexpr std::size_t BATCH = 256;
+
+        void run()
+        {
+            std::unique_lock<std::mutex> lock(_mtx);
+            while (!_quit)
+            {
+                _cv.wait_for(lock, _period, [this] { return _quit; });
+                lock.unlock();
+                drain();
+                lock.lock();
+            }
+        }
+
+        // 値の数だけを書き出す（固定長のレコードの未使用部分は書き出さない）
+        void encode(std::uint8_t ring, std::size_t n)
+        {
+            if (!_ofs.is_open())
+                return;
+            _bytes.clear();
+            for (std::size_t i = 0; i < n; i++)
+            {
+                const trace_record_t &rec = _buf[i];
+                const std::uint8_t num = static_cast<std::uint8_t>(rec.num_values < trace_record_t::MAX_VALUES ? rec.num_values : trace_record_t::MAX_VALUES);
+                char head[TraceFile::RECORD_HEADER_SIZE];
+                std::memcpy(head, &rec.ticks, 8);
+                std::memcpy(head + 8, &rec.source, 4);
+                std::memcpy(head + 12, &rec.kind, 2);
+                head[14] = static_cast<char>(ring);
+                head[15] = static_cast<char>(num);
+                _bytes.insert(_bytes.end(), head, head + sizeof(head));
+                const char *values = reinterpret_cast<const char *>(rec.values);
+                _bytes.insert(_bytes.end(), values, values + num * sizeof(float));
+            }
+            _ofs.write(_bytes.data(), static_cast<std::streamsize>(_bytes.size()));
+        }
+
+        std::size_t _ring_capacity;
+        std::vector<std::unique_ptr<TraceRing>> _rings;
+        std::vector<trace_record_t> _buf; // リングから読み出したレコード
+        std::vector<char> _bytes;         // ファイルに書き出すバイト列
+        std::ofstream _ofs;
+        std::uint64_t _written = 0;
+
+        std::thread _thread;
+        mutable std::mutex _mtx;
+        std::condition_variable _cv;
+        std::chrono::nanoseconds _period{1000000};
+        bool _quit = false;
+    };
+
+    /**
+     * @brief トレースファイルの読み込み
+    **/
+    class TraceReader
+    {
+    public:
+        /**
+         * @brief ファイルを開く
+         * @param filename: ファイル名
+         * @return 開けたか（形式が異なる場合はfalse）
+         */
+        bool open(const std::string &filename)
+        {
+            _ifs.close();
+            _ifs.clear();
+            _ifs.open(filename, std::ios::binary);
+            if (!_ifs)
+                return false;
+            _ifs.read(reinterpret_cast<char *>(&_header), sizeof(_header));
+            return static_cast<bool>(_ifs) && std::memcmp(_header.magic, "MSLTRCE", 8) == 0 &&
+                   _header.endian == TraceFile::ENDIAN_MARK && _header.version == TraceFile::VERSION;
+        }
+
+        /**
+         * @brief 次のレコードの読み込み
+         * @param rec: レコードの出力先
+         * @param ring: リングの番号の出力先
+         * @return 読み込めたか（ファイルの終端または途中で切れている場合はfalse）
+         */
+        bool next(trace_record_t &rec, int &ring)
+        {
+            char head[TraceFile::RECORD_HEADER_SIZE];
+            if (!_ifs.read(head, sizeof(head)))
+                return false;
+            std::memcpy(&rec.ticks, head, 8);
+            std::memcpy(&rec.source, head + 8, 4);
+            std::memcpy(&rec.kind, head + 12, 2);
+            ring = static_cast<std::uint8_t>(head[14]);
+            rec.num_values = static_cast<std::uint8_t>(head[15]);
+            if (rec.num_values > trace_record_t::MAX_VALUES)
+                return false;
+            return static_cast<bool>(_ifs.read(reinterpret_cast<char *>(rec.values), rec.num_values * sizeof(float)));
+        }
+
+        /**
+         * @brief レコードの時刻を記録開始からの経過時間[s]に変換
+         * @param rec: レコード
+         */
+        inline double toSeconds(const trace_record_t &rec) const
+        {
+            const double dt = static_cast<double>(static_cast<std::int64_t>(rec.ticks - _header.start_ticks));
+            return _header.ticks_per_second > 0 ? dt / _header.ticks_per_second : dt;
+        }
+
+        /**
+         * @brief ファイルのヘッダの取得
+         */
+        inline const TraceFile::header_t &getHeader() const { return _header; }
+
+        /**
+         * @brief トレースファイルをCSVに変換
+         * @details 列は time[s], ring, source, kind（pid，pure_pursuit，user）, v0, v1, ...（値の並びはTraceKindを参照）
+         * @param trace_filename: トレースファイル名
+         * @param csv_filename: CSVファイル名
+         * @return 変換したレコードの数（ファイルが開けない場合は-1）
+         */
+        static long long toCSV(const std::string &trace_filename, const std::string &csv_filename)
+        {
+            TraceReader reader;
+            if (!reader.open(trace_filename))
+                return -1;
+            std::ofstream ofs(csv_filename, std::ios::trunc);
+            if (!ofs)
+                return -1;
+            ofs << "time,ring,source,kind";
+            for (int i = 0; i < trace_record_t::MAX_VALUES; i++)
+                ofs << ",v" << i;
+            ofs << '\n';
+            ofs.precision(9);
+
+            long long count = 0;
+            trace_record_t rec;
+            int ring;
+            while (reader.next(rec, ring))
+            {
+                ofs << reader.toSeconds(rec) << ',' << ring << ',' << rec.source << ',' << kindName(rec.kind);
+                for (int i = 0; i < rec.num_values; i++)
+                    ofs << ',' << rec.values[i];
+                ofs << '\n';
+                count++;
+            }
+            return ofs ? count : -1;
+        }
+
+    private:
+        static const char *kindName(std::uint16_t kind)
+        {
+            switch (static_cast<TraceKind>(kind))
+            {
+            case TraceKind::PID:
+                return "pid";
+            case TraceKind::PurePursuit:
+                return "pure_pursuit";
+            default:
+                return "user";
+            }
+        }
+
+        std::ifstream _ifs;
+        TraceFile::header_t _header = TraceFile::header_t();
+    };
+} // namespace myStd
+
+#endif // TraceRecorder_h
@@ -0,0 +1,190 @@
+/**
+ * @file Trace.h
+ * @brief 制御ループの内部状態を記録する固定長のトレースレコードとロック無しのリングバッファ
+ * @details MYSTD_TRACEを定義してからincludeすると，PID，PurePursuitControlにsetTrace()が追加され，
+ *          update()の度に内部状態を1レコードとしてTraceRingに書き込む（setTrace()で設定しなければ書き込まない）．
+ *          定義しない場合はトレースのコード（MYSTD_TRACE_*）とメンバが全て消える．
+ *          リングの中身のファイルへの書き出しとCSVへの変換はRealTime/TraceRecorder.hを使う．
+ * @attention MYSTD_TRACEは全ての翻訳単位で揃えること（クラスの大きさが変わるため）
+**/
+#ifndef Trace_h
+#define Trace_h
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "./MyStdFunctions.h"
+#include "./Instrument.h"
+
+namespace myStd
+{
+    /**
+     * @brief トレースレコードの種類（valuesの並び）
+     */
+    enum class TraceKind : std::uint16_t
+    {
+        User = 0,        /**< 利用者が定義する値 */
+        PID,             /**< target, now_val, diff[0], diff[1], diff[2], integral, output */
+        PurePursuit      /**< now_pose.x, now_pose.y, now_pose.theta, error.x, error.theta, output.x, output.theta */
+    };
+
+    /**
+     * @brief トレースレコード（1キャッシュライン）
+     */
+    struct trace_record_t
+    {
+        static constexpr int MAX_VALUES = 12;
+
+        std::uint64_t ticks;       /**< 時刻（instrument::readTicks()） */
+        std::uint32_t source;      /**< 記録元の番号（setTrace()で指定） */
+        std::uint16_t kind;        /**< 種類（TraceKind） */
+        std::uint16_t num_values;  /**< valuesの有効な要素数 */
+        float values[MAX_VALUES];  /**< 値 */
+    };
+    static_assert(sizeof(trace_record_t) == 64, "trace_record_t must be 64 bytes");
+
+    /**
+     * @brief トレースレコードのリングバッファ（1スレッド書き込み，1スレッド読み出し）
+     * @details 容量はコンストラクタで確保し，以降メモリ確保は行わない．
+     *          書き込みは待ち無しで，満杯の場合はレコードを捨ててgetDropped()に数える（制御ループを止めない）．
+     *          書き込むスレッド（制御ループ）ごとに1つ用意する．
+    **/
+    class TraceRing
+    {
+    public:
+        /**
+         * @brief コンストラクタ
+         * @param capacity: 容量（レコード数，2のべき乗に切り上げる）
+         */
+        explicit TraceRing(std::size_t capacity = 4096)
+        {
+            std::size_t cap = 2;
+            while (cap < capacity)
+                cap <<= 1;
+            _mask = cap - 1;
+            _buf.reset(new trace_record_t[cap]);
+        }
+
+        TraceRing(const TraceRing &) = delete;
+        TraceRing &operator=(const TraceRing &) = delete;
+
+        /**
+         * @brief レコードの書き込み（書き込むスレッドからのみ呼ぶ）
+         * @param record: レコード
+         * @return 書き込めたか（満杯の場合はfalse）
+         */
+        inline bool push(const trace_record_t &record)
+        {
+            trace_record_t *slot = reserve();
+            if (!slot)
+                return false;
+            *slot = record;
+            commit();
+            return true;
+        }
+
+        /**
+         * @brief 値を並べたレコードの書き込み（時刻は現在時刻）
+         * @param source: 記録元の番号
+         * @param kind: 種類
+         * @param values: 値（MAX_VALUES個まで，floatに変換する）
+         * @return 書き込めたか
+         */
+        template <typename... V>
+        inline bool write(std::uint32_t source, TraceKind kind, const V &... values)
+        {
+            static_assert(sizeof...(V) >= 1 && sizeof...(V) <= trace_record_t::MAX_VALUES, "1 to MAX_VALUES trace values");
+            // 一時変数を介さずにリングの要素へ直接書き込む
+            trace_record_t *slot = reserve();
+            if (!slot)
+                return false;
+            slot->ticks = instrument::readTicks();
+            slot->source = source;
+            slot->kind = static_cast<std::uint16_t>(kind);
+            slot->num_values = static_cast<std::uint16_t>(sizeof...(V));
+            const float v[] = {static_cast<float>(values)...};
+            for (std::size_t i = 0; i < sizeof...(V); i++)
+                slot->values[i] = v[i];
+            commit();
+            return true;
+        }
+
+        /**
+         * @brief レコードの読み出し（読み出すスレッドからのみ呼ぶ）
+         * @param out: 出力先
+         * @param num: 読み出す最大数
+         * @return 読み出した数
+         */
+        std::size_t pop(trace_record_t *out, std::size_t num)
+        {
+            const std::uint64_t tail = _tail.load(std::memory_order_relaxed);
+            const std::uint64_t head = _head.load(std::memory_order_acquire);
+            const std::size_t n = static_cast<std::size_t>(min<std::uint64_t>(head - tail, num));
+            for (std::size_t i = 0; i < n; i++)
+                out[i] = _buf[(tail + i) & _mask];
+            _tail.store(tail + n, std::memory_order_release);
+            return n;
+        }
+
+        /**
+         * @brief 容量（レコード数）
+         */
+        inline std::size_t capacity() const { return static_cast<std::size_t>(_mask + 1); }
+
+        /**
+         * @brief 満杯で捨てたレコードの数
+         */
+        inline std::uint64_t getDropped() const { return _dropped.load(std::memory_order_relaxed); }
+
+    private:
+        // 次に書き込む要素（満杯の場合はnullptr）
+        inline trace_record_t *reserve()
+        {
+            const std::uint64_t head = _head.load(std::memory_order_relaxed);
+            if (head - _tail_cache > _mask)
+            {
+                _tail_cache = _tail.load(std::memory_order_acquire);
+                if (head - _tail_cache > _mask)
+                {
+                    _dropped.store(_dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                    return nullptr;
+                }
+            }
+            return &_buf[head & _mask];
+        }
+
+        // reserve()で得た要素を読み出し側に公開する
+        inline void commit() { _head.store(_head.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+        std::unique_ptr<trace_record_t[]> _buf;
+        std::uint64_t _mask;
+
+        // 書き込み側と読み出し側の変数は別のキャッシュラインに置く
+        char _pad0[64];
+        std::atomic<std::uint64_t> _head{0};
+        std::uint64_t _tail_cache = 0; // 最後に読んだ_tail（満杯の判定で毎回_tailを読まないため）
+        std::atomic<std::uint64_t> _dropped{0};
+        char _pad1[64 - 3 * sizeof(std::uint64_t)];
+        std::atomic<std::uint64_t> _tail{0};
+        char _pad2[64 - sizeof(std::uint64_t)];
+    };
+} // namespace myStd
+
+// トレースのフック（MYSTD_TRACEを定義しない場合は何も生成しない）
+#if defined(MYSTD_TRACE)
+#define MYSTD_TRACE_MEMBER(ring, source) \
+    ::myStd::TraceRing *ring = nullptr;  \
+    std::uint32_t source = 0;
+#define MYSTD_TRACE_WRITE(ring, source, kind, ...) \
+    do                                             \
+    {                                              \
+        if (ring)                                  \
+            (ring)->write(source, kind, __VA_ARGS__); \
+    } while (0)
+#else
+#define MYSTD_TRACE_MEMBER(ring, source)
+#define MYSTD_TRACE_WRITE(ring, source, kind, ...) ((void)0)
+#endif
+
+#endif // Trace_h
@@ -9,6 +9,7 @@
 #include <cmath>
 #include <string>
 #include "./../MyStdFunctions.h"
+#include "./../FastMath.h"
 #include "Vector2.h"
 
 namespace myStd
@@ -88,8 +89,10 @@ namespace myStd
          */
         void setByPolar(T r, T angle, T robot_theta)
         {
-            x = r * std::cos(angle);
-            y = r * std::sin(angle);
+            T s, c;
+            trigSinCos(angle, s, c);
+            x = r * c;
+            y = r * s;
             theta = robot_theta;
         }
 
@@ -99,8 +102,11 @@ namespace myStd
          */
         void rotate(T angle)
         {
-            x = x * cos(angle) - y * sin(angle);
-            y = x * sin(angle) + y * cos(angle);
+            T s, c;
+            trigSinCos(angle, s, c);
+            const T rx = x * c - y * s;
+            y = x * s + y * c;
+            x = rx;
         }
 
         /**
@@ -136,7 +142,8 @@ namespace myStd
          */
         std::string toString()
         {
-            return '(' + std::to_string(x) + ", " + std::to_string(y) + ')';
+            using std::to_string;
+            return '(' + to_string(x) + ", " + to_string(y) + ')';
         }
 
         /**
@@ -154,7 +161,8 @@ namespace myStd
          */
         T magnitude() const
         {
-            return std::sqrt(sqrMagnitude());
+            using std::sqrt; // Fixedなどのsqrt()は実引数依存の名前探索で見つける
+            return sqrt(sqrMagnitude());
         }
 
         /**
@@ -194,7 +202,7 @@ namespace myStd
          */
         static T getAngle(Pose2D a, Pose2D b)
         {
-            return std::atan2(b.y - a.y, b.x - a.x);
+            return trigAtan2(b.y - a.y, b.x - a.x);
         }
 
         /**
@@ -218,7 +226,7 @@ namespace myStd
          */
         static Pose2D leap(Pose2D a, Pose2D b, T t)
         {
-            t = guard(t, 0.0, 1.0);
+            t = guard<T>(t, 0, 1);
             Pose2D v = a;
             v.x += (b.x - a.x) * t;
             v.y += (b.y - a.y) * t;
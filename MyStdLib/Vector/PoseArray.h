@@ -0,0 +1,460 @@
+/**
+ * @file PoseArray.h
+ * @brief x, y, thetaを別々の配列で保持する座標の配列（SoA）
+**/
+#ifndef PoseArray_h
+#define PoseArray_h
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#include "./../MyStdFunctions.h"
+#include "./../AlignedAllocator.h"
+#include "./../FastMath.h"
+#include "Vector2.h"
+#include "Pose2D.h"
+
+namespace myStd
+{
+    /**
+     * @brief x, y, thetaを別々の配列で保持する座標の配列（SoA）
+     * @details std::vector<Pose2D<T>>と異なり，距離や角度の一括計算で不要なthetaを読まない．
+     *          各配列はSIMD境界（64byte）に揃えて確保し，一括計算のループは自動ベクトル化される
+     *          （距離はsqrtを含むため-fno-math-errno，角度はMYSTD_FAST_MATHの定義が必要）．
+     *          operator[]と反復子はPose2D<T>を値で返すため，Pose2D<T>の並びとして読むコードでそのまま使える
+     *          （ArcLengthTable::extend()など，path[i]で点を取得するテンプレートにも渡せる）．
+     * @tparam T: 数値型
+    **/
+    template <typename T>
+    class PoseArray
+    {
+    public:
+        using storage_t = std::vector<T, AlignedAllocator<T>>;
+
+        /**
+         * @brief Pose2D<T>を値で返す読み取り専用の反復子
+         */
+        class const_iterator
+        {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = Pose2D<T>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = Pose2D<T>;
+
+            const_iterator() = default;
+            const_iterator(const PoseArray *array, std::size_t idx) : _array(array), _idx(idx) {}
+
+            Pose2D<T> operator*() const { return (*_array)[_idx]; }
+            Pose2D<T> operator[](difference_type n) const { return (*_array)[_idx + n]; }
+            const_iterator &operator++()
+            {
+                _idx++;
+                return *this;
+            }
+            const_iterator operator++(int)
+            {
+                const_iterator r = *this;
+                _idx++;
+                return r;
+            }
+            const_iterator &operator--()
+            {
+                _idx--;
+                return *this;
+            }
+            const_iterator operator--(int)
+            {
+                const_iterator r = *this;
+                _idx--;
+                return r;
+            }
+            const_iterator &operator+=(difference_type n)
+            {
+                _idx += n;
+                return *this;
+            }
+            const_iterator &operator-=(difference_type n)
+            {
+                _idx -= n;
+                return *this;
+            }
+            const_iterator operator+(difference_type n) const { return const_iterator(_array, _idx + n); }
+            const_iterator operator-(difference_type n) const { return const_iterator(_array, _idx - n); }
+            difference_type operator-(const const_iterator &r) const { return static_cast<difference_type>(_idx) - static_cast<difference_type>(r._idx); }
+            bool operator==(const const_iterator &r) const { return _idx == r._idx; }
+            bool operator!=(const const_iterator &r) const { return _idx != r._idx; }
+            bool operator<(const const_iterator &r) const { return _idx < r._idx; }
+            bool operator>(const const_iterator &r) const { return _idx > r._idx; }
+            bool operator<=(const const_iterator &r) const { return _idx <= r._idx; }
+            bool operator>=(const const_iterator &r) const { return _idx >= r._idx; }
+
+        private:
+            const PoseArray *_array = nullptr;
+            std::size_t _idx = 0;
+        };
+
+        /**
+         * @brief コンストラクタ
+         */
+        PoseArray() = default;
+
+        /**
+         * @brief コンストラクタ 要素数を指定（要素は0で初期化）
+         * @param num: 要素数
+         */
+        explicit PoseArray(std::size_t num) { resize(num); }
+
+        /**
+         * @brief コンストラクタ 座標の配列から変換
+         * @param path: 座標の配列
+         */
+        explicit PoseArray(const std::vector<Pose2D<T>> &path) { assign(path.data(), path.size()); }
+
+        /**
+         * @brief 座標の配列から設定
+         * @param path: 座標の配列の先頭ポインタ
+         * @param num: 要素数
+         */
+        void assign(const Pose2D<T> *path, std::size_t num);
+
+        /**
+         * @brief 要素数の変更（増えた要素は0で初期化）
+         * @param num: 要素数
+         */
+        void resize(std::size_t num)
+        {
+            _x.resize(num);
+            _y.resize(num);
+            _theta.resize(num);
+        }
+
+        /**
+         * @brief 容量の確保
+         * @param num: 要素数
+         */
+        void reserve(std::size_t num)
+        {
+            _x.reserve(num);
+            _y.reserve(num);
+            _theta.reserve(num);
+        }
+
+        /**
+         * @brief 全要素の破棄
+         */
+        void clear()
+        {
+            _x.clear();
+            _y.clear();
+            _theta.clear();
+        }
+
+        /**
+         * @brief 末尾に座標を追加
+         * @param pose: 座標
+         */
+        void push_back(const Pose2D<T> &pose)
+        {
+            _x.push_back(pose.x);
+            _y.push_back(pose.y);
+            _theta.push_back(pose.theta);
+        }
+
+        /**
+         * @brief 要素数の取得
+         */
+        std::size_t size() const { return _x.size(); }
+
+        /**
+         * @brief 空かどうか
+         */
+        bool empty() const { return _x.empty(); }
+
+        /**
+         * @brief 座標の取得
+         * @param i: インデックス
+         */
+        Pose2D<T> operator[](std::size_t i) const { return Pose2D<T>(_x[i], _y[i], _theta[i]); }
+
+        /**
+         * @brief 座標の設定
+         * @param i: インデックス
+         * @param pose: 座標
+         */
+        void set(std::size_t i, const Pose2D<T> &pose)
+        {
+            _x[i] = pose.x;
+            _y[i] = pose.y;
+            _theta[i] = pose.theta;
+        }
+
+        /**
+         * @brief x成分の配列の取得
+         */
+        T *dataX() { return _x.data(); }
+        const T *dataX() const { return _x.data(); }
+
+        /**
+         * @brief y成分の配列の取得
+         */
+        T *dataY() { return _y.data(); }
+        const T *dataY() const { return _y.data(); }
+
+        /**
+         * @brief 角度成分の配列の取得
+         */
+        T *dataTheta() { return _theta.data(); }
+        const T *dataTheta() const { return _theta.data(); }
+
+        const_iterator begin() const { return const_iterator(this, 0); }
+        const_iterator end() const { return const_iterator(this, size()); }
+
+        /**
+         * @brief std::vector<Pose2D<T>>に変換
+         */
+        std::vector<Pose2D<T>> toVector() const { return std::vector<Pose2D<T>>(begin(), end()); }
+
+        /**
+         * @brief 点pから各要素までの距離を一括計算
+         * @param p: 点
+         * @param out: 出力先（size()個）
+         */
+        void getDistance(const Vector2<T> &p, T *out) const;
+
+        /**
+         * @brief 点pから各要素への角度を一括計算（Pose2D::getAngle(p, (*this)[i])と同じ）
+         * @param p: 点
+         * @param out: 出力先[rad]（size()個）
+         */
+        void getAngle(const Vector2<T> &p, T *out) const;
+
+        /**
+         * @brief ベクトルpと各要素の(x, y)の内積を一括計算
+         * @param p: ベクトル
+         * @param out: 出力先（size()個）
+         */
+        void getDot(const Vector2<T> &p, T *out) const;
+
+        /**
+         * @brief 要素同士の距離を一括計算
+         * @param a: 1つ目の配列
+         * @param b: 2つ目の配列（aと同じ要素数）
+         * @param out: 出力先（a.size()個）
+         */
+        static void getDistance(const PoseArray &a, const PoseArray &b, T *out);
+
+        /**
+         * @brief 要素同士の角度を一括計算（Pose2D::getAngle(a[i], b[i])と同じ）
+         * @param a: 1つ目の配列
+         * @param b: 2つ目の配列（aと同じ要素数）
+         * @param out: 出力先[rad]（a.size()個）
+         */
+        static void getAngle(const PoseArray &a, const PoseArray &b, T *out);
+
+        /**
+         * @brief 要素同士の内積を一括計算
+         * @param a: 1つ目の配列
+         * @param b: 2つ目の配列（aと同じ要素数）
+         * @param out: 出力先（a.size()個）
+         */
+        static void getDot(const PoseArray &a, const PoseArray &b, T *out);
+
+        /**
+         * @brief 要素同士をtで線形補間（Pose2D::leap(a[i], b[i], t)と同じ）
+         * @param a: 1つ目の配列
+         * @param b: 2つ目の配列（aと同じ要素数）
+         * @param t: 媒介変数
+         * @param out: 出力先（a，bと同じでもよい．要素数はa.size()に合わせる）
+         */
+        static void leap(const PoseArray &a, const PoseArray &b, T t, PoseArray &out);
+
+        /**
+         * @brief 点pに最も近い要素のインデックスを返す
+         * @param p: 点
+         * @return インデックス（同じ距離の場合は小さい方，空の場合は-1）
+         */
+        int nearest(const Vector2<T> &p) const;
+
+    private:
+        static void leapArray(const T *a, const T *b, T *out, std::size_t n, T t);
+        static T minOf(const T *__restrict d, std::size_t n, std::true_type);
+        static T minOf(const T *__restrict d, std::size_t n, std::false_type);
+
+        storage_t _x, _y, _theta;
+    };
+
+    template <typename T>
+    inline void PoseArray<T>::assign(const Pose2D<T> *path, std::size_t num)
+    {
+        resize(num);
+        for (std::size_t i = 0; i < num; i++)
+        {
+            _x[i] = path[i].x;
+            _y[i] = path[i].y;
+            _theta[i] = path[i].theta;
+        }
+    }
+
+    template <typename T>
+    inline void PoseArray<T>::getDistance(const Vector2<T> &p, T *out) const
+    {
+        const T *__restrict x = _x.data();
+        const T *__restrict y = _y.data();
+        T *__restrict o = out;
+        const std::size_t n = size();
+        for (std::size_t i = 0; i < n; i++)
+            o[i] = std::sqrt((x[i] - p.x) * (x[i] - p.x) + (y[i] - p.y) * (y[i] - p.y));
+    }
+
+    template <typename T>
+    inline void PoseArray<T>::getAngle(const Vector2<T> &p, T *out) const
+    {
+        const T *__restrict x = _x.data();
+        const T *__restrict y = _y.data();
+        T *__restrict o = out;
+        const std::size_t n = size();
+        for (std::size_t i = 0; i < n; i++)
+            o[i] = trigAtan2(y[i] - p.y, x[i] - p.x);
+    }
+
+    template <typename T>
+    inline void PoseArray<T>::getDot(const Vector2<T> &p, T *out) const
+    {
+        const T *__restrict x = _x.data();
+        const T *__restrict y = _y.data();
+        T *__restrict o = out;
+        const std::size_t n = size();
+        for (std::size_t i = 0; i < n; i++)
+            o[i] = x[i] * p.x + y[i] * p.y;
+    }
+
+    template <typename T>
+    inline void PoseArray<T>::getDistance(const PoseArray &a, const PoseArray &b, T *out)
+    {
+        const T *__restrict ax = a._x.data();
+        const T *__restrict ay = a._y.data();
+        const T *__restrict bx = b._x.data();
+        const T *__restrict by = b._y.data();
+        T *__restrict o = out;
+        const std::size_t n = a.size();
+        for (std::size_t i = 0; i < n; i++)
+            o[i] = std::sqrt((bx[i] - ax[i]) * (bx[i] - ax[i]) + (by[i] - ay[i]) * (by[i] - ay[i]));
+    }
+
+    template <typename T>
+    inline void PoseArray<T>::getAngle(const PoseArray &a, const PoseArray &b, T *out)
+    {
+        const T *__restrict ax = a._x.data();
+        const T *__restrict ay = a._y.data();
+        const T *__restrict bx = b._x.data();
+        const T *__restrict by = b._y.data();
+        T *__restrict o = out;
+        const std::size_t n = a.size();
+        for (std::size_t i = 0; i < n; i++)
+            o[i] = trigAtan2(by[i] - ay[i], bx[i] - ax[i]);
+    }
+
+    template <typename T>
+    inline void PoseArray<T>::getDot(const PoseArray &a, const PoseArray &b, T *out)
+    {
+        const T *__restrict ax = a._x.data();
+        const T *__restrict ay = a._y.data();
+        const T *__restrict bx = b._x.data();
+        const T *__restrict by = b._y.data();
+        T *__restrict o = out;
+        const std::size_t n = a.size();
+        for (std::size_t i = 0; i < n; i++)
+            o[i] = ax[i] * bx[i] + ay[i] * by[i];
+    }
+
+    template <typename T>
+    inline void PoseArray<T>::leap(const PoseArray &a, const PoseArray &b, T t, PoseArray &out)
+    {
+        t = guard<T>(t, 0, 1);
+        const std::size_t n = a.size();
+        out.resize(n);
+        // 成分ごとにループを分けて，ベクトル化のための重なりの確認を少なくする
+        leapArray(a._x.data(), b._x.data(), out._x.data(), n, t);
+        leapArray(a._y.data(), b._y.data(), out._y.data(), n, t);
+        leapArray(a._theta.data(), b._theta.data(), out._theta.data(), n, t);
+    }
+
+    template <typename T>
+    inline void PoseArray<T>::leapArray(const T *a, const T *b, T *out, std::size_t n, T t)
+    {
+        // outはa，bと同じ配列でもよいので__restrictは付けない
+        for (std::size_t i = 0; i < n; i++)
+            out[i] = a[i] + (b[i] - a[i]) * t;
+    }
+
+    template <typename T>
+    inline T PoseArray<T>::minOf(const T *__restrict d, std::size_t n, std::true_type)
+    {
+        // 0以上の浮動小数点数はビット列を整数として比較しても大小が同じになる．
+        // 浮動小数点数の最小値の畳み込みは-ffast-mathなしではベクトル化されないので，整数で比較する
+        typedef typename std::conditional<sizeof(T) == 4, std::uint32_t, std::uint64_t>::type bits_t;
+        bits_t m = ~bits_t(0);
+        for (std::size_t i = 0; i < n; i++)
+        {
+            bits_t b;
+            std::memcpy(&b, d + i, sizeof(b));
+            m = b < m ? b : m;
+        }
+        T r;
+        std::memcpy(&r, &m, sizeof(r));
+        return (m == ~bits_t(0)) ? std::numeric_limits<T>::infinity() : r;
+    }
+
+    template <typename T>
+    inline T PoseArray<T>::minOf(const T *__restrict d, std::size_t n, std::false_type)
+    {
+        T m = std::numeric_limits<T>::max();
+        for (std::size_t i = 0; i < n; i++)
+            m = d[i] < m ? d[i] : m;
+        return m;
+    }
+
+    template <typename T>
+    inline int PoseArray<T>::nearest(const Vector2<T> &p) const
+    {
+        const std::size_t n = size();
+        if (n == 0)
+            return -1;
+
+        // ブロックごとに距離の2乗の計算，最小値の計算，最小値の位置の検索に分け，前の2つをベクトル化する
+        constexpr std::size_t BLOCK = 256;
+        typedef std::integral_constant<bool, std::is_floating_point<T>::value && (sizeof(T) == 4 || sizeof(T) == 8)> use_bits_t;
+        T d[BLOCK];
+        T best = std::numeric_limits<T>::infinity();
+        std::size_t best_idx = 0;
+        for (std::size_t start = 0; start < n; start += BLOCK)
+        {
+            const std::size_t m = min(BLOCK, n - start);
+            const T *__restrict x = _x.data() + start;
+            const T *__restrict y = _y.data() + start;
+            for (std::size_t i = 0; i < m; i++)
+                d[i] = (x[i] - p.x) * (x[i] - p.x) + (y[i] - p.y) * (y[i] - p.y);
+
+            // 同じ距離の場合は小さいインデックスを優先する
+            const T block_min = minOf(d, m, use_bits_t());
+            if (block_min < best)
+            {
+                std::size_t j = 0;
+                while (d[j] != block_min)
+                    j++;
+                best = block_min;
+                best_idx = start + j;
+            }
+        }
+        return static_cast<int>(best_idx);
+    }
+
+} // namespace myStd
+#endif // PoseArray_h
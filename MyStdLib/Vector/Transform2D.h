@@ -0,0 +1,400 @@
+/**
+ * @file Transform2D.h
+ * @brief 2次元の剛体変換（SE(2)）
+**/
+#ifndef Transform2D_h
+#define Transform2D_h
+
+#include <iostream>
+#include <cmath>
+#include <cstddef>
+#include "./../MyStdFunctions.h"
+#include "./../FastMath.h"
+#include "Vector2.h"
+#include "Pose2D.h"
+
+namespace myStd
+{
+    /**
+     * @brief 2次元の剛体変換（SE(2)）
+     * @details 回転のcos，sinを保持するため，生成時以外は三角関数を計算しない．
+     *          合成，逆変換，点の変換は乗算と加算のみで行う．
+     *          角度は合成した値をそのまま足し合わせて保持する（-pi～piに正規化しない）．
+     * @tparam T: 数値型
+    **/
+    template <typename T>
+    class Transform2D
+    {
+    public:
+        /**
+         * @brief コンストラクタ（恒等変換）
+         */
+        Transform2D() = default;
+
+        /**
+         * @brief コンストラクタ 並進(_x, _y)と回転角で初期化
+         * @param _x: 並進のx成分
+         * @param _y: 並進のy成分
+         * @param angle: 回転角[rad]
+         */
+        Transform2D(T _x, T _y, T angle) { set(_x, _y, angle); }
+
+        /**
+         * @brief コンストラクタ 並進ベクトルと回転角で初期化
+         * @param t: 並進ベクトル
+         * @param angle: 回転角[rad]
+         */
+        Transform2D(const Vector2<T> &t, T angle) { set(t.x, t.y, angle); }
+
+        /**
+         * @brief コンストラクタ 座標で初期化（座標系の原点をposeに移す変換）
+         * @param pose: 座標
+         */
+        explicit Transform2D(const Pose2D<T> &pose) { set(pose.x, pose.y, pose.theta); }
+
+        /**
+         * @brief 変換の設定
+         * @param _x: 並進のx成分
+         * @param _y: 並進のy成分
+         * @param angle: 回転角[rad]
+         */
+        void set(T _x, T _y, T angle)
+        {
+            _tx = _x;
+            _ty = _y;
+            setAngle(angle);
+        }
+
+        /**
+         * @brief 回転角の設定（cos，sinを計算し直す）
+         * @param angle: 回転角[rad]
+         */
+        void setAngle(T angle)
+        {
+            _theta = angle;
+            trigSinCos(angle, _sin, _cos);
+        }
+
+        /**
+         * @brief 並進の設定
+         * @param t: 並進ベクトル
+         */
+        void setTranslation(const Vector2<T> &t)
+        {
+            _tx = t.x;
+            _ty = t.y;
+        }
+
+        /**
+         * @brief 並進ベクトルの取得
+         */
+        Vector2<T> getTranslation() const { return Vector2<T>(_tx, _ty); }
+
+        /**
+         * @brief 回転角[rad]の取得
+         */
+        T getAngle() const { return _theta; }
+
+        /**
+         * @brief 回転角のcosの取得
+         */
+        T getCos() const { return _cos; }
+
+        /**
+         * @brief 回転角のsinの取得
+         */
+        T getSin() const { return _sin; }
+
+        /**
+         * @brief 座標に変換
+         * @return 並進をx, y，回転角をthetaとする座標
+         */
+        Pose2D<T> toPose() const { return Pose2D<T>(_tx, _ty, _theta); }
+
+        /**
+         * @brief 逆変換を返す
+         */
+        Transform2D inverse() const
+        {
+            Transform2D r;
+            r._cos = _cos;
+            r._sin = -_sin;
+            r._theta = -_theta;
+            r._tx = -(_cos * _tx + _sin * _ty);
+            r._ty = _sin * _tx - _cos * _ty;
+            return r;
+        }
+
+        /**
+         * @brief 点を変換（回転してから並進）
+         * @param p: 点
+         */
+        Vector2<T> apply(const Vector2<T> &p) const
+        {
+            return Vector2<T>(_cos * p.x - _sin * p.y + _tx, _sin * p.x + _cos * p.y + _ty);
+        }
+
+        /**
+         * @brief 点を逆変換（inverse().apply(p)と同じ）
+         * @param p: 点
+         */
+        Vector2<T> applyInverse(const Vector2<T> &p) const
+        {
+            const T dx = p.x - _tx, dy = p.y - _ty;
+            return Vector2<T>(_cos * dx + _sin * dy, -_sin * dx + _cos * dy);
+        }
+
+        /**
+         * @brief 座標を変換（位置を変換し，向きに回転角を足す）
+         * @param pose: 座標
+         */
+        Pose2D<T> apply(const Pose2D<T> &pose) const
+        {
+            return Pose2D<T>(_cos * pose.x - _sin * pose.y + _tx, _sin * pose.x + _cos * pose.y + _ty, pose.theta + _theta);
+        }
+
+        /**
+         * @brief 座標を逆変換（inverse().apply(pose)と同じ）
+         * @param pose: 座標
+         */
+        Pose2D<T> applyInverse(const Pose2D<T> &pose) const
+        {
+            const T dx = pose.x - _tx, dy = pose.y - _ty;
+            return Pose2D<T>(_cos * dx + _sin * dy, -_sin * dx + _cos * dy, pose.theta - _theta);
+        }
+
+        /**
+         * @brief 点の配列をまとめて変換（上書き）
+         * @details 三角関数は計算せず，ループは自動ベクトル化される．動的なメモリ確保は行わない
+         * @param points: 点の配列
+         * @param num: 要素数
+         */
+        void apply(Vector2<T> *points, std::size_t num) const;
+
+        /**
+         * @brief 点の配列をまとめて変換
+         * @param in: 変換前の点の配列
+         * @param out: 変換後の点の出力先（inと重ならないこと．同じ配列の場合は上書きの方を使う）
+         * @param num: 要素数
+         */
+        void apply(const Vector2<T> *in, Vector2<T> *out, std::size_t num) const;
+
+        /**
+         * @brief x，yを別々の配列で持つ点群をまとめて変換（上書き）
+         * @param xs: x成分の配列
+         * @param ys: y成分の配列
+         * @param num: 要素数
+         */
+        void apply(T *xs, T *ys, std::size_t num) const;
+
+        /**
+         * @brief x，yを別々の配列で持つ点群をまとめて変換
+         * @param in_x: 変換前のx成分の配列
+         * @param in_y: 変換前のy成分の配列
+         * @param out_x: 変換後のx成分の出力先（入力と重ならないこと）
+         * @param out_y: 変換後のy成分の出力先（入力と重ならないこと）
+         * @param num: 要素数
+         */
+        void apply(const T *in_x, const T *in_y, T *out_x, T *out_y, std::size_t num) const;
+
+        /**
+         * @brief 回転のcos，sinの大きさを1に戻す
+         * @details 合成を多数回繰り返すと丸め誤差でcos^2 + sin^2が1からずれていくので，適宜呼ぶ
+         */
+        void normalize()
+        {
+            const T inv = T(1) / std::sqrt(_cos * _cos + _sin * _sin);
+            _cos *= inv;
+            _sin *= inv;
+        }
+
+        /**
+         * @brief aから見たbの相対変換を返す（a.inverse() * bと同じ）
+         * @param a: 基準の変換
+         * @param b: 対象の変換
+         */
+        static Transform2D getRelative(const Transform2D &a, const Transform2D &b)
+        {
+            return a.inverse() * b;
+        }
+
+        /**
+         * @brief 座標aから見た座標bの相対座標を返す
+         * @param a: 基準の座標
+         * @param b: 対象の座標
+         */
+        static Pose2D<T> getRelative(const Pose2D<T> &a, const Pose2D<T> &b)
+        {
+            return Transform2D(a).applyInverse(b);
+        }
+
+        /**
+         * @brief 変換の合成（rhsを適用してからこの変換を適用する変換）
+         */
+        Transform2D operator*(const Transform2D &rhs) const
+        {
+            Transform2D r;
+            r._cos = _cos * rhs._cos - _sin * rhs._sin;
+            r._sin = _sin * rhs._cos + _cos * rhs._sin;
+            r._theta = _theta + rhs._theta;
+            r._tx = _cos * rhs._tx - _sin * rhs._ty + _tx;
+            r._ty = _sin * rhs._tx + _cos * rhs._ty + _ty;
+            return r;
+        }
+
+        /**
+         * @brief 変換の合成を代入
+         */
+        Transform2D &operator*=(const Transform2D &rhs)
+        {
+            *this = *this * rhs;
+            return *this;
+        }
+
+        /**
+         * @brief 点の変換（apply()と同じ）
+         */
+        Vector2<T> operator*(const Vector2<T> &p) const { return apply(p); }
+
+        /**
+         * @brief 座標の変換（apply()と同じ）
+         */
+        Pose2D<T> operator*(const Pose2D<T> &pose) const { return apply(pose); }
+
+    private:
+        // 自動ベクトル化のため，ポインタに__restrictを付けた静的関数でループを回す
+        static void applyInterleaved(const Vector2<T> *__restrict in, Vector2<T> *__restrict out, std::size_t num, T c, T s, T tx, T ty);
+        static void applySplit(T *__restrict xs, T *__restrict ys, std::size_t num, T c, T s, T tx, T ty);
+        static void applySplit(const T *__restrict in_x, const T *__restrict in_y, T *__restrict out_x, T *__restrict out_y, std::size_t num, T c, T s, T tx, T ty);
+
+        T _tx = 0;    // 並進のx成分
+        T _ty = 0;    // 並進のy成分
+        T _theta = 0; // 回転角[rad]
+        T _cos = 1;   // cos(_theta)
+        T _sin = 0;   // sin(_theta)
+    };
+
+    template <typename T>
+    inline void Transform2D<T>::apply(Vector2<T> *points, std::size_t num) const
+    {
+        const T c = _cos, s = _sin, tx = _tx, ty = _ty;
+        for (std::size_t i = 0; i < num; i++)
+        {
+            const T px = points[i].x, py = points[i].y;
+            points[i].x = c * px - s * py + tx;
+            points[i].y = s * px + c * py + ty;
+        }
+    }
+
+    template <typename T>
+    inline void Transform2D<T>::apply(const Vector2<T> *in, Vector2<T> *out, std::size_t num) const
+    {
+        applyInterleaved(in, out, num, _cos, _sin, _tx, _ty);
+    }
+
+    template <typename T>
+    inline void Transform2D<T>::apply(T *xs, T *ys, std::size_t num) const
+    {
+        applySplit(xs, ys, num, _cos, _sin, _tx, _ty);
+    }
+
+    template <typename T>
+    inline void Transform2D<T>::apply(const T *in_x, const T *in_y, T *out_x, T *out_y, std::size_t num) const
+    {
+        applySplit(in_x, in_y, out_x, out_y, num, _cos, _sin, _tx, _ty);
+    }
+
+    template <typename T>
+    inline void Transform2D<T>::applyInterleaved(const Vector2<T> *__restrict in, Vector2<T> *__restrict out, std::size_t num, T c, T s, T tx, T ty)
+    {
+        for (std::size_t i = 0; i < num; i++)
+        {
+            const T px = in[i].x, py = in[i].y;
+            out[i].x = c * px - s * py + tx;
+            out[i].y = s * px + c * py + ty;
+        }
+    }
+
+    template <typename T>
+    inline void Transform2D<T>::applySplit(T *__restrict xs, T *__restrict ys, std::size_t num, T c, T s, T tx, T ty)
+    {
+        for (std::size_t i = 0; i < num; i++)
+        {
+            const T px = xs[i], py = ys[i];
+            xs[i] = c * px - s * py + tx;
+            ys[i] = s * px + c * py + ty;
+        }
+    }
+
+    template <typename T>
+    inline void Transform2D<T>::applySplit(const T *__restrict in_x, const T *__restrict in_y, T *__restrict out_x, T *__restrict out_y, std::size_t num, T c, T s, T tx, T ty)
+    {
+        for (std::size_t i = 0; i < num; i++)
+        {
+            const T px = in_x[i], py = in_y[i];
+            out_x[i] = c * px - s * py + tx;
+            out_y[i] = s * px + c * py + ty;
+        }
+    }
+
+    /**
+     * @brief 点の配列を座標poseの座標系からワールド座標系にまとめて変換（上書き）
+     * @details sin，cosの計算は1回のみ（Transform2D::apply()を参照）
+     * @param pose: 点の座標系の原点と向き（ロボットの位置など）
+     * @param points: 点の配列
+     * @param num: 要素数
+     */
+    template <typename T>
+    inline void transformPoints(const Pose2D<T> &pose, Vector2<T> *points, std::size_t num)
+    {
+        Transform2D<T>(pose).apply(points, num);
+    }
+
+    /**
+     * @brief 点の配列を座標poseの座標系からワールド座標系にまとめて変換
+     * @param pose: 点の座標系の原点と向き（ロボットの位置など）
+     * @param in: 変換前の点の配列
+     * @param out: 変換後の点の出力先（inと重ならないこと）
+     * @param num: 要素数
+     */
+    template <typename T>
+    inline void transformPoints(const Pose2D<T> &pose, const Vector2<T> *in, Vector2<T> *out, std::size_t num)
+    {
+        Transform2D<T>(pose).apply(in, out, num);
+    }
+
+    /**
+     * @brief x，yを別々の配列で持つ点群を座標poseの座標系からワールド座標系にまとめて変換（上書き）
+     * @param pose: 点の座標系の原点と向き（ロボットの位置など）
+     * @param xs: x成分の配列
+     * @param ys: y成分の配列
+     * @param num: 要素数
+     */
+    template <typename T>
+    inline void transformPoints(const Pose2D<T> &pose, T *xs, T *ys, std::size_t num)
+    {
+        Transform2D<T>(pose).apply(xs, ys, num);
+    }
+
+    /**
+     * @brief x，yを別々の配列で持つ点群を座標poseの座標系からワールド座標系にまとめて変換
+     * @param pose: 点の座標系の原点と向き（ロボットの位置など）
+     * @param in_x: 変換前のx成分の配列
+     * @param in_y: 変換前のy成分の配列
+     * @param out_x: 変換後のx成分の出力先（入力と重ならないこと）
+     * @param out_y: 変換後のy成分の出力先（入力と重ならないこと）
+     * @param num: 要素数
+     */
+    template <typename T>
+    inline void transformPoints(const Pose2D<T> &pose, const T *in_x, const T *in_y, T *out_x, T *out_y, std::size_t num)
+    {
+        Transform2D<T>(pose).apply(in_x, in_y, out_x, out_y, num);
+    }
+
+    template <typename Char, typename T>
+    inline std::basic_ostream<Char> &operator<<(std::basic_ostream<Char> &os, const Transform2D<T> &tf)
+    {
+        return os << tf.toPose();
+    }
+} // namespace myStd
+#endif // Transform2D_h
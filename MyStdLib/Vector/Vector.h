@@ -5,7 +5,10 @@
 #ifndef Vector_h
 #define Vector_h
 
+#include "VectorN.h"
 #include "Vector2.h"
 #include "Pose2D.h"
+#include "Transform2D.h"
+#include "PoseArray.h"
 
 #endif // Vector_h
@@ -0,0 +1,537 @@
+/**
+ * @file VectorN.h
+ * @brief N要素のベクトル
+**/
+#ifndef VectorN_h
+#define VectorN_h
+
+#include <iostream>
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include "./../MyStdFunctions.h"
+#include "./../FastMath.h"
+
+namespace myStd
+{
+    template <typename T, std::size_t N>
+    class VectorN;
+
+    namespace vector_detail
+    {
+        template <std::size_t... I>
+        struct indices
+        {
+        };
+
+        template <std::size_t N, std::size_t... I>
+        struct make_indices : make_indices<N - 1, N - 1, I...>
+        {
+        };
+
+        template <std::size_t... I>
+        struct make_indices<0, I...>
+        {
+            typedef indices<I...> type;
+        };
+
+        template <typename V>
+        struct is_vector : std::false_type
+        {
+        };
+
+        template <typename T, std::size_t N>
+        struct is_vector<VectorN<T, N>> : std::true_type
+        {
+        };
+
+        /**
+         * @brief 引数にVectorNを含まない場合にtrue（要素を並べるコンストラクタがコピーコンストラクタの代わりに選ばれないようにする）
+         */
+        template <typename... A>
+        struct no_vector : std::true_type
+        {
+        };
+
+        template <typename A, typename... R>
+        struct no_vector<A, R...> : std::integral_constant<bool, !is_vector<typename std::decay<A>::type>::value && no_vector<R...>::value>
+        {
+        };
+
+        /**
+         * @brief SIMDレジスタ1本分に揃えるアライメント
+         * @details 全体の大きさが2のべき乗で，標準のアロケータが保証する境界（alignof(std::max_align_t)）以下の場合のみ揃える．
+         *          それより大きく揃えるとC++17より前のstd::vectorで境界が守られないため
+         */
+        template <typename T, std::size_t N>
+        constexpr std::size_t simdAlign()
+        {
+            return ((N * sizeof(T)) & (N * sizeof(T) - 1)) == 0 && N * sizeof(T) <= alignof(std::max_align_t) && N * sizeof(T) > alignof(T)
+                       ? N * sizeof(T)
+                       : alignof(T);
+        }
+
+        /**
+         * @brief 要素の保持（N = 2, 3, 4は名前付きの要素x, y, z, wを持つ）
+         */
+        template <typename T, std::size_t N>
+        struct storage
+        {
+            T v[N] = {};
+
+            constexpr storage() = default;
+            template <typename... A>
+            constexpr storage(A... a) : v{a...} {}
+
+            MYSTD_CONSTEXPR14 T &at(std::size_t i) { return v[i]; }
+            constexpr const T &at(std::size_t i) const { return v[i]; }
+        };
+
+        template <typename T>
+        struct storage<T, 2>
+        {
+            T x = 0; /**< 2次元直交座標におけるx成分 */
+            T y = 0; /**< 2次元直交座標におけるy成分 */
+
+            constexpr storage() = default;
+            constexpr storage(T _x, T _y) : x(_x), y(_y) {}
+
+            MYSTD_CONSTEXPR14 T &at(std::size_t i) { return i == 0 ? x : y; }
+            constexpr const T &at(std::size_t i) const { return i == 0 ? x : y; }
+        };
+
+        template <typename T>
+        struct storage<T, 3>
+        {
+            T x = 0; /**< x成分 */
+            T y = 0; /**< y成分 */
+            T z = 0; /**< z成分 */
+
+            constexpr storage() = default;
+            constexpr storage(T _x, T _y, T _z) : x(_x), y(_y), z(_z) {}
+
+            MYSTD_CONSTEXPR14 T &at(std::size_t i) { return i == 0 ? x : (i == 1 ? y : z); }
+            constexpr const T &at(std::size_t i) const { return i == 0 ? x : (i == 1 ? y : z); }
+        };
+
+        template <typename T>
+        struct storage<T, 4>
+        {
+            T x = 0; /**< x成分 */
+            T y = 0; /**< y成分 */
+            T z = 0; /**< z成分 */
+            T w = 0; /**< w成分 */
+
+            constexpr storage() = default;
+            constexpr storage(T _x, T _y, T _z, T _w) : x(_x), y(_y), z(_z), w(_w) {}
+
+            MYSTD_CONSTEXPR14 T &at(std::size_t i) { return i == 0 ? x : (i == 1 ? y : (i == 2 ? z : w)); }
+            constexpr const T &at(std::size_t i) const { return i == 0 ? x : (i == 1 ? y : (i == 2 ? z : w)); }
+        };
+    } // namespace vector_detail
+
+    /**
+     * @brief N要素のベクトル
+     * @details 要素ごとの演算は添字を展開した式で書いているため，C++11でもconstexprで使え，
+     *          最適化時は要素数分のSIMD演算（またはスカラ演算）に展開される．
+     *          ただしsqrt()を使う関数（magnitude()，normalize()，getDistance()など）はstd::sqrt()がconstexprでないためconstexprにしていない．
+     *          全体の大きさがSIMDレジスタ1本分（8，16byte）の場合はその境界に揃える．
+     *          N = 2, 3, 4の場合は要素をx, y, z, wで参照でき，2要素の場合はVector2として回転などの操作も使える．
+     * @tparam T: 数値型
+     * @tparam N: 要素数
+    **/
+    template <typename T, std::size_t N>
+    class alignas(vector_detail::simdAlign<T, N>()) VectorN : public vector_detail::storage<T, N>
+    {
+        static_assert(N >= 1, "VectorN needs at least one element");
+        typedef vector_detail::storage<T, N> base_t;
+        typedef typename vector_detail::make_indices<N>::type index_t;
+
+    public:
+        /**
+         * @brief コンストラクタ（全ての要素は0）
+         */
+        constexpr VectorN() = default;
+
+        /**
+         * @brief コンストラクタ 要素の値で初期化
+         */
+        template <typename... A, typename = typename std::enable_if<sizeof...(A) == N && vector_detail::no_vector<A...>::value>::type>
+        constexpr VectorN(A... a) : base_t(static_cast<T>(a)...) {}
+
+        using base_t::at;
+
+        /**
+         * @brief 要素数の取得
+         */
+        static constexpr std::size_t size() { return N; }
+
+        /**
+         * @brief 要素の取得
+         * @param i: 要素の番号
+         */
+        MYSTD_CONSTEXPR14 T &operator[](std::size_t i) { return at(i); }
+        constexpr const T &operator[](std::size_t i) const { return at(i); }
+
+        /**
+         * @brief 指定されたベクトルがこのベクトルと等しい場合にtrueを返す
+         * @param v: 指定するベクトル
+         */
+        constexpr bool equals(const VectorN &v) const
+        {
+            return *this == v;
+        }
+
+        /**
+         * @brief このベクトルの大きさを1にする
+         */
+        void normalize()
+        {
+            *this /= length();
+        }
+
+        /**
+         * @brief 直交座標形式でこのベクトルを設定
+         */
+        template <typename... A, typename = typename std::enable_if<sizeof...(A) == N && vector_detail::no_vector<A...>::value>::type>
+        MYSTD_CONSTEXPR14 void set(A... a)
+        {
+            *this = VectorN(a...);
+        }
+
+        /**
+         * @brief このベクターをフォーマットした文字列を返す
+         * @return フォーマットした文字列
+         */
+        std::string toString() const
+        {
+            using std::to_string;
+            std::string s = "(";
+            for (std::size_t i = 0; i < N; i++)
+                s += (i ? ", " : "") + to_string(at(i));
+            return s + ')';
+        }
+
+        /**
+         * @brief このベクトルの長さを返す
+         * @return このベクトルの長さ
+         */
+        T length() const
+        {
+            return magnitude();
+        }
+
+        /**
+         * @brief このベクトルの長さを返す
+         * @return このベクトルの長さ
+         */
+        T magnitude() const
+        {
+            using std::sqrt; // Fixedなどのsqrt()は実引数依存の名前探索で見つける
+            return sqrt(sqrMagnitude());
+        }
+
+        /**
+         * @brief 大きさが1のこのベクトルを返す
+         * @return 大きさが1のこのベクトル
+         */
+        VectorN normalized() const
+        {
+            return *this / length();
+        }
+
+        /**
+         * @brief このベクトルの長さの2乘を返す
+         * @return このベクトルの長さ2乘
+         */
+        constexpr T sqrLength() const
+        {
+            return sqrMagnitude();
+        }
+
+        /**
+         * @brief このベクトルの長さの2乘を返す
+         * @return このベクトルの長さ2乘
+         */
+        constexpr T sqrMagnitude() const
+        {
+            return getDot(*this, *this);
+        }
+
+        /**
+         * @brief 2つのベクトルの内積を返す
+         * @param a: 1つ目のベクトル
+         * @param b: 2つ目のベクトル
+         * @return 2つのベクトルの内積
+         */
+        static constexpr T getDot(const VectorN &a, const VectorN &b)
+        {
+            return dot(a, b, 0);
+        }
+
+        /**
+         * @brief 2つのベクトルの距離を返す
+         * @param a: 1つ目のベクトル
+         * @param b: 2つ目のベクトル
+         * @return 2つのベクトルの距離を返す
+         */
+        static T getDistance(const VectorN &a, const VectorN &b)
+        {
+            return (b - a).magnitude();
+        }
+
+        /**
+         * @brief ベクトルaとbの間をtで線形補間
+         * @param a: 1つ目のベクトル
+         * @param b: 2つ目のベクトル
+         * @param t: 媒介変数
+         * @return 補間点
+         */
+        static constexpr VectorN leap(const VectorN &a, const VectorN &b, T t)
+        {
+            return a + (b - a) * guard<T>(t, 0, 1);
+        }
+
+        /**
+         * @brief 極座標形式でこのベクトルを設定（2要素のみ）
+         * @param r: 原点からの距離
+         * @param angle: 原点との角度
+         */
+        template <std::size_t M = N, typename std::enable_if<M == 2, int>::type = 0>
+        void setByPolar(T r, T angle)
+        {
+            T s, c;
+            trigSinCos(angle, s, c);
+            this->x = r * c;
+            this->y = r * s;
+        }
+
+        /**
+         * @brief このベクトルを原点中心にangle[rad]回転（2要素のみ）
+         * @param angle: 回転させる角度[rad]
+         */
+        template <std::size_t M = N, typename std::enable_if<M == 2, int>::type = 0>
+        void rotate(T angle)
+        {
+            T s, c;
+            trigSinCos(angle, s, c);
+            const T rx = this->x * c - this->y * s;
+            this->y = this->x * s + this->y * c;
+            this->x = rx;
+        }
+
+        /**
+         * @brief 指定座標中心(rot_x, rot_y)に回転（2要素のみ）
+         * @param rot_x: 回転中心のx座標
+         * @param rot_y: 回転中心のy座標
+         * @param angle: 回転させる角度[rad]
+         */
+        template <std::size_t M = N, typename std::enable_if<M == 2, int>::type = 0>
+        void rotate(T rot_x, T rot_y, T angle)
+        {
+            VectorN p(rot_x, rot_y);
+            rotate(p, angle);
+        }
+
+        /**
+         * @brief 座標oを中心にangleだけ回転（2要素のみ）
+         * @param o: 回転中心の座標
+         * @param angle: 回転させる角度[rad]
+         */
+        template <std::size_t M = N, typename std::enable_if<M == 2, int>::type = 0>
+        void rotate(VectorN o, T angle)
+        {
+            VectorN p = *this - o;
+            p.rotate(angle);
+            *this = p + o;
+        }
+
+        /**
+         * @brief 2つのベクトルのなす角を弧度法で返す（2要素のみ）
+         * @param a: 1つ目のベクトル
+         * @param b: 2つ目のベクトル
+         * @return 2つのベクトルのなす角[rad]
+         */
+        template <std::size_t M = N, typename std::enable_if<M == 2, int>::type = 0>
+        static T getAngle(const VectorN &a, const VectorN &b)
+        {
+            return trigAtan2(b.y - a.y, b.x - a.x);
+        }
+
+        /**
+         * @brief 2つのベクトルの外積を返す（3要素のみ）
+         * @param a: 1つ目のベクトル
+         * @param b: 2つ目のベクトル
+         * @return 2つのベクトルの外積
+         */
+        template <std::size_t M = N, typename std::enable_if<M == 3, int>::type = 0>
+        static constexpr VectorN getCross(const VectorN &a, const VectorN &b)
+        {
+            return VectorN(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+        }
+
+        /**
+         * @brief 全ての要素にスカラ加算
+         */
+        constexpr VectorN operator+() const
+        {
+            return *this;
+        }
+
+        /**
+         * @brief 全ての要素にスカラ減算
+         */
+        constexpr VectorN operator-() const
+        {
+            return neg(index_t());
+        }
+
+        /**
+         * @brief ベクトルの要素同士の和
+         */
+        constexpr VectorN operator+(const VectorN &v) const
+        {
+            return add(v, index_t());
+        }
+
+        /**
+         * @brief ベクトルの要素同士の差
+         */
+        constexpr VectorN operator-(const VectorN &v) const
+        {
+            return sub(v, index_t());
+        }
+
+        /**
+         * @brief 全ての要素にスカラ乗算
+         * @attention ベクトル同士の乗算は未定義，内積の計算はgetDot()を使用
+         */
+        constexpr VectorN operator*(T s) const
+        {
+            return mul(s, index_t());
+        }
+
+        /**
+         * @brief 全ての要素にスカラ除算
+         * @attention ベクトル同士の除算は未定義
+         */
+        constexpr VectorN operator/(T s) const
+        {
+            return div(s, index_t());
+        }
+
+        /**
+         * @brief ベクトルの要素同士の和を代入（スカラとの和の場合は全ての要素に対して加算）
+         */
+        MYSTD_CONSTEXPR14 VectorN &operator+=(const VectorN &v)
+        {
+            for (std::size_t i = 0; i < N; i++)
+                at(i) += v.at(i);
+            return *this;
+        }
+
+        /**
+         * @brief ベクトルの要素同士の差を代入（スカラとの和の場合は全ての要素に対して減算）
+         */
+        MYSTD_CONSTEXPR14 VectorN &operator-=(const VectorN &v)
+        {
+            for (std::size_t i = 0; i < N; i++)
+                at(i) -= v.at(i);
+            return *this;
+        }
+
+        /**
+         * @brief 全ての要素に対してスカラ乗算して代入（ベクトル同士の乗算は未定義）
+         */
+        MYSTD_CONSTEXPR14 VectorN &operator*=(T s)
+        {
+            for (std::size_t i = 0; i < N; i++)
+                at(i) *= s;
+            return *this;
+        }
+
+        /**
+         * @brief 全ての要素に対してスカラ除算して代入（ベクトル同士の除算は未定義）
+         */
+        MYSTD_CONSTEXPR14 VectorN &operator/=(T s)
+        {
+            for (std::size_t i = 0; i < N; i++)
+                at(i) /= s;
+            return *this;
+        }
+
+        /**
+         * @brief 2つのベクトルが等しい場合にtrueを返す
+         */
+        constexpr bool operator==(const VectorN &v) const
+        {
+            return eq(v, 0);
+        }
+
+        /**
+         * @brief 2つのベクトルが等しい場合にfalseを返す
+         */
+        constexpr bool operator!=(const VectorN &v) const
+        {
+            return !eq(v, 0);
+        }
+
+    private:
+        template <std::size_t... I>
+        constexpr VectorN neg(vector_detail::indices<I...>) const { return VectorN(-at(I)...); }
+        template <std::size_t... I>
+        constexpr VectorN add(const VectorN &v, vector_detail::indices<I...>) const { return VectorN(at(I) + v.at(I)...); }
+        template <std::size_t... I>
+        constexpr VectorN sub(const VectorN &v, vector_detail::indices<I...>) const { return VectorN(at(I) - v.at(I)...); }
+        template <std::size_t... I>
+        constexpr VectorN mul(T s, vector_detail::indices<I...>) const { return VectorN(at(I) * s...); }
+        template <std::size_t... I>
+        constexpr VectorN div(T s, vector_detail::indices<I...>) const { return VectorN(at(I) / s...); }
+
+        static constexpr T dot(const VectorN &a, const VectorN &b, std::size_t i)
+        {
+            return i + 1 == N ? a.at(i) * b.at(i) : a.at(i) * b.at(i) + dot(a, b, i + 1);
+        }
+        constexpr bool eq(const VectorN &v, std::size_t i) const
+        {
+            return i == N ? true : (at(i) == v.at(i) && eq(v, i + 1));
+        }
+    };
+
+    /**
+     * @brief 3要素のベクトル
+     */
+    template <typename T>
+    using Vector3 = VectorN<T, 3>;
+
+    /**
+     * @brief 4要素のベクトル
+     */
+    template <typename T>
+    using Vector4 = VectorN<T, 4>;
+
+    template <typename Char, typename T, std::size_t N>
+    inline std::basic_ostream<Char> &operator<<(std::basic_ostream<Char> &os, const VectorN<T, N> &v)
+    {
+        os << Char('(');
+        for (std::size_t i = 0; i < N; i++)
+        {
+            if (i)
+                os << Char(',') << Char(' ');
+            os << v[i];
+        }
+        return os << Char(')');
+    }
+
+    template <typename Char, typename T, std::size_t N>
+    inline std::basic_istream<Char> &operator>>(std::basic_istream<Char> &is, VectorN<T, N> &v)
+    {
+        Char unused;
+        is >> unused;
+        for (std::size_t i = 0; i < N; i++)
+            is >> v[i] >> unused;
+        return is;
+    }
+} // namespace myStd
+#endif // VectorN_h
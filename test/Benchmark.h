@@ -0,0 +1,339 @@
+/**
+ * @file Benchmark.h
+ * @brief ベンチマーク用の計測とベースラインの保存，比較
+ * @details 使い方はbench_all.cppを参照．コマンドライン引数
+ *          --filter <文字列>     名前に文字列を含むものだけ実行
+ *          --min-time <秒>       1回の計測の最短時間（既定値0.05）
+ *          --repeat <回数>       計測の回数（中央値を使う，既定値5）
+ *          --save <ファイル>     結果をベースラインとして保存（タブ区切り）
+ *          --compare <ファイル>  保存したベースラインとの差を表示
+ *          --threshold <%>       比較でこれ以上遅くなったものを回帰とし，終了コードを1にする（既定値10）
+ *          Linuxでperf_event_open()が使える場合はキャッシュミスなどのハードウェアカウンタも記録する．
+**/
+#ifndef Benchmark_h
+#define Benchmark_h
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace bench
+{
+    /**
+     * @brief 値を使ったことにして最適化で計算が消されないようにする
+     */
+    template <typename T>
+    inline void doNotOptimize(const T &value)
+    {
+#if defined(__GNUC__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        volatile const T *sink = &value;
+        (void)sink;
+#endif
+    }
+
+    /**
+     * @brief ハードウェアカウンタ（Linuxのperf_event_open()）
+     * @details 使えない環境（権限がない，仮想マシンなど）ではavailable()がfalseになり，値は全て0
+     */
+    class PerfCounters
+    {
+    public:
+        enum Event
+        {
+            CYCLES = 0,
+            INSTRUCTIONS,
+            CACHE_REFERENCES,
+            CACHE_MISSES,
+            NUM_EVENTS
+        };
+
+        PerfCounters()
+        {
+#if defined(__linux__)
+            const std::uint64_t configs[NUM_EVENTS] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                                       PERF_COUNT_HW_CACHE_REFERENCES, PERF_COUNT_HW_CACHE_MISSES};
+            for (int i = 0; i < NUM_EVENTS; i++)
+            {
+                perf_event_attr attr;
+                std::memset(&attr, 0, sizeof(attr));
+                attr.size = sizeof(attr);
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = configs[i];
+                attr.disabled = 1;
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+                _fd[i] = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+            }
+#endif
+        }
+
+        ~PerfCounters()
+        {
+#if defined(__linux__)
+            for (int i = 0; i < NUM_EVENTS; i++)
+                if (_fd[i] >= 0)
+                    close(_fd[i]);
+#endif
+        }
+
+        PerfCounters(const PerfCounters &) = delete;
+        PerfCounters &operator=(const PerfCounters &) = delete;
+
+        /**
+         * @brief カウンタを使えるか（キャッシュミスのカウンタが開けたか）
+         */
+        bool available() const { return _fd[CACHE_MISSES] >= 0; }
+
+        void start()
+        {
+#if defined(__linux__)
+            for (int i = 0; i < NUM_EVENTS; i++)
+            {
+                if (_fd[i] < 0)
+                    continue;
+                ioctl(_fd[i], PERF_EVENT_IOC_RESET, 0);
+                ioctl(_fd[i], PERF_EVENT_IOC_ENABLE, 0);
+            }
+#endif
+        }
+
+        /**
+         * @brief 計測を止めて値を読む
+         * @param values: NUM_EVENTS個の値の出力先
+         */
+        void stop(std::uint64_t *values)
+        {
+            for (int i = 0; i < NUM_EVENTS; i++)
+            {
+                values[i] = 0;
+#if defined(__linux__)
+                if (_fd[i] < 0)
+                    continue;
+                ioctl(_fd[i], PERF_EVENT_IOC_DISABLE, 0);
+                std::uint64_t v = 0;
+                if (read(_fd[i], &v, sizeof(v)) == static_cast<ssize_t>(sizeof(v)))
+                    values[i] = v;
+#endif
+            }
+        }
+
+    private:
+        int _fd[NUM_EVENTS] = {-1, -1, -1, -1};
+    };
+
+    /**
+     * @brief 1つのベンチマークの結果
+     */
+    struct Result
+    {
+        std::string name;
+        double ns_per_op;
+        double ops_per_s;
+        bool has_counters;
+        double cycles_per_op;
+        double instructions_per_op;
+        double cache_misses_per_op;
+        double cache_references_per_op;
+    };
+
+    /**
+     * @brief ベンチマークの実行と結果の保存，比較
+     */
+    class Suite
+    {
+    public:
+        Suite(int argc, char **argv)
+        {
+            for (int i = 1; i < argc; i++)
+            {
+                const std::string arg = argv[i];
+                const bool has_value = i + 1 < argc;
+                if (arg == "--filter" && has_value)
+                    _filter = argv[++i];
+                else if (arg == "--min-time" && has_value)
+                    _min_time = std::atof(argv[++i]);
+                else if (arg == "--repeat" && has_value)
+                    _repeat = std::max(1, std::atoi(argv[++i]));
+                else if (arg == "--save" && has_value)
+                    _save = argv[++i];
+                else if (arg == "--compare" && has_value)
+                    _compare = argv[++i];
+                else if (arg == "--threshold" && has_value)
+                    _threshold = std::atof(argv[++i]);
+                else
+                    std::cerr << "unknown argument: " << arg << std::endl;
+            }
+            if (!_compare.empty() && !loadBaseline(_compare))
+                std::cerr << "cannot read baseline: " << _compare << std::endl;
+
+            std::printf("%-44s %12s %14s %10s %10s %10s\n", "name", "ns/op", "ops/s", "cyc/op", "miss/op", "vs base");
+        }
+
+        /**
+         * @brief ベンチマークの実行
+         * @param name: 名前（タブ，改行を含まないこと）
+         * @param func: func(n)でn回の操作を行う関数
+         */
+        template <typename F>
+        void run(const std::string &name, F &&func)
+        {
+            if (!_filter.empty() && name.find(_filter) == std::string::npos)
+                return;
+
+            // 1回の計測がmin_time以上になる回数を求める（初回の実行はウォームアップを兼ねる）
+            std::size_t n = 1;
+            while (true)
+            {
+                const double t = measure(func, n);
+                if (t >= _min_time || n >= (std::size_t(1) << 40))
+                    break;
+                const double scale = t > 0 ? _min_time / t * 1.2 : 100.0;
+                n = static_cast<std::size_t>(std::ceil(n * std::min(100.0, std::max(2.0, scale))));
+            }
+
+            std::vector<double> ns(_repeat);
+            std::uint64_t total[PerfCounters::NUM_EVENTS] = {};
+            for (int r = 0; r < _repeat; r++)
+            {
+                std::uint64_t values[PerfCounters::NUM_EVENTS];
+                _perf.start();
+                ns[r] = measure(func, n) * 1e9 / static_cast<double>(n);
+                _perf.stop(values);
+                for (int i = 0; i < PerfCounters::NUM_EVENTS; i++)
+                    total[i] += values[i];
+            }
+            std::sort(ns.begin(), ns.end());
+
+            Result res;
+            res.name = name;
+            res.ns_per_op = ns[ns.size() / 2];
+            res.ops_per_s = res.ns_per_op > 0 ? 1e9 / res.ns_per_op : 0;
+            res.has_counters = _perf.available();
+            const double ops = static_cast<double>(n) * _repeat;
+            res.cycles_per_op = total[PerfCounters::CYCLES] / ops;
+            res.instructions_per_op = total[PerfCounters::INSTRUCTIONS] / ops;
+            res.cache_misses_per_op = total[PerfCounters::CACHE_MISSES] / ops;
+            res.cache_references_per_op = total[PerfCounters::CACHE_REFERENCES] / ops;
+            report(res);
+            _results.push_back(res);
+        }
+
+        /**
+         * @brief ベースラインの保存と回帰の判定
+         * @return 終了コード（比較で回帰があった場合は1）
+         */
+        int finish()
+        {
+            if (!_save.empty())
+            {
+                if (saveBaseline(_save))
+                    std::cout << "saved baseline: " << _save << std::endl;
+                else
+                    std::cerr << "cannot write baseline: " << _save << std::endl;
+            }
+            if (!_compare.empty())
+                std::cout << _regressions << " regression(s) over " << _threshold << "% against " << _compare << std::endl;
+            return _regressions > 0 ? 1 : 0;
+        }
+
+    private:
+        template <typename F>
+        static double measure(F &func, std::size_t n)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            func(n);
+            const auto end = std::chrono::steady_clock::now();
+            return std::chrono::duration<double>(end - start).count();
+        }
+
+        void report(const Result &res)
+        {
+            char cyc[16] = "n/a", miss[16] = "n/a", diff[24] = "";
+            if (res.has_counters)
+            {
+                std::snprintf(cyc, sizeof(cyc), "%.1f", res.cycles_per_op);
+                std::snprintf(miss, sizeof(miss), "%.3f", res.cache_misses_per_op);
+            }
+            auto it = _baseline.find(res.name);
+            if (it != _baseline.end() && it->second > 0)
+            {
+                const double pct = (res.ns_per_op - it->second) / it->second * 100.0;
+                const bool regression = pct > _threshold;
+                _regressions += regression ? 1 : 0;
+                std::snprintf(diff, sizeof(diff), "%+.1f%%%s", pct, regression ? " !" : "");
+            }
+            std::printf("%-44s %12.3f %14.4g %10s %10s %10s\n", res.name.c_str(), res.ns_per_op, res.ops_per_s, cyc, miss, diff);
+            std::fflush(stdout);
+        }
+
+        // 形式: 1行目はヘッダ，以降は「名前<TAB>ns/op<TAB>ops/s<TAB>cycles/op<TAB>instructions/op<TAB>cache-misses/op<TAB>cache-references/op」
+        // （カウンタが使えなかった場合はnan）
+        bool saveBaseline(const std::string &path) const
+        {
+            std::ofstream ofs(path);
+            if (!ofs)
+                return false;
+            ofs << "name\tns_per_op\tops_per_s\tcycles_per_op\tinstructions_per_op\tcache_misses_per_op\tcache_references_per_op\n";
+            ofs.precision(9);
+            for (const Result &r : _results)
+            {
+                ofs << r.name << '\t' << r.ns_per_op << '\t' << r.ops_per_s;
+                if (r.has_counters)
+                    ofs << '\t' << r.cycles_per_op << '\t' << r.instructions_per_op << '\t' << r.cache_misses_per_op << '\t' << r.cache_references_per_op;
+                else
+                    ofs << "\tnan\tnan\tnan\tnan";
+                ofs << '\n';
+            }
+            return static_cast<bool>(ofs);
+        }
+
+        bool loadBaseline(const std::string &path)
+        {
+            std::ifstream ifs(path);
+            if (!ifs)
+                return false;
+            std::string line;
+            std::getline(ifs, line); // ヘッダ
+            while (std::getline(ifs, line))
+            {
+                const std::size_t tab = line.find('\t');
+                if (tab == std::string::npos)
+                    continue;
+                _baseline[line.substr(0, tab)] = std::atof(line.c_str() + tab + 1);
+            }
+            return true;
+        }
+
+        std::string _filter;
+        std::string _save;
+        std::string _compare;
+        double _min_time = 0.05;
+        int _repeat = 5;
+        double _threshold = 10.0;
+        int _regressions = 0;
+
+        PerfCounters _perf;
+        std::map<std::string, double> _baseline; // 名前 -> ns/op
+        std::vector<Result> _results;
+    };
+} // namespace bench
+
+#endif // Benchmark_h
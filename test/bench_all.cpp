@@ -0,0 +1,246 @@
+#include <iostream>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+#include "./../MyStdLib/MyStdLib.h"
+#include "Benchmark.h"
+
+// 主要な処理のベンチマーク（ns/op，ops/s，ハードウェアカウンタ）
+// g++ -std=c++11 -O2 bench_all.cpp -o bench_all（またはリポジトリ直下のCMakeLists.txtのbench_allターゲット）
+// ./bench_all --save base.tsv               ベースラインの保存
+// ./bench_all --compare base.tsv            ベースラインとの比較（10%以上遅くなると終了コード1）
+// ./bench_all --filter PurePursuit          名前で絞り込み
+
+constexpr std::size_t NUM_DATA = 1024; // L1に収まる大きさ（計算の速さを測る）
+
+template <typename T>
+static std::vector<T> randomValues(T lo, T hi, std::size_t num = NUM_DATA)
+{
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<T> dist(lo, hi);
+    std::vector<T> v(num);
+    for (T &x : v)
+        x = dist(rng);
+    return v;
+}
+
+template <typename T>
+static void benchVector(bench::Suite &suite, const std::string &type)
+{
+    typedef myStd::Vector2<T> V;
+    const std::vector<T> xs = randomValues<T>(-10, 10), ys = randomValues<T>(-5, 5), as = randomValues<T>(-4, 4);
+    std::vector<V> vs(NUM_DATA);
+    for (std::size_t i = 0; i < NUM_DATA; i++)
+        vs[i] = V(xs[i], ys[(i * 7) % NUM_DATA] + T(0.5));
+    const std::size_t mask = NUM_DATA - 1;
+
+    suite.run("Vector2<" + type + ">::operator+", [&](std::size_t n) {
+        V acc;
+        for (std::size_t i = 0; i < n; i++)
+            acc = acc + vs[i & mask];
+        bench::doNotOptimize(acc);
+    });
+    suite.run("Vector2<" + type + ">::operator*", [&](std::size_t n) {
+        V acc;
+        for (std::size_t i = 0; i < n; i++)
+            acc += vs[i & mask] * as[i & mask];
+        bench::doNotOptimize(acc);
+    });
+    suite.run("Vector2<" + type + ">::magnitude", [&](std::size_t n) {
+        T acc = 0;
+        for (std::size_t i = 0; i < n; i++)
+            acc += vs[i & mask].magnitude();
+        bench::doNotOptimize(acc);
+    });
+    suite.run("Vector2<" + type + ">::normalized", [&](std::size_t n) {
+        V acc;
+        for (std::size_t i = 0; i < n; i++)
+            acc += vs[i & mask].normalized();
+        bench::doNotOptimize(acc);
+    });
+    suite.run("Vector2<" + type + ">::getDistance", [&](std::size_t n) {
+        T acc = 0;
+        for (std::size_t i = 0; i < n; i++)
+            acc += V::getDistance(vs[i & mask], vs[(i + 1) & mask]);
+        bench::doNotOptimize(acc);
+    });
+    suite.run("Vector2<" + type + ">::rotate", [&](std::size_t n) {
+        V acc;
+        for (std::size_t i = 0; i < n; i++)
+        {
+            V v = vs[i & mask];
+            v.rotate(as[i & mask]);
+            acc += v;
+        }
+        bench::doNotOptimize(acc);
+    });
+    suite.run("Vector2<" + type + ">::getAngle", [&](std::size_t n) {
+        T acc = 0;
+        for (std::size_t i = 0; i < n; i++)
+            acc += V::getAngle(vs[i & mask], vs[(i + 1) & mask]);
+        bench::doNotOptimize(acc);
+    });
+    suite.run("Vector2<" + type + ">::setByPolar", [&](std::size_t n) {
+        V acc, v;
+        for (std::size_t i = 0; i < n; i++)
+        {
+            v.setByPolar(xs[i & mask], as[i & mask]);
+            acc += v;
+        }
+        bench::doNotOptimize(acc);
+    });
+}
+
+template <typename T>
+static void benchPose(bench::Suite &suite, const std::string &type)
+{
+    typedef myStd::Pose2D<T> P;
+    const std::vector<T> xs = randomValues<T>(-10, 10), ys = randomValues<T>(-5, 5), as = randomValues<T>(-4, 4);
+    std::vector<P> ps(NUM_DATA);
+    for (std::size_t i = 0; i < NUM_DATA; i++)
+        ps[i] = P(xs[i], ys[i], as[i]);
+    const std::size_t mask = NUM_DATA - 1;
+
+    suite.run("Pose2D<" + type + ">::operator+", [&](std::size_t n) {
+        P acc;
+        for (std::size_t i = 0; i < n; i++)
+            acc = acc + ps[i & mask];
+        bench::doNotOptimize(acc);
+    });
+    suite.run("Pose2D<" + type + ">::getDistance", [&](std::size_t n) {
+        T acc = 0;
+        for (std::size_t i = 0; i < n; i++)
+            acc += P::getDistance(ps[i & mask], ps[(i + 1) & mask]);
+        bench::doNotOptimize(acc);
+    });
+    suite.run("Pose2D<" + type + ">::rotate", [&](std::size_t n) {
+        P acc;
+        for (std::size_t i = 0; i < n; i++)
+        {
+            P p = ps[i & mask];
+            p.rotate(as[(i + 3) & mask]);
+            acc = acc + p;
+        }
+        bench::doNotOptimize(acc);
+    });
+    suite.run("Pose2D<" + type + ">::getAngle", [&](std::size_t n) {
+        T acc = 0;
+        for (std::size_t i = 0; i < n; i++)
+            acc += P::getAngle(ps[i & mask], ps[(i + 1) & mask]);
+        bench::doNotOptimize(acc);
+    });
+}
+
+static void benchAngle(bench::Suite &suite)
+{
+    const std::vector<double> as = randomValues<double>(-20, 20);
+    const std::size_t mask = NUM_DATA - 1;
+
+#define BENCH_ANGLE(name, expr)                                       \
+    suite.run(name, [&](std::size_t n) {                              \
+        double acc = 0;                                               \
+        for (std::size_t i = 0; i < n; i++)                           \
+        {                                                             \
+            const double a = as[i & mask], b = as[(i + 1) & mask];    \
+            (void)b;                                                  \
+            acc += (expr);                                            \
+        }                                                             \
+        bench::doNotOptimize(acc);                                    \
+    })
+
+    BENCH_ANGLE("normalizeAngle", normalizeAngle(a));
+    BENCH_ANGLE("normalizeAnglePositive", normalizeAnglePositive(a));
+    BENCH_ANGLE("normalizeAbs90deg", normalizeAbs90deg(a));
+    BENCH_ANGLE("shortestAngularDistance", shortestAngularDistance(a, b));
+    BENCH_ANGLE("fastNormalizeAngle", myStd::fastNormalizeAngle(a));
+    BENCH_ANGLE("fastNormalizeAnglePositive", myStd::fastNormalizeAnglePositive(a));
+    BENCH_ANGLE("fastNormalizeAbs90deg", myStd::fastNormalizeAbs90deg(a));
+    BENCH_ANGLE("fastShortestAngularDistance", myStd::fastShortestAngularDistance(a, b));
+#undef BENCH_ANGLE
+}
+
+template <typename T_pid>
+static void benchPIDUpdate(bench::Suite &suite, const std::string &name, T_pid pid)
+{
+    const std::vector<double> vals = randomValues<double>(-1, 1);
+    const std::size_t mask = NUM_DATA - 1;
+    pid.reset();
+    pid.setSaturation(-10.0, 10.0);
+    suite.run(name, [&](std::size_t n) {
+        double acc = 0;
+        for (std::size_t i = 0; i < n; i++)
+        {
+            pid.update(1.0, vals[i & mask], 0.001);
+            acc += pid.getControlVal();
+        }
+        bench::doNotOptimize(acc);
+    });
+}
+
+static void benchPID(bench::Suite &suite)
+{
+    typedef myStd::PID<double> PID;
+    const PID::Mode modes[] = {PID::Mode::pPID, PID::Mode::sPID, PID::Mode::PI_D, PID::Mode::I_PD};
+    const char *names[] = {"pPID", "sPID", "PI_D", "I_PD"};
+    for (int m = 0; m < 4; m++)
+    {
+        PID pid(1.2, 0.5, 0.01);
+        pid.setMode(modes[m]);
+        benchPIDUpdate(suite, std::string("PID<double>::update ") + names[m], pid);
+    }
+    benchPIDUpdate(suite, "PID<double, pPID>::update", myStd::PID<double, myStd::PIDMode::pPID>(1.2, 0.5, 0.01));
+    benchPIDUpdate(suite, "PID<double, sPID>::update", myStd::PID<double, myStd::PIDMode::sPID>(1.2, 0.5, 0.01));
+    benchPIDUpdate(suite, "PID<double, PI_D>::update", myStd::PID<double, myStd::PIDMode::PI_D>(1.2, 0.5, 0.01));
+    benchPIDUpdate(suite, "PID<double, I_PD>::update", myStd::PID<double, myStd::PIDMode::I_PD>(1.2, 0.5, 0.01));
+}
+
+// 経路に沿って1点ずつ進むロボットのupdate()（終点まで進んだら追従をやり直す）
+static void benchPurePursuit(bench::Suite &suite, std::size_t num_points)
+{
+    typedef myStd::PurePursuitControl<double, myStd::PID<double>> PPC;
+    std::vector<myStd::Pose2D<double>> path(num_points);
+    for (std::size_t i = 0; i < num_points; i++)
+        path[i] = myStd::Pose2D<double>(i * 0.1, std::sin(i * 0.01) * 5.0, 0.0);
+
+    myStd::PID<double> pid(1.0, 0.0, 0.0);
+    pid.setMode(myStd::PID<double>::Mode::pPID);
+    pid.setSaturation(-1.0, 1.0);
+    pid.reset();
+    PPC ppc(path);
+    ppc.setController(pid, pid);
+    ppc.setLookahead(1.0);
+
+    std::size_t k = 0;
+    suite.run("PurePursuitControl::update path=" + std::to_string(num_points), [&](std::size_t n) {
+        double acc = 0;
+        for (std::size_t i = 0; i < n; i++)
+        {
+            if (++k + 2 >= num_points)
+            {
+                k = 0;
+                ppc.resetTracking();
+            }
+            const myStd::Pose2D<double> &p = path[k];
+            ppc.update(myStd::Pose2D<double>(p.x + 0.05, p.y - 0.05, 0.1), 0.001);
+            acc += ppc.getControlVal().x;
+        }
+        bench::doNotOptimize(acc);
+    });
+}
+
+int main(int argc, char **argv)
+{
+    bench::Suite suite(argc, argv);
+
+    benchVector<double>(suite, "double");
+    benchVector<float>(suite, "float");
+    benchPose<double>(suite, "double");
+    benchPose<float>(suite, "float");
+    benchAngle(suite);
+    benchPID(suite);
+    for (std::size_t num = 100; num <= 1000000; num *= 10)
+        benchPurePursuit(suite, num);
+
+    return suite.finish();
+}
@@ -0,0 +1,94 @@
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <vector>
+#include <string>
+#include "./../MyStdLib/MyStdLib.h"
+
+// 固定小数点数（Fixed<15, 16>）とfloat，doubleでPIDとVector2の演算1回あたりの時間を比較する
+// g++ -std=c++11 -O2 bench_fixed.cpp
+// ホストPCではfloat，doubleはFPUで計算されるため，ソフトウェア浮動小数点の参考として
+// libgccのソフトウェア実装で計算される__float128のPIDも測る．
+// FPUのないマイコンではfloat，doubleの結果がそのままソフトウェア浮動小数点の値になる
+// （例: arm-none-eabi-g++ -mcpu=cortex-m0 -O2，chronoの代わりにSysTickなどで計測する）
+
+constexpr int NUM_SAMPLE = 1 << 12;
+constexpr int NUM_LOOP = 500;
+
+template <typename T>
+double benchPID(const std::vector<T> &now_vals)
+{
+    myStd::PID<T, myStd::PIDMode::pPID> pid(T(1.2), T(0.5), T(0.01));
+    pid.reset();
+    pid.setSaturation(T(-10), T(10));
+    const T target = T(1);
+    const T dt = T(0.001);
+
+    T sum = T(0);
+    auto start = std::chrono::steady_clock::now();
+    for (int loop = 0; loop < NUM_LOOP; loop++)
+    {
+        for (const T &v : now_vals)
+        {
+            pid.update(target, v, dt);
+            sum += pid.getControlVal();
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    // 最適化で計算が消されないよう結果を使う
+    volatile double sink = static_cast<double>(sum);
+    (void)sink;
+    return std::chrono::duration<double, std::nano>(end - start).count() / (double(NUM_LOOP) * now_vals.size());
+}
+
+// 正規化（sqrt），角度（atan2），回転（sin, cos）を1回ずつ
+template <typename T>
+double benchVector(const std::vector<myStd::Vector2<T>> &points)
+{
+    const T angle = T(0.3);
+    T sum = T(0);
+    auto start = std::chrono::steady_clock::now();
+    for (int loop = 0; loop < NUM_LOOP; loop++)
+    {
+        for (const myStd::Vector2<T> &p : points)
+        {
+            myStd::Vector2<T> v = p.normalized();
+            v.rotate(angle);
+            sum += v.x + myStd::Vector2<T>::getAngle(myStd::Vector2<T>(), p);
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    volatile double sink = static_cast<double>(sum);
+    (void)sink;
+    return std::chrono::duration<double, std::nano>(end - start).count() / (double(NUM_LOOP) * points.size());
+}
+
+template <typename T>
+void run(const std::string &name, const std::vector<double> &vals)
+{
+    std::vector<T> now_vals(vals.begin(), vals.end());
+    std::vector<myStd::Vector2<T>> points;
+    for (std::size_t i = 0; i + 1 < vals.size(); i++)
+        points.push_back(myStd::Vector2<T>(T(vals[i] + 2.0), T(vals[i + 1] - 0.5)));
+    std::cout << name << "\tPID: " << benchPID(now_vals) << " ns/update\tVector2: " << benchVector(points) << " ns/op" << std::endl;
+}
+
+int main(void)
+{
+    std::vector<double> vals(NUM_SAMPLE);
+    for (int i = 0; i < NUM_SAMPLE; i++)
+        vals[i] = std::sin(i * 0.01);
+
+    run<myStd::fixed32_t>("Fixed<15, 16>", vals);
+    run<float>("float", vals);
+    run<double>("double", vals);
+#ifdef __SIZEOF_FLOAT128__
+    // __float128はlibquadmathなしでは三角関数を使えないためPIDのみ
+    std::vector<__float128> now_vals(vals.begin(), vals.end());
+    std::cout << "__float128\tPID: " << benchPID(now_vals) << " ns/update" << std::endl;
+#endif
+
+    return 0;
+}
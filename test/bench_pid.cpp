@@ -0,0 +1,63 @@
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <string>
+#include "./../MyStdLib/MyStdLib.h"
+
+// PID::update()1回あたりの時間を，実行時モード切り替えとコンパイル時モード指定で比較する
+// g++ -std=c++11 -O2 bench_pid.cpp
+
+constexpr int NUM_SAMPLE = 1 << 12;
+constexpr int NUM_LOOP = 2000;
+
+template <typename T_pid>
+double bench(T_pid pid, const std::vector<double> &now_vals)
+{
+    double sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int loop = 0; loop < NUM_LOOP; loop++)
+    {
+        for (double v : now_vals)
+        {
+            pid.update(1.0, v, 0.001);
+            sum += pid.getControlVal();
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    // 最適化で計算が消されないよう結果を使う
+    volatile double sink = sum;
+    (void)sink;
+    return std::chrono::duration<double, std::nano>(end - start).count() / (double(NUM_LOOP) * now_vals.size());
+}
+
+template <typename ModePolicy>
+void compare(const std::string &name, myStd::PID<double>::Mode mode, const std::vector<double> &now_vals)
+{
+    myStd::PID<double> runtime_pid(1.2, 0.5, 0.01);
+    runtime_pid.reset();
+    runtime_pid.setMode(mode);
+    runtime_pid.setSaturation(-10.0, 10.0);
+
+    myStd::PID<double, ModePolicy> static_pid(1.2, 0.5, 0.01);
+    static_pid.reset();
+    static_pid.setSaturation(-10.0, 10.0);
+
+    double t_runtime = bench(runtime_pid, now_vals);
+    double t_static = bench(static_pid, now_vals);
+    std::cout << name << "\truntime: " << t_runtime << " ns/update\tstatic: " << t_static << " ns/update\tratio: " << t_runtime / t_static << std::endl;
+}
+
+int main(void)
+{
+    std::vector<double> now_vals(NUM_SAMPLE);
+    for (int i = 0; i < NUM_SAMPLE; i++)
+        now_vals[i] = std::sin(i * 0.01);
+
+    compare<myStd::PIDMode::pPID>("pPID", myStd::PID<double>::Mode::pPID, now_vals);
+    compare<myStd::PIDMode::sPID>("sPID", myStd::PID<double>::Mode::sPID, now_vals);
+    compare<myStd::PIDMode::PI_D>("PI_D", myStd::PID<double>::Mode::PI_D, now_vals);
+    compare<myStd::PIDMode::I_PD>("I_PD", myStd::PID<double>::Mode::I_PD, now_vals);
+
+    return 0;
+}
@@ -0,0 +1,77 @@
+#include <iostream>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "./../MyStdLib/MyStdLib.h"
+
+// 角度の正規化の高速版が既存の関数と一致することを確認する
+// g++ -std=c++11 -O2 test_angle.cpp && ./a.out
+
+// fmodを2回使う以前のnormalizeAnglePositive()（正の余りにも2piを足すため最大1ulp(2pi)の誤差がある）
+static double legacyNormalizeAnglePositive(double angle)
+{
+    return fmod(fmod(angle, 2.0 * PI) + 2.0 * PI, 2.0 * PI);
+}
+
+// 円周上での差（範囲の端で-piとpiのように表現が分かれた場合も0とみなす）
+static double circularError(double a, double b, double period)
+{
+    double d = std::fabs(a - b);
+    return std::min(d, std::fabs(period - d));
+}
+
+static int failures = 0;
+
+static void check(const char *name, double angle, double actual, double expected, double period, double tol,
+                  double lo, double hi, bool hi_inclusive)
+{
+    const bool in_range = (actual >= lo) && (hi_inclusive ? actual <= hi : actual < hi);
+    if (circularError(actual, expected, period) > tol || !in_range)
+    {
+        if (failures < 10)
+            std::cout << name << "(" << angle << ") = " << actual << ", expected " << expected << std::endl;
+        failures++;
+    }
+}
+
+int main(void)
+{
+    std::vector<double> angles = {0.0, -0.0, PI, -PI, HALF_PI, -HALF_PI, TWO_PI, -TWO_PI, 3 * PI, -3 * PI,
+                                  1e-300, -1e-300, std::nextafter(PI, 0.0), std::nextafter(-PI, 0.0)};
+    std::mt19937_64 rng(1);
+    std::uniform_real_distribution<double> turns(-4 * TWO_PI, 4 * TWO_PI);
+    for (int i = 0; i < 1000000; i++)
+        angles.push_back(turns(rng));
+
+    // 数周以内の入力で許す誤差（周回数 * 2piの丸め誤差）
+    const double tol = 8 * TWO_PI * 1e-16 * 4;
+
+    for (double a : angles)
+    {
+        check("normalizeAnglePositive", a, normalizeAnglePositive(a), legacyNormalizeAnglePositive(a), TWO_PI, 1e-15, 0.0, TWO_PI, false);
+        check("fastNormalizeAnglePositive", a, myStd::fastNormalizeAnglePositive(a), normalizeAnglePositive(a), TWO_PI, tol, 0.0, TWO_PI, false);
+        check("fastNormalizeAngle", a, myStd::fastNormalizeAngle(a), normalizeAngle(a), TWO_PI, tol, -PI, PI, true);
+        check("fastNormalizeAbs90deg", a, myStd::fastNormalizeAbs90deg(a), normalizeAbs90deg(a), PI, tol, -HALF_PI, HALF_PI, false);
+        check("fastShortestAngularDistance", a, myStd::fastShortestAngularDistance(1.0, a), shortestAngularDistance(1.0, a), TWO_PI, tol, -PI, PI, true);
+        check("fastNormalizeAngle<float>", a, myStd::fastNormalizeAngle(static_cast<float>(a)), normalizeAngle(static_cast<float>(a)), TWO_PI, 1e-5, -PI - 1e-6, PI + 1e-6, true);
+    }
+
+    // 配列版はスカラ版と完全に一致する
+    std::vector<double> out(angles.size()), inplace = angles, from(angles.size(), -2.0);
+    myStd::fastNormalizeAngle(angles.data(), out.data(), angles.size());
+    myStd::fastNormalizeAngle(inplace.data(), inplace.size());
+    for (std::size_t i = 0; i < angles.size(); i++)
+        if (out[i] != myStd::fastNormalizeAngle(angles[i]) || inplace[i] != out[i])
+            failures++;
+    myStd::fastNormalizeAnglePositive(angles.data(), out.data(), angles.size());
+    for (std::size_t i = 0; i < angles.size(); i++)
+        if (out[i] != myStd::fastNormalizeAnglePositive(angles[i]))
+            failures++;
+    myStd::fastShortestAngularDistance(from.data(), angles.data(), out.data(), angles.size());
+    for (std::size_t i = 0; i < angles.size(); i++)
+        if (out[i] != myStd::fastShortestAngularDistance(-2.0, angles[i]))
+            failures++;
+
+    std::cout << (failures == 0 ? "OK" : "NG") << " (" << failures << " failures in " << angles.size() << " angles)" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,121 @@
+#include <iostream>
+#include <cmath>
+#include <cstring>
+#include <utility>
+#include "./../MyStdLib/MyStdLib.h"
+
+// AnyControllerに入れたPIDが同じパラメータのPIDとビット単位で一致すること，
+// コピー，ムーブ，reset()，保持しているコントローラの寿命を確認する
+// g++ -std=c++11 -O2 test_any_controller.cpp && ./a.out
+
+typedef myStd::PID<double> PID;
+typedef myStd::AnyController<double> Any;
+
+static bool check(bool ok, const char *name)
+{
+    std::cout << (ok ? "OK " : "NG ") << name << std::endl;
+    return ok;
+}
+
+static bool same(double a, double b) { return std::memcmp(&a, &b, sizeof(double)) == 0; }
+
+static PID makePID()
+{
+    PID pid;
+    pid.setParam({PID::Mode::pPID, {1.5, 0.7, 0.02}, true, -2.0, 2.0});
+    pid.reset();
+    return pid;
+}
+
+// 両方を同じ入力で進めて出力が一致し続けるか
+static bool stepTogether(PID &pid, Any &any, int steps, int offset)
+{
+    bool ok = true;
+    for (int k = 0; k < steps; k++)
+    {
+        const double target = ((k + offset) % 40 < 20) ? 1.0 : -1.0;
+        const double now_val = 0.3 * std::sin((k + offset) * 0.1);
+        pid.update(target, now_val, 0.001 * (1 + k % 3));
+        any.update(target, now_val, 0.001 * (1 + k % 3));
+        ok = ok && same(pid.getControlVal(), any.getControlVal());
+    }
+    return ok;
+}
+
+// reset()を持たず，生成と破棄の回数を数えるコントローラ
+struct Counter
+{
+    static int alive;
+    double out = 0;
+
+    Counter() { alive++; }
+    Counter(const Counter &other) : out(other.out) { alive++; }
+    ~Counter() { alive--; }
+    void update(double target, double now_val, double) { out += target - now_val; }
+    double getControlVal() { return out; }
+};
+int Counter::alive = 0;
+
+int main(void)
+{
+    bool ok = true;
+
+    // 空の場合はupdate()もreset()も何もしない
+    {
+        Any any;
+        any.update(1.0, 0.0, 0.01);
+        any.reset();
+        ok &= check(any.empty() && any.getControlVal() == 0.0 && any.get<PID>() == nullptr, "empty");
+    }
+
+    // emplace()したPIDと単体のPIDが一致する
+    PID pid = makePID();
+    Any any;
+    any.emplace(makePID());
+    ok &= check(!any.empty() && any.get<PID>() != nullptr && any.get<Counter>() == nullptr, "emplace");
+    ok &= check(stepTogether(pid, any, 500, 0), "emplace matches PID");
+
+    // コピーは内部状態（積分値など）も含めて複製し，元とは独立に進む
+    {
+        PID pid_copy = pid;
+        Any any_copy(any);
+        ok &= check(stepTogether(pid_copy, any_copy, 300, 500), "copy matches PID");
+        Any assigned;
+        assigned = any;
+        PID pid_assigned = pid;
+        ok &= check(stepTogether(pid_assigned, assigned, 300, 700), "copy assignment matches PID");
+        ok &= check(stepTogether(pid, any, 100, 500), "original unaffected by copies");
+    }
+
+    // ムーブしたものも同じ状態から続く
+    {
+        PID pid_moved = pid;
+        Any moved(std::move(any));
+        ok &= check(stepTogether(pid_moved, moved, 300, 600), "move matches PID");
+        Any move_assigned;
+        move_assigned = std::move(moved);
+        ok &= check(stepTogether(pid_moved, move_assigned, 300, 900), "move assignment matches PID");
+
+        // reset()は保持しているPIDのreset()を呼ぶ
+        pid_moved.reset();
+        move_assigned.reset();
+        ok &= check(stepTogether(pid_moved, move_assigned, 300, 0), "reset matches PID");
+    }
+
+    // reset()を持たないコントローラも保持でき，生成したものは全て破棄される
+    {
+        Any a(Counter{});
+        a.update(2.0, 0.5, 0.01);
+        a.reset();
+        Any b(a);
+        b.update(1.0, 0.0, 0.01);
+        ok &= check(a.getControlVal() == 1.5 && b.getControlVal() == 2.5 && Counter::alive == 2, "controller without reset");
+        b = PID(1.0, 0.0, 0.0);
+        ok &= check(Counter::alive == 1 && b.get<PID>() != nullptr, "replacing destroys old controller");
+        a.clear();
+        ok &= check(Counter::alive == 0 && a.empty(), "clear destroys controller");
+    }
+
+    std::cout << (ok ? "OK" : "NG") << std::endl;
+    return ok ? 0 : 1;
+}
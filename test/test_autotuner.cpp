@@ -0,0 +1,127 @@
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include "./../MyStdLib/MyStdLib.h"
+#include "./../MyStdLib/Control/PlantModel.h"
+#include "./../MyStdLib/RealTime/RealTime.h"
+
+// PIDゲインの自動調整の確認と評価の速度の計測
+// g++ -std=c++11 -O2 -pthread test_autotuner.cpp && ./a.out
+
+typedef myStd::PID<double>::Mode Mode;
+
+static bool check(bool ok, const char *name)
+{
+    std::cout << (ok ? "OK " : "NG ") << name << std::endl;
+    return ok;
+}
+
+static const char *modeName(Mode mode)
+{
+    switch (mode)
+    {
+    case Mode::pPID:
+        return "pPID";
+    case Mode::sPID:
+        return "sPID";
+    case Mode::PI_D:
+        return "PI_D";
+    case Mode::I_PD:
+        return "I_PD";
+    }
+    return "";
+}
+
+// 各モードで調整し，格子探索より良いこと，安定して整定すること，スレッド数によらず一致することを確認する
+template <typename T_plant>
+static bool tuneModes(const char *name, const T_plant &plant, typename myStd::PIDAutotuner<double, T_plant>::param_t param)
+{
+    typedef myStd::PIDAutotuner<double, T_plant> Tuner;
+    bool ok = true;
+    Tuner tuner(plant, param, 4), single(plant, param, 1);
+    const Mode modes[] = {Mode::pPID, Mode::sPID, Mode::PI_D, Mode::I_PD};
+    for (Mode mode : modes)
+    {
+        param.mode = mode;
+        tuner.setParam(param);
+        single.setParam(param);
+
+        const auto start = std::chrono::steady_clock::now();
+        const typename Tuner::result_t r = tuner.tune();
+        const double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        const typename Tuner::result_t s = single.tune();
+
+        std::cout << name << " " << modeName(mode) << ": Kp=" << r.gain.Kp << " Ki=" << r.gain.Ki << " Kd=" << r.gain.Kd
+                  << " cost=" << r.cost << " (grid " << r.grid_cost << ") IAE=" << r.metrics.iae << " overshoot=" << r.metrics.overshoot
+                  << " settling=" << r.metrics.settling_time << "s, " << r.evaluations << " evaluations, "
+                  << r.evaluations / sec << " evaluations/s" << std::endl;
+
+        // sPIDは比例項がKp * diff[0] - diff[1]（Kp * (diff[0] - diff[1])ではない）ため，偏差が残る間は(Kp - 1) * diff[0]が
+        // 毎周期積み上がる大きな積分として働き，どのゲインでも評価時間内に整定しない．格子探索より良いことと発散しないことのみ確認する
+        const bool settled = mode == Mode::sPID || r.metrics.settling_time < param.duration * 0.8;
+        ok &= check(r.cost <= r.grid_cost && r.metrics.stable && settled, "tuned");
+        ok &= check(r.cost == s.cost && r.gain.Kp == s.gain.Kp && r.gain.Ki == s.gain.Ki && r.gain.Kd == s.gain.Kd &&
+                        r.evaluations == s.evaluations,
+                    "same result with 1 and 4 threads");
+    }
+    return ok;
+}
+
+int main(void)
+{
+    bool ok = true;
+    const double dt = 0.001;
+
+    // 制御対象のモデル
+    {
+        myStd::FOPDTPlant<double> fopdt(2.0, 0.5, 0.1, dt);
+        double y = 0;
+        for (int i = 0; i < 100; i++)
+            y = fopdt.step(1.0);
+        const bool delayed = (y == 0);
+        for (int i = 0; i < 500; i++)
+            y = fopdt.step(1.0);
+        ok &= check(delayed && std::fabs(y - 2.0 * (1 - std::exp(-1.0))) < 1e-12, "FOPDT step response");
+
+        myStd::DoubleIntegratorPlant<double> di(2.0, dt);
+        for (int i = 0; i < 1000; i++)
+            di.step(1.0);
+        ok &= check(std::fabs(di.getOutput() - 1.0) < 1e-12 && std::fabs(di.getVelocity() - 2.0) < 1e-12, "double integrator");
+    }
+
+    // 評価指標: 発散するゲイン，1つ固定した軸
+    {
+        typedef myStd::PIDAutotuner<double, myStd::DoubleIntegratorPlant<double>> Tuner;
+        Tuner::param_t param = Tuner::defaultParam();
+        param.need_saturation = false;
+        Tuner tuner(myStd::DoubleIntegratorPlant<double>(1.0, dt), param, 1);
+        const Tuner::metrics_t m = tuner.evaluate({10.0, 50.0, 0.0});
+        ok &= check(!m.stable && std::isinf(tuner.cost(m)), "unstable");
+
+        param.gain_min = param.gain_max = {1.0, 0.0, 0.0};
+        param.gain_min.Kd = 0.1;
+        param.gain_max.Kd = 10.0;
+        tuner.setParam(param);
+        const Tuner::result_t r = tuner.tune();
+        ok &= check(r.gain.Kp == 1.0 && r.gain.Ki == 0.0 && r.gain.Kd > 0.1 && r.metrics.stable, "fixed axes");
+    }
+
+    // 一次遅れ＋むだ時間系と二重積分系の調整
+    {
+        typedef myStd::PIDAutotuner<double, myStd::FOPDTPlant<double>> Tuner;
+        Tuner::param_t param = Tuner::defaultParam();
+        param.gain_min = {0.01, 0.01, 0.0001};
+        param.gain_max = {10.0, 10.0, 1.0};
+        ok &= tuneModes("FOPDT", myStd::FOPDTPlant<double>(2.0, 0.5, 0.1, dt), param);
+    }
+    {
+        typedef myStd::PIDAutotuner<double, myStd::DoubleIntegratorPlant<double>> Tuner;
+        Tuner::param_t param = Tuner::defaultParam();
+        param.gain_min = {0.1, 0.01, 0.01};
+        param.gain_max = {100.0, 10.0, 20.0};
+        ok &= tuneModes("double integrator", myStd::DoubleIntegratorPlant<double>(1.0, dt), param);
+    }
+
+    std::cout << (ok ? "OK" : "NG") << std::endl;
+    return ok ? 0 : 1;
+}
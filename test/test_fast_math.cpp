@@ -0,0 +1,94 @@
+#define MYSTD_FAST_MATH // Vector2::rotate()を近似版にする
+#include <iostream>
+#include <cmath>
+#include <limits>
+#include <random>
+#include "./../MyStdLib/MyStdLib.h"
+
+// fastSinCos，fastAtan2の誤差がFastMath.hの表に書いた上限以内であること，
+// 近似版のVector2::rotate()がstd::sin，std::cosを使った回転と一致することを確認する
+// g++ -std=c++11 -O2 test_fast_math.cpp && ./a.out
+
+using myStd::TrigAccuracy;
+
+static const int NUM_POINTS = 400000;
+
+static bool check(bool ok, const char *name)
+{
+    std::cout << (ok ? "OK " : "NG ") << name << std::endl;
+    return ok;
+}
+
+// |angle| <= rangeでのfastSinCosの最大絶対誤差（long doubleの結果と比較）
+template <typename T, TrigAccuracy A>
+static long double sinCosError(double range)
+{
+    std::mt19937_64 rng(1);
+    std::uniform_real_distribution<double> dist(-range, range);
+    long double err = 0;
+    for (int i = 0; i < NUM_POINTS; i++)
+    {
+        const T angle = static_cast<T>(dist(rng));
+        T s, c;
+        myStd::fastSinCos<T, A>(angle, s, c);
+        err = std::max(err, std::fabs(s - std::sin(static_cast<long double>(angle))));
+        err = std::max(err, std::fabs(c - std::cos(static_cast<long double>(angle))));
+    }
+    return err;
+}
+
+// fastAtan2の最大絶対誤差（全象限，long doubleの結果と比較）
+template <typename T, TrigAccuracy A>
+static long double atan2Error()
+{
+    std::mt19937_64 rng(2);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    long double err = 0;
+    for (int i = 0; i < NUM_POINTS; i++)
+    {
+        const T y = static_cast<T>(dist(rng)), x = static_cast<T>(dist(rng));
+        const T r = myStd::fastAtan2<T, A>(y, x);
+        err = std::max(err, std::fabs(r - std::atan2(static_cast<long double>(y), static_cast<long double>(x))));
+    }
+    return err;
+}
+
+// 近似版のrotate()と基準の式（x * cos - y * sin, x * sin + y * cos）の差が
+// sin，cosの誤差の上限tolと丸め誤差の分に収まるか
+template <typename T>
+static bool rotateMatches(double range, double tol)
+{
+    std::mt19937_64 rng(3);
+    std::uniform_real_distribution<double> angle_dist(-range, range), value(-10.0, 10.0);
+    const T eps = std::numeric_limits<T>::epsilon();
+    for (int i = 0; i < NUM_POINTS; i++)
+    {
+        const T angle = static_cast<T>(angle_dist(rng));
+        const T x = static_cast<T>(value(rng)), y = static_cast<T>(value(rng));
+        myStd::Vector2<T> v(x, y);
+        v.rotate(angle);
+        const T c = std::cos(angle), s = std::sin(angle);
+        const T bx = x * c - y * s, by = x * s + y * c;
+        const T limit = (std::fabs(x) + std::fabs(y)) * (static_cast<T>(tol) + 4 * eps);
+        if (std::fabs(v.x - bx) > limit || std::fabs(v.y - by) > limit)
+            return false;
+    }
+    return true;
+}
+
+int main(void)
+{
+    bool ok = true;
+    ok &= check(sinCosError<float, TrigAccuracy::High>(1e4) <= 1e-7, "fastSinCos float |angle| <= 1e4");
+    ok &= check(sinCosError<float, TrigAccuracy::High>(1e5) <= 1e-6, "fastSinCos float |angle| <= 1e5");
+    ok &= check(sinCosError<double, TrigAccuracy::High>(1e5) <= 2e-16, "fastSinCos double High");
+    ok &= check(sinCosError<double, TrigAccuracy::Low>(1e5) <= 3e-9, "fastSinCos double Low");
+    ok &= check(atan2Error<float, TrigAccuracy::High>() <= 3e-7, "fastAtan2 float");
+    ok &= check(atan2Error<double, TrigAccuracy::High>() <= 5e-16, "fastAtan2 double High");
+    ok &= check(atan2Error<double, TrigAccuracy::Low>() <= 1e-8, "fastAtan2 double Low");
+    ok &= check(rotateMatches<float>(1e4, 1e-7), "Vector2<float>::rotate");
+    ok &= check(rotateMatches<double>(1e5, 2e-16), "Vector2<double>::rotate");
+
+    std::cout << (ok ? "OK" : "NG") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,129 @@
+#include <iostream>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "./../MyStdLib/MyStdLib.h"
+
+// 固定小数点数のsqrt，sin，cos，atan2がdoubleの結果と1LSB以内で一致すること，範囲外で飽和すること，
+// PID<Fixed<15, 16>>の出力がPID<double>とほぼ一致することを確認する
+// g++ -std=c++11 -O2 test_fixed.cpp && ./a.out
+
+typedef myStd::fixed32_t F;
+typedef myStd::fixed16_t F16;
+
+static bool check(bool ok, const char *name)
+{
+    std::cout << (ok ? "OK " : "NG ") << name << std::endl;
+    return ok;
+}
+
+// 全ての正の値から間引いてsqrtを比較する（最も近い値に丸めるので0.5LSB）
+static double sqrtError()
+{
+    double err = 0;
+    for (std::int32_t raw = 0; raw < (1 << 30); raw += 997)
+    {
+        const F v = F::fromRaw(raw);
+        err = std::max(err, std::fabs(sqrt(v).toDouble() - std::sqrt(v.toDouble())));
+    }
+    return err / F::epsilon().toDouble();
+}
+
+// |angle| <= 100の範囲でsin，cosを比較する
+static double sinCosError()
+{
+    double err = 0;
+    for (std::int32_t raw = -100 * 65536; raw <= 100 * 65536; raw += 7)
+    {
+        const F v = F::fromRaw(raw);
+        err = std::max(err, std::fabs(sin(v).toDouble() - std::sin(v.toDouble())));
+        err = std::max(err, std::fabs(cos(v).toDouble() - std::cos(v.toDouble())));
+    }
+    return err / F::epsilon().toDouble();
+}
+
+// 全象限，大きさの異なるx, yの組でatan2を比較する
+static double atan2Error()
+{
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<std::int32_t> dist(-(1 << 30), 1 << 30);
+    double err = 0;
+    for (int i = 0; i < 1000000; i++)
+    {
+        const F y = F::fromRaw(dist(rng) >> (i % 20));
+        const F x = F::fromRaw(dist(rng) >> ((i / 20) % 20));
+        err = std::max(err, std::fabs(atan2(y, x).toDouble() - std::atan2(y.toDouble(), x.toDouble())));
+    }
+    return err / F::epsilon().toDouble();
+}
+
+template <typename T>
+static bool saturates()
+{
+    const T hi = T::maxValue(), lo = T::minValue();
+    bool ok = true;
+    ok = ok && (hi + hi == hi) && (lo + lo == lo) && (lo - hi == lo) && (hi - lo == hi);
+    ok = ok && (hi * T(2) == hi) && (hi * T(-2) == lo) && (lo * lo == hi);
+    ok = ok && (hi / T::epsilon() == hi) && (lo / T::epsilon() == lo);
+    ok = ok && (T(1) / T() == hi) && (T(-1) / T() == lo);
+    ok = ok && (T(1e9) == hi) && (T(-1e9) == lo) && (T(1000000) == hi) && (T(-1000000) == lo);
+    ok = ok && (-lo == hi) && (abs(lo) == hi);
+    // 飽和しない範囲では正しく計算される
+    ok = ok && (T(3) + T(-5) == T(-2)) && (T(1.5) * T(-2) == T(-3)) && (T(-3) / T(2) == T(-1.5));
+    return ok;
+}
+
+// ステップ状の目標値を1次遅れ系で追従させたときの操作量
+template <typename T>
+static std::vector<double> pidResponse(typename myStd::PID<T>::Mode mode)
+{
+    typedef myStd::PID<T> PID;
+    PID pid;
+    const typename PID::gain_t gain = {T(1.2), T(0.8), T(0.05)};
+    pid.setParam({mode, gain, true, T(-5), T(5)});
+    pid.reset();
+
+    // dtはFixedで正確に表せる値にする（0.001などは丸めで積分と微分に比例した誤差が出る）
+    const T dt = T(1.0 / 1024);
+    std::vector<double> out;
+    double y = 0;
+    for (int k = 0; k < 5000; k++)
+    {
+        pid.update(T(k % 2000 < 1000 ? 1.0 : -0.5), T(y), dt);
+        const double u = static_cast<double>(pid.getControlVal());
+        y += (u - y) * 0.01;
+        out.push_back(u);
+    }
+    return out;
+}
+
+static bool pidMatches(myStd::PID<F>::Mode fixed_mode, myStd::PID<double>::Mode double_mode, double tol)
+{
+    const std::vector<double> a = pidResponse<F>(fixed_mode), b = pidResponse<double>(double_mode);
+    double err = 0;
+    for (std::size_t i = 0; i < a.size(); i++)
+        err = std::max(err, std::fabs(a[i] - b[i]));
+    return err < tol;
+}
+
+int main(void)
+{
+    typedef myStd::PID<F>::Mode FM;
+    typedef myStd::PID<double>::Mode DM;
+
+    bool ok = true;
+    ok &= check(sqrtError() <= 1.0, "sqrt within 1LSB");
+    ok &= check(sinCosError() <= 1.0, "sin/cos within 1LSB (|angle| <= 100)");
+    ok &= check(atan2Error() <= 1.0, "atan2 within 1LSB");
+    ok &= check(saturates<F>(), "Fixed<15, 16> saturation");
+    ok &= check(saturates<F16>(), "Fixed<7, 8> saturation");
+    // 出力範囲±5に対して0.1%（速度型は前回の出力に足し込むため丸め誤差が溜まる分を見込んで0.4%）
+    ok &= check(pidMatches(FM::pPID, DM::pPID, 5e-3), "PID<Fixed> pPID");
+    ok &= check(pidMatches(FM::sPID, DM::sPID, 2e-2), "PID<Fixed> sPID");
+    ok &= check(pidMatches(FM::PI_D, DM::PI_D, 5e-3), "PID<Fixed> PI_D");
+    ok &= check(pidMatches(FM::I_PD, DM::I_PD, 5e-3), "PID<Fixed> I_PD");
+
+    std::cout << (ok ? "OK" : "NG") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,113 @@
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include "./../MyStdLib/MyStdLib.h"
+#include "./../MyStdLib/RealTime/RealTime.h"
+
+// FleetTrackerの結果がスレッド数によらず一致することを確認し，スレッド数ごとの処理時間を表示する
+// g++ -std=c++11 -O2 -pthread test_fleet.cpp && ./a.out
+
+using Controller = myStd::PurePursuitControl<double, myStd::PID<double>>;
+
+constexpr int NUM_ROBOTS = 10000;
+constexpr int NUM_STEPS = 20;
+
+// 全てのステップの制御量を返す
+static std::vector<myStd::Pose2D<double>> simulate(std::size_t num_threads, double &ns_per_robot)
+{
+    myStd::FleetTracker<double, myStd::PID<double>> fleet(num_threads);
+
+    // 4本の経路を全てのロボットで共有する
+    for (int k = 0; k < 4; k++)
+    {
+        std::vector<myStd::Pose2D<double>> path;
+        for (int i = 0; i < 200; i++)
+            path.push_back(myStd::Pose2D<double>(i * 0.1, std::sin(i * 0.05 + k), 0.0));
+        fleet.addPath(std::move(path));
+    }
+
+    myStd::PID<double> pid(1.0, 0.0, 0.0);
+    pid.setMode(myStd::PID<double>::Mode::pPID);
+    pid.setSaturation(-1.0, 1.0);
+    pid.reset();
+    Controller proto;
+    proto.setController(pid, pid);
+    proto.setLookahead(0.3);
+
+    fleet.reserve(NUM_ROBOTS);
+    std::vector<myStd::Pose2D<double>> poses(NUM_ROBOTS);
+    for (int i = 0; i < NUM_ROBOTS; i++)
+    {
+        fleet.addRobot(i % 4, proto);
+        poses[i] = myStd::Pose2D<double>((i % 100) * 0.15, (i / 100) * 0.01 - 0.5, 0.0);
+    }
+
+    std::vector<myStd::Pose2D<double>> history;
+    auto start = std::chrono::steady_clock::now();
+    for (int step = 0; step < NUM_STEPS; step++)
+    {
+        fleet.update(poses, 0.01);
+        // 簡単な運動で現在位置を進める
+        for (int i = 0; i < NUM_ROBOTS; i++)
+        {
+            const myStd::Pose2D<double> &u = fleet.getControlVal(i);
+            poses[i].x += u.x * 0.01;
+            poses[i].theta += u.theta * 0.01;
+        }
+        history.insert(history.end(), fleet.getControlVals().begin(), fleet.getControlVals().end());
+    }
+    auto end = std::chrono::steady_clock::now();
+    ns_per_robot = std::chrono::duration<double, std::nano>(end - start).count() / (double(NUM_STEPS) * NUM_ROBOTS);
+    return history;
+}
+
+// ThreadPool::parallelFor()が全ての要素をちょうど1回ずつ処理する
+static bool checkCoverage(std::size_t num_threads)
+{
+    myStd::ThreadPool pool(num_threads);
+    std::vector<int> hits(100003, 0);
+    for (std::size_t grain : {1u, 7u, 1000u})
+    {
+        pool.parallelFor(3, hits.size(), grain, [&](std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; i++)
+                hits[i]++;
+        });
+    }
+    for (std::size_t i = 0; i < hits.size(); i++)
+        if (hits[i] != (i < 3 ? 0 : 3))
+            return false;
+    return true;
+}
+
+int main(void)
+{
+    int failures = 0;
+    for (std::size_t n = 1; n <= 8; n++)
+        if (!checkCoverage(n))
+        {
+            std::cout << "ThreadPool coverage failed with " << n << " threads" << std::endl;
+            failures++;
+        }
+
+    double t1;
+    const std::vector<myStd::Pose2D<double>> reference = simulate(1, t1);
+    std::cout << "threads: 1\t" << t1 << " ns/robot" << std::endl;
+
+    const std::size_t max_threads = std::max(4u, std::thread::hardware_concurrency());
+    for (std::size_t n = 2; n <= max_threads; n *= 2)
+    {
+        double t;
+        const std::vector<myStd::Pose2D<double>> result = simulate(n, t);
+        const bool same = result.size() == reference.size() &&
+                          std::memcmp(result.data(), reference.data(), result.size() * sizeof(result[0])) == 0;
+        std::cout << "threads: " << n << "\t" << t << " ns/robot\tspeedup: " << t1 / t << "\t" << (same ? "identical" : "DIFFERENT") << std::endl;
+        if (!same)
+            failures++;
+    }
+
+    std::cout << (failures == 0 ? "OK" : "NG") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
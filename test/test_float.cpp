@@ -0,0 +1,84 @@
+// float版のインスタンスで暗黙のdoubleへの昇格がないことを確認する
+// g++ -std=c++11 -O2 test_float.cpp && ./a.out
+// 昇格があるとコンパイルエラーになる（-Wdouble-promotionを下のpragmaでエラーにしている）
+#pragma GCC diagnostic error "-Wdouble-promotion"
+
+#include <iostream>
+#include <type_traits>
+#include <vector>
+#include "./../MyStdLib/MyStdLib.h"
+
+// メンバ関数を全て実体化して，本体に昇格がないかをコンパイラに検査させる
+template class myStd::VectorN<float, 2>;
+template class myStd::VectorN<float, 3>;
+template class myStd::VectorN<float, 4>;
+template class myStd::Pose2D<float>;
+template class myStd::Transform2D<float>;
+template class myStd::PoseArray<float>;
+template class myStd::PID<float>;
+template class myStd::PID<float, myStd::PIDMode::pPID>;
+template class myStd::PID<float, myStd::PIDMode::sPID>;
+template class myStd::PID<float, myStd::PIDMode::PI_D>;
+template class myStd::PID<float, myStd::PIDMode::I_PD>;
+template class myStd::PurePursuitControl<float, myStd::PID<float>>;
+
+// 戻り値の型
+static_assert(std::is_same<decltype(pi<float>()), float>::value, "pi<float>");
+static_assert(std::is_same<decltype(radians(1.0f)), float>::value, "radians(float)");
+static_assert(std::is_same<decltype(degrees(1.0f)), float>::value, "degrees(float)");
+static_assert(std::is_same<decltype(radians(90)), double>::value, "radians(int)");
+static_assert(std::is_same<decltype(leap(1.0f, 2.0f, 0.5f)), float>::value, "leap(float)");
+static_assert(std::is_same<decltype(normalizeAngle(1.0f)), float>::value, "normalizeAngle(float)");
+static_assert(std::is_same<decltype(normalizeAnglePositive(1.0f)), float>::value, "normalizeAnglePositive(float)");
+static_assert(std::is_same<decltype(normalizeAbs90deg(1.0f)), float>::value, "normalizeAbs90deg(float)");
+static_assert(std::is_same<decltype(shortestAngularDistance(1.0f, 2.0f)), float>::value, "shortestAngularDistance(float)");
+static_assert(std::is_same<decltype(myStd::Vector2<float>::leap({}, {}, 0.5f)), myStd::Vector2<float>>::value, "Vector2<float>::leap");
+
+// double版の定数は従来の定数と一致する
+static_assert(pi<double>() == PI && halfPi<double>() == HALF_PI && twoPi<double>() == TWO_PI, "pi<double>");
+
+static int failures = 0;
+
+static void check(const char *name, float actual, float expected, float tol)
+{
+    if (!(std::abs(actual - expected) <= tol))
+    {
+        std::cout << name << " = " << actual << ", expected " << expected << std::endl;
+        failures++;
+    }
+}
+
+int main(void)
+{
+    // 非テンプレートのメンバ関数を呼び出して本体を検査する
+    myStd::Vector2<float> a(1.0f, 2.0f), b(3.0f, 5.0f);
+    check("Vector2::leap", myStd::Vector2<float>::leap(a, b, 0.5f).y, 3.5f, 0);
+    check("Vector2::getAngle", myStd::Vector2<float>::getAngle(a, b), std::atan2(3.0f, 2.0f), 1e-6f);
+    a.rotate(halfPi<float>());
+    check("Vector2::rotate", a.x, -2.0f, 1e-6f);
+    a.setByPolar(2.0f, pi<float>());
+    check("Vector2::setByPolar", a.x, -2.0f, 1e-6f);
+
+    check("radians", radians(180.0f), pi<float>(), 0);
+    check("degrees", degrees(pi<float>()), 180.0f, 0);
+    check("leap", leap(1.0f, 3.0f, 2.0f), 3.0f, 0);
+    check("normalizeAngle", normalizeAngle(3.0f * pi<float>()), pi<float>(), 1e-6f);
+    check("normalizeAnglePositive", normalizeAnglePositive(-halfPi<float>()), 3.0f * halfPi<float>(), 1e-6f);
+    check("normalizeAbs90deg", normalizeAbs90deg(pi<float>()), 0.0f, 1e-6f);
+    check("shortestAngularDistance", shortestAngularDistance(0.5f, -0.5f), -1.0f, 1e-6f);
+
+    myStd::PID<float> pid(1.0f, 0.5f, 0.1f);
+    pid.setMode(myStd::PID<float>::Mode::pPID);
+    pid.setSaturation(-1.0f, 1.0f);
+    pid.reset();
+    pid.update(1.0f, 0.0f, 0.01f);
+    check("PID", pid.getControlVal(), 1.0f, 0);
+
+    std::vector<myStd::Pose2D<float>> path = {{0.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {1.0f, 2.0f, 0.0f}};
+    myStd::PurePursuitControl<float, myStd::PID<float>> ppc(path);
+    ppc.setController(pid, pid);
+    ppc.update(1, myStd::Pose2D<float>(0.1f, 0.2f, 0.0f), 0.01f);
+
+    std::cout << (failures == 0 ? "OK" : "NG") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,123 @@
+#include <iostream>
+#include <cmath>
+#include <vector>
+#define MYSTD_INSTRUMENTATION
+#include "./../MyStdLib/MyStdLib.h"
+
+// 計測（MYSTD_INSTRUMENTATION）の確認
+// g++ -std=c++11 -O2 test_instrument.cpp && ./a.out
+
+static bool check(bool ok, const char *name)
+{
+    std::cout << (ok ? "OK " : "NG ") << name << std::endl;
+    return ok;
+}
+
+int main(void)
+{
+    bool ok = true;
+
+    // ヒストグラムのパーセンタイル値の相対誤差は2^-SubBits以下
+    {
+        myStd::LatencyHistogram<> hist;
+        for (std::uint64_t v = 1; v <= 100000; v++)
+            hist.record(v);
+        bool within = true;
+        const double qs[] = {1, 10, 50, 90, 99, 99.9};
+        for (double q : qs)
+        {
+            const double exact = q / 100.0 * 100000;
+            const double rel = std::fabs(double(hist.percentile(q)) - exact) / exact;
+            within = within && rel <= 1.0 / myStd::LatencyHistogram<>::NUM_SUB;
+        }
+        ok &= check(within, "histogram percentile error");
+        ok &= check(hist.count() == 100000 && hist.getMin() == 1 && hist.getMax() == 100000 &&
+                        hist.percentile(100) == 100000 && std::fabs(hist.mean() - 50000.5) < 1e-9,
+                    "histogram count/min/max/mean");
+
+        // ビンは連続して値の範囲を覆う
+        bool contiguous = true;
+        for (int i = 1; i < myStd::LatencyHistogram<>::NUM_BINS; i++)
+        {
+            const std::uint64_t lo = myStd::LatencyHistogram<>::binLower(i);
+            contiguous = contiguous && lo == myStd::LatencyHistogram<>::binLower(i - 1) + myStd::LatencyHistogram<>::binWidth(i - 1) &&
+                         myStd::LatencyHistogram<>::binIndex(lo) == i && myStd::LatencyHistogram<>::binIndex(lo - 1) == i - 1;
+        }
+        ok &= check(contiguous, "histogram bins");
+    }
+
+    // PID: 飽和と積分値のカウンタ
+    {
+        myStd::PID<double> pid(2.0, 1.0, 0.0);
+        pid.setMode(myStd::PID<double>::Mode::pPID);
+        pid.setSaturation(-1.0, 1.0);
+        pid.reset();
+        pid.getProbe().setIntegralThreshold(0.5);
+        for (int i = 0; i < 100; i++)
+            pid.update(1.0, 0.0, 0.01);  // 偏差1 -> 出力2以上で上限に張り付く
+        for (int i = 0; i < 50; i++)
+            pid.update(-1.0, 0.0, 0.01); // 偏差-1 -> 積分が残るため最初は上限，その後下限
+        const myStd::ControllerProbe::snapshot_t s = pid.getProbe().snapshot();
+        std::cout << s << std::endl;
+        ok &= check(s.calls == 150 && s.saturated_high >= 100 && s.saturated_low > 0 &&
+                        s.saturated_high + s.saturated_low <= 150,
+                    "PID saturation counters");
+        ok &= check(std::fabs(s.integral_abs_max - 0.995) < 1e-9 && s.integral_over > 0, "PID integral counters");
+        ok &= check(s.ticks_min <= s.ticks_p50 && s.ticks_p50 <= s.ticks_p99 && s.ticks_p99 <= s.ticks_max, "PID latency order");
+
+        // ポリシー版も同じ値を数える（sPIDは積分値を持たないので0）
+        myStd::PID<double, myStd::PIDMode::pPID> fixed(2.0, 1.0, 0.0);
+        fixed.setSaturation(-1.0, 1.0);
+        for (int i = 0; i < 100; i++)
+            fixed.update(1.0, 0.0, 0.01);
+        for (int i = 0; i < 50; i++)
+            fixed.update(-1.0, 0.0, 0.01);
+        const myStd::ControllerProbe::snapshot_t f = fixed.getProbe().snapshot();
+        ok &= check(f.saturated_high == s.saturated_high && f.saturated_low == s.saturated_low &&
+                        f.integral_abs_max == s.integral_abs_max,
+                    "PID policy matches runtime");
+
+        myStd::PID<double, myStd::PIDMode::sPID> vel(1.0, 1.0, 0.0);
+        vel.update(1.0, 0.0, 0.01);
+        ok &= check(vel.getProbe().snapshot().integral_abs_max == 0, "sPID has no integral");
+
+        // 固定小数点数でも計測できる（abs()はFixedのfriend関数）
+        myStd::PID<myStd::fixed32_t> fx(myStd::fixed32_t(2.0), myStd::fixed32_t(1.0), myStd::fixed32_t(0.0));
+        fx.setMode(myStd::PID<myStd::fixed32_t>::Mode::pPID);
+        fx.setSaturation(myStd::fixed32_t(-1.0), myStd::fixed32_t(1.0));
+        fx.reset();
+        const myStd::fixed32_t dt(1.0 / 128);
+        for (int i = 0; i < 100; i++)
+            fx.update(myStd::fixed32_t(1.0), myStd::fixed32_t(0.0), dt);
+        for (int i = 0; i < 50; i++)
+            fx.update(myStd::fixed32_t(-1.0), myStd::fixed32_t(0.0), dt);
+        const myStd::ControllerProbe::snapshot_t x = fx.getProbe().snapshot();
+        ok &= check(x.calls == 150 && x.saturated_high > 0 && x.saturated_low > 0 &&
+                        x.integral_abs_max == 99.5 / 128,
+                    "PID<Fixed> counters");
+
+        pid.getProbe().reset();
+        ok &= check(pid.getProbe().snapshot().calls == 0, "probe reset");
+    }
+
+    // PurePursuitControl: update()の回数
+    {
+        std::vector<myStd::Pose2D<double>> path;
+        for (int i = 0; i < 100; i++)
+            path.push_back(myStd::Pose2D<double>(i * 0.1, 0, 0));
+        myStd::PID<double> pid(1.0, 0.0, 0.0);
+        pid.setMode(myStd::PID<double>::Mode::pPID);
+        pid.setSaturation(-1.0, 1.0);
+        pid.reset();
+        myStd::PurePursuitControl<double, myStd::PID<double>> ppc(path);
+        ppc.setController(pid, pid);
+        ppc.setLookahead(0.5);
+        for (int i = 0; i < 80; i++)
+            ppc.update(myStd::Pose2D<double>(i * 0.1, 0.05, 0), 0.01);
+        ok &= check(ppc.getProbe().snapshot().calls == 80, "PurePursuitControl calls");
+    }
+
+    std::cout << "ticks per second: " << myStd::instrument::ticksPerSecond() << std::endl;
+    std::cout << (ok ? "OK" : "NG") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,109 @@
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "./../MyStdLib/MyStdLib.h"
+#include "./../MyStdLib/RealTime/RealTime.h"
+
+// LatestValueの読み出しが書き込み途中の値（torn read）を返さないことを確認する
+// g++ -std=c++11 -O2 -pthread test_latest_value.cpp && ./a.out
+
+// 全ての要素が1つのカウンタから決まる値（複数の語にまたがるよう大きめにする）
+struct Sample
+{
+    myStd::Pose2D<double> pose;
+    double v[5];
+    std::uint64_t seq;
+};
+
+static Sample makeSample(std::uint64_t i)
+{
+    Sample s;
+    s.pose = myStd::Pose2D<double>(double(i), -double(i), double(i) * 0.5);
+    for (int k = 0; k < 5; k++)
+        s.v[k] = double(i * (k + 2));
+    s.seq = i;
+    return s;
+}
+
+static bool consistent(const Sample &s)
+{
+    const Sample e = makeSample(s.seq);
+    if (s.pose.x != e.pose.x || s.pose.y != e.pose.y || s.pose.theta != e.pose.theta)
+        return false;
+    for (int k = 0; k < 5; k++)
+        if (s.v[k] != e.v[k])
+            return false;
+    return true;
+}
+
+static_assert(std::is_trivially_copyable<myStd::Pose2D<double>>::value, "Pose2D must be trivially copyable");
+static_assert(std::is_trivially_copyable<myStd::Vector2<float>>::value, "Vector2 must be trivially copyable");
+
+int main(void)
+{
+    const int NUM_READERS = 3;
+    const auto duration = std::chrono::milliseconds(1000);
+
+    myStd::LatestValue<Sample> cell;
+    std::atomic<bool> done{false};
+    std::atomic<std::uint64_t> torn{0}, backwards{0}, reads{0}, retries{0};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < NUM_READERS; r++)
+    {
+        readers.emplace_back([&] {
+            std::uint64_t last = 0, n = 0, fail = 0;
+            while (!done.load(std::memory_order_relaxed))
+            {
+                Sample s;
+                if (!cell.tryLoad(s))
+                {
+                    fail++;
+                    s = cell.load();
+                }
+                if (!consistent(s))
+                    torn++;
+                if (s.seq < last)
+                    backwards++;
+                last = s.seq;
+                n++;
+            }
+            reads += n;
+            retries += fail;
+        });
+    }
+
+    std::uint64_t writes = 0;
+    const auto end = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < end)
+    {
+        for (int k = 0; k < 1000; k++)
+            cell.store(makeSample(++writes));
+    }
+    done = true;
+    for (std::thread &t : readers)
+        t.join();
+
+    // 書き込みの回数と値が一致する
+    const bool version_ok = cell.version() == static_cast<std::uint32_t>(writes) && cell.load().seq == writes;
+
+    // newで確保しても64byte境界に揃う
+    bool aligned = true;
+    for (int k = 0; k < 16; k++)
+    {
+        std::unique_ptr<myStd::LatestValue<Sample>> one(new myStd::LatestValue<Sample>());
+        std::unique_ptr<myStd::LatestValue<double>[]> many(new myStd::LatestValue<double>[3]);
+        aligned = aligned && reinterpret_cast<std::uintptr_t>(one.get()) % 64 == 0 &&
+                  reinterpret_cast<std::uintptr_t>(&many[0]) % 64 == 0 && reinterpret_cast<std::uintptr_t>(&many[2]) % 64 == 0;
+    }
+
+    std::cout << "writes: " << writes << " reads: " << reads << " tryLoad failures: " << retries
+              << " torn: " << torn << " backwards: " << backwards << " aligned on heap: " << aligned << std::endl;
+    const bool ok = torn == 0 && backwards == 0 && version_ok && aligned;
+    std::cout << (ok ? "OK" : "NG") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,159 @@
+#include <iostream>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "./../MyStdLib/MyStdLib.h"
+#include "./../MyStdLib/Control/PathFile.h"
+
+// 経路データのバイナリファイルの書き出しと読み込み，不正なファイルを読み込まないことの確認
+// g++ -std=c++11 -O2 test_path_file.cpp && ./a.out
+
+static bool check(bool ok, const char *name)
+{
+    std::cout << (ok ? "OK " : "NG ") << name << std::endl;
+    return ok;
+}
+
+template <typename T>
+static std::vector<myStd::Pose2D<T>> makePath(std::size_t num)
+{
+    std::vector<myStd::Pose2D<T>> path;
+    for (std::size_t i = 0; i < num; i++)
+        path.push_back(myStd::Pose2D<T>(T(i * 0.01), T(std::sin(i * 0.01)), T(i * 0.001)));
+    return path;
+}
+
+static std::vector<char> readBytes(const std::string &filename)
+{
+    std::ifstream ifs(filename, std::ios::binary);
+    return std::vector<char>((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+}
+
+static void writeBytes(const std::string &filename, const std::vector<char> &bytes)
+{
+    std::ofstream ofs(filename, std::ios::binary | std::ios::trunc);
+    ofs.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+// 書き出して読み戻し，経路データと累積弧長が一致することを確認する
+template <typename T>
+static bool roundTrip(const std::string &filename, bool with_arc_length)
+{
+    const std::vector<myStd::Pose2D<T>> path = makePath<T>(1000);
+    if (!myStd::PathFile<T>::write(filename, path.data(), path.size(), with_arc_length))
+        return false;
+
+    myStd::PathFile<T> file;
+    if (!file.open(filename) || file.size() != path.size() || (file.arcLength() != nullptr) != with_arc_length)
+        return false;
+    bool same = std::memcmp(file.data(), path.data(), path.size() * sizeof(path[0])) == 0;
+    if (with_arc_length)
+    {
+        T s = 0;
+        for (std::size_t i = 0; i < path.size(); i++)
+        {
+            if (i > 0)
+                s += myStd::Pose2D<T>::getDistance(path[i - 1], path[i]);
+            same = same && file.arcLength()[i] == s;
+        }
+    }
+    return same;
+}
+
+int main(void)
+{
+    bool ok = true;
+    const std::string filename = "test_path_file.bin", bad = "test_path_file_bad.bin";
+
+    ok &= check(roundTrip<double>(filename, true), "double with arc length");
+    ok &= check(roundTrip<double>(filename, false), "double without arc length");
+    ok &= check(roundTrip<float>(filename, true), "float with arc length");
+
+    // ファイルの累積弧長を使って追従しても，経路データから計算した場合と同じ目標点になる
+    {
+        typedef myStd::PurePursuitControl<double, myStd::PID<double>> PPC;
+        const std::vector<myStd::Pose2D<double>> path = makePath<double>(1000);
+        myStd::PathFile<double>::write(filename, path.data(), path.size(), true);
+        myStd::PathFile<double> file;
+        file.open(filename);
+
+        myStd::PID<double> pid(1.0, 0.0, 0.0);
+        pid.setMode(myStd::PID<double>::Mode::pPID);
+        pid.setSaturation(-1.0, 1.0);
+        pid.reset();
+        PPC a, b;
+        a.setController(pid, pid);
+        b.setController(pid, pid);
+        a.setLookahead(0.2);
+        b.setLookahead(0.2);
+        a.setPath(path);
+        b.setPathView(file.data(), file.size(), file.arcLength());
+        double max_diff = 0;
+        for (std::size_t i = 0; i < path.size(); i += 5)
+        {
+            const myStd::Pose2D<double> pose(path[i].x, path[i].y + 0.01, 0.0);
+            a.update(pose, 0.01);
+            b.update(pose, 0.01);
+            max_diff = max(max_diff, myStd::Pose2D<double>::getDistance(a.getLookaheadPose(), b.getLookaheadPose()));
+        }
+        ok &= check(max_diff < 1e-12, "tracking with arc length column");
+    }
+
+    // 不正なファイル
+    {
+        myStd::PathFile<double> file;
+        ok &= check(!file.open("no_such_file.bin"), "missing file");
+
+        writeBytes(bad, std::vector<char>());
+        ok &= check(!file.open(bad), "empty file");
+
+        const std::vector<char> good = readBytes(filename);
+        writeBytes(bad, std::vector<char>(good.begin(), good.begin() + 32));
+        ok &= check(!file.open(bad), "truncated header");
+
+        writeBytes(bad, std::vector<char>(good.begin(), good.begin() + good.size() / 2));
+        ok &= check(!file.open(bad), "truncated data");
+
+        std::vector<char> bytes = good;
+        bytes[0] = 'X';
+        writeBytes(bad, bytes);
+        ok &= check(!file.open(bad), "bad magic");
+
+        myStd::PathFile<float> file_f;
+        ok &= check(!file_f.open(filename), "element type mismatch");
+
+        // count * sizeof(Pose2D)やoffset + bytesが桁あふれして範囲内に見える値
+        myStd::PathFile<double>::header_t header;
+        std::memcpy(&header, good.data(), sizeof(header));
+        bytes = good;
+        header.count = (std::uint64_t(1) << 62) / 3 + 1; // count * 24は2^64を超えて小さな値に戻る
+        header.arc_length_offset = 0;
+        std::memcpy(bytes.data(), &header, sizeof(header));
+        writeBytes(bad, bytes);
+        ok &= check(!file.open(bad), "overflowing count");
+
+        std::memcpy(&header, good.data(), sizeof(header));
+        header.pose_offset = ~std::uint64_t(0) - 7; // offset + bytesが桁あふれする
+        std::memcpy(bytes.data(), &header, sizeof(header));
+        writeBytes(bad, bytes);
+        ok &= check(!file.open(bad), "overflowing offset");
+
+        std::memcpy(&header, good.data(), sizeof(header));
+        header.arc_length_offset = good.size() - 8; // 弧長の列がファイルの外まで続く
+        std::memcpy(bytes.data(), &header, sizeof(header));
+        writeBytes(bad, bytes);
+        ok &= check(!file.open(bad) && file.data() == nullptr && file.size() == 0, "arc length out of range");
+
+        // 失敗した後も正しいファイルは開ける
+        ok &= check(file.open(filename) && file.size() == 1000, "reopen");
+    }
+    std::remove(filename.c_str());
+    std::remove(bad.c_str());
+
+    std::cout << (ok ? "OK" : "NG") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,209 @@
+#include <iostream>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "./../MyStdLib/MyStdLib.h"
+
+// 経路の空間インデックス，先読みのカーソル，経路データの持ち方（所有，参照，ストリーミング）の確認
+// g++ -std=c++11 -O2 test_path_tracking.cpp && ./a.out
+
+typedef myStd::PurePursuitControl<double, myStd::PID<double>> PPC;
+typedef myStd::Pose2D<double> Pose;
+
+static bool check(bool ok, const char *name)
+{
+    std::cout << (ok ? "OK " : "NG ") << name << std::endl;
+    return ok;
+}
+
+// 全ての線分を調べる（同じ距離の場合はインデックスの小さい方）
+static myStd::PathIndex<double>::result_t bruteForce(const std::vector<Pose> &path, const myStd::Vector2<double> &p)
+{
+    myStd::PathIndex<double>::result_t best = {-1, 0, 0};
+    double best_sq = INFINITY;
+    for (std::size_t i = 0; i + 1 < path.size(); i++)
+    {
+        const Pose &a = path[i], &b = path[i + 1];
+        const double vx = b.x - a.x, vy = b.y - a.y;
+        const double sq_len = vx * vx + vy * vy;
+        double t = (sq_len > 0) ? ((p.x - a.x) * vx + (p.y - a.y) * vy) / sq_len : 0.0;
+        t = guard<double>(t, 0, 1);
+        const double ex = a.x + vx * t - p.x, ey = a.y + vy * t - p.y;
+        const double sq = ex * ex + ey * ey;
+        if (sq < best_sq)
+        {
+            best_sq = sq;
+            best.idx = static_cast<int>(i);
+            best.t = t;
+        }
+    }
+    best.distance = std::sqrt(best_sq);
+    return best;
+}
+
+// 自分と交差し，重複点と長さの異なる線分を含む経路
+static std::vector<Pose> makePath()
+{
+    std::vector<Pose> path;
+    for (int i = 0; i < 3000; i++)
+    {
+        const double s = i * 0.01;
+        path.push_back(Pose(s + 3.0 * std::sin(s * 0.7), 2.0 * std::sin(s * 1.3), 0.0));
+        if (i % 97 == 0)
+            path.push_back(path.back());
+    }
+    return path;
+}
+
+static PPC makeController()
+{
+    myStd::PID<double> pid(1.0, 0.0, 0.0);
+    pid.setMode(myStd::PID<double>::Mode::pPID);
+    pid.setSaturation(-1.0, 1.0);
+    pid.reset();
+    PPC ppc;
+    ppc.setController(pid, pid);
+    ppc.setLookahead(0.25);
+    return ppc;
+}
+
+// 経路に沿って（少しずれながら）進むロボットの位置
+static std::vector<Pose> makeTrajectory(const std::vector<Pose> &path)
+{
+    std::vector<Pose> poses;
+    for (std::size_t i = 0; i + 1 < path.size(); i += 3)
+        poses.push_back(Pose(path[i].x + 0.02 * std::sin(i * 0.1), path[i].y - 0.02 * std::cos(i * 0.13), 0.1));
+    return poses;
+}
+
+static bool samePose(const Pose &a, const Pose &b) { return a.x == b.x && a.y == b.y && a.theta == b.theta; }
+
+int main(void)
+{
+    bool ok = true;
+    const std::vector<Pose> path = makePath();
+
+    // PathIndex: 経路の近くと遠くの点で全探索と一致する
+    {
+        myStd::PathIndex<double> index;
+        index.build(path.data(), path.size());
+        std::mt19937 rng(3);
+        std::uniform_real_distribution<double> near(-0.3, 0.3), far(-50.0, 50.0);
+        std::uniform_int_distribution<std::size_t> pick(0, path.size() - 1);
+        bool same = true;
+        for (int k = 0; k < 20000; k++)
+        {
+            const Pose &base = path[pick(rng)];
+            const myStd::Vector2<double> p = (k % 10 == 0) ? myStd::Vector2<double>(far(rng), far(rng))
+                                                            : myStd::Vector2<double>(base.x + near(rng), base.y + near(rng));
+            const auto a = index.nearest(path.data(), path.size(), p);
+            const auto b = bruteForce(path, p);
+            same = same && a.idx == b.idx && a.t == b.t && a.distance == b.distance;
+        }
+        // 経路の頂点そのもの（2つの線分から同じ距離）では小さい方のインデックス
+        const auto v = index.nearest(path.data(), path.size(), myStd::Vector2<double>(path[500].x, path[500].y));
+        ok &= check(same && v.idx == bruteForce(path, myStd::Vector2<double>(path[500].x, path[500].y)).idx, "PathIndex matches brute force");
+    }
+
+    // 経路の持ち方によらず先読み点と制御量が一致する
+    {
+        const std::vector<Pose> poses = makeTrajectory(path);
+        PPC owned = makeController(), view = makeController(), shared = makeController(), soa = makeController(),
+            stream = makeController();
+        owned.setPath(path);
+        view.setPathView(path.data(), path.size());
+        // 構築済みのインデックスとテーブルを借りる（FleetTrackerでの共有）
+        myStd::PathIndex<double> index;
+        myStd::ArcLengthTable<double> table;
+        index.build(path.data(), path.size());
+        table.build(path.data(), path.size());
+        shared.setPathView(path.data(), path.size(), index, table);
+        const myStd::PoseArray<double> array(path);
+        soa.setPathView(array);
+        // ストリーミングは容量に空きがある分だけ先に追加しておく
+        stream.setStreaming(512);
+        std::size_t pushed = 0;
+
+        bool same_view = true, same_shared = true, same_soa = true, same_stream = true;
+        double max_diff = 0;
+        for (const Pose &pose : poses)
+        {
+            while (pushed < path.size() && stream.push_back(path[pushed]))
+                pushed++;
+            owned.update(pose, 0.01);
+            view.update(pose, 0.01);
+            shared.update(pose, 0.01);
+            soa.update(pose, 0.01);
+            stream.update(pose, 0.01);
+            same_view = same_view && samePose(owned.getLookaheadPose(), view.getLookaheadPose()) &&
+                        samePose(owned.getControlVal(), view.getControlVal()) && owned.getCursor() == view.getCursor();
+            same_shared = same_shared && samePose(owned.getLookaheadPose(), shared.getLookaheadPose()) &&
+                          samePose(owned.getControlVal(), shared.getControlVal()) && owned.getCursor() == shared.getCursor();
+            same_soa = same_soa && samePose(owned.getLookaheadPose(), soa.getLookaheadPose()) &&
+                       samePose(owned.getControlVal(), soa.getControlVal()) && owned.getCursor() == soa.getCursor();
+            // ストリーミングは解放時に弧長の起点を移すため丸め誤差の分だけ異なり得る
+            same_stream = same_stream && owned.getCursor() == stream.getCursor();
+            max_diff = max(max_diff, Pose::getDistance(owned.getLookaheadPose(), stream.getLookaheadPose()));
+        }
+        ok &= check(same_view, "setPathView matches owned path");
+        ok &= check(same_shared, "shared index and table match owned path");
+        ok &= check(same_soa, "PoseArray view matches owned path");
+        ok &= check(same_stream && max_diff < 1e-9, "setStreaming matches owned path");
+        std::cout << "streaming max lookahead difference: " << max_diff << std::endl;
+
+        // 参照している経路にpush_back()した場合はコピーしてから追加する
+        view.push_back(Pose(100.0, 0.0, 0.0));
+        shared.push_back(Pose(100.0, 0.0, 0.0));
+        soa.push_back(Pose(100.0, 0.0, 0.0));
+        owned.push_back(Pose(100.0, 0.0, 0.0));
+        view.update(poses.back(), 0.01);
+        shared.update(poses.back(), 0.01);
+        soa.update(poses.back(), 0.01);
+        owned.update(poses.back(), 0.01);
+        ok &= check(samePose(owned.getLookaheadPose(), view.getLookaheadPose()) &&
+                        samePose(owned.getLookaheadPose(), shared.getLookaheadPose()) &&
+                        samePose(owned.getLookaheadPose(), soa.getLookaheadPose()) && path.size() == makePath().size() &&
+                        array.size() == path.size(),
+                    "push_back on view copies");
+
+        // 共有をやめた後は追加した点を含めて自分のインデックスで探索する（共有していたテーブルは変わらない）
+        owned.resetTracking();
+        shared.resetTracking();
+        owned.update(Pose(99.0, 0.0, 0.0), 0.01);
+        shared.update(Pose(99.0, 0.0, 0.0), 0.01);
+        ok &= check(samePose(owned.getLookaheadPose(), shared.getLookaheadPose()) &&
+                        shared.getCursor() == static_cast<int>(path.size()) - 1 && table.size() == path.size() - 1,
+                    "push_back on shared view rebuilds");
+    }
+
+    // カーソルは前方にのみ進む（ロボットが少し逆走しても戻らない）
+    {
+        std::vector<Pose> poses = makeTrajectory(path);
+        const std::size_t half = poses.size() / 2;
+        poses.resize(half);
+        for (std::size_t i = half; i-- > half - 20;)
+            poses.push_back(poses[i]);
+
+        PPC ppc = makeController();
+        ppc.setPathView(path.data(), path.size());
+        int prev = -1, at_half = -1;
+        bool forward = true;
+        for (std::size_t i = 0; i < poses.size(); i++)
+        {
+            ppc.update(poses[i], 0.01);
+            forward = forward && ppc.getCursor() >= prev;
+            prev = ppc.getCursor();
+            if (i + 1 == half)
+                at_half = prev;
+        }
+        ok &= check(forward && prev == at_half, "cursor never moves backward");
+
+        // resetTracking()の後は経路全体から探し直す
+        ppc.resetTracking();
+        ppc.update(poses.back(), 0.01);
+        ok &= check(ppc.getCursor() < at_half && ppc.getCursor() >= 0, "resetTracking");
+    }
+
+    std::cout << (ok ? "OK" : "NG") << std::endl;
+    return ok ? 0 : 1;
+}
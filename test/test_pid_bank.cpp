@@ -0,0 +1,84 @@
+#include <iostream>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "./../MyStdLib/MyStdLib.h"
+#include "./../MyStdLib/Control/FBController/PIDBank.h"
+
+// PIDBankの結果が同じゲインのPID<double>をループ数だけ並べた場合とビット単位で一致することを確認する
+// g++ -std=c++11 -O2 test_pid_bank.cpp && ./a.out
+
+typedef myStd::PID<double> PID;
+
+static bool check(bool ok, const char *name)
+{
+    std::cout << (ok ? "OK " : "NG ") << name << std::endl;
+    return ok;
+}
+
+template <PID::Mode M>
+static bool compare(bool need_saturation)
+{
+    const std::size_t N = 37; // ベクトル化の余りの要素も確かめるため半端な数にする
+    const int NUM_STEPS = 2000;
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<double> gain(0.0, 2.0), value(-1.0, 1.0);
+
+    myStd::PIDBank<double, M> bank(N);
+    std::vector<PID> pids(N);
+    for (std::size_t i = 0; i < N; i++)
+    {
+        const PID::gain_t g = {gain(rng), gain(rng), gain(rng) * 0.01};
+        const double limit = 0.5 + i * 0.05;
+        pids[i].setParam({M, g, need_saturation, -limit, limit});
+        pids[i].reset();
+        bank.setGain(i, g);
+        if (need_saturation)
+            bank.setSaturation(i, -limit, limit);
+    }
+    bank.reset();
+
+    std::vector<double> targets(N), now_vals(N);
+    bool same = true;
+    for (int k = 0; k < NUM_STEPS && same; k++)
+    {
+        const double dt = 0.001 * (1 + k % 3);
+        for (std::size_t i = 0; i < N; i++)
+        {
+            targets[i] = (k % 500 < 250) ? 1.0 : -0.5;
+            now_vals[i] = value(rng);
+        }
+        bank.update(targets.data(), now_vals.data(), dt);
+        for (std::size_t i = 0; i < N; i++)
+        {
+            pids[i].update(targets[i], now_vals[i], dt);
+            const double a = pids[i].getControlVal(), b = bank.getControlVal(i);
+            same = same && std::memcmp(&a, &b, sizeof(double)) == 0;
+        }
+
+        // 途中で一部のループだけリセットしても一致する
+        if (k == NUM_STEPS / 2)
+        {
+            pids[3].reset();
+            bank.reset(3);
+        }
+    }
+    return same;
+}
+
+int main(void)
+{
+    bool ok = true;
+    ok &= check(compare<PID::Mode::pPID>(false), "pPID");
+    ok &= check(compare<PID::Mode::sPID>(false), "sPID");
+    ok &= check(compare<PID::Mode::PI_D>(false), "PI_D");
+    ok &= check(compare<PID::Mode::I_PD>(false), "I_PD");
+    ok &= check(compare<PID::Mode::pPID>(true), "pPID with saturation");
+    ok &= check(compare<PID::Mode::sPID>(true), "sPID with saturation");
+    ok &= check(compare<PID::Mode::PI_D>(true), "PI_D with saturation");
+    ok &= check(compare<PID::Mode::I_PD>(true), "I_PD with saturation");
+
+    std::cout << (ok ? "OK" : "NG") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,70 @@
+#include <iostream>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include "./../MyStdLib/MyStdLib.h"
+
+// モードをコンパイル時に指定したPID<T, ModePolicy>の結果が，同じモードの実行時版PID<T>とビット単位で一致することを確認する
+// g++ -std=c++11 -O2 test_pid_mode.cpp && ./a.out
+
+typedef myStd::PID<double> PID;
+
+static bool check(bool ok, const char *name)
+{
+    std::cout << (ok ? "OK " : "NG ") << name << std::endl;
+    return ok;
+}
+
+template <typename Policy>
+static bool compare(PID::Mode mode, bool need_saturation)
+{
+    const int NUM_STEPS = 5000;
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> value(-1.0, 1.0);
+
+    const PID::gain_t gain = {1.3, 0.6, 0.015};
+    PID runtime;
+    runtime.setParam({mode, gain, need_saturation, -0.8, 0.8});
+    runtime.reset();
+    myStd::PID<double, Policy> policy;
+    policy.setParam({gain, need_saturation, -0.8, 0.8});
+    policy.reset();
+
+    bool same = true;
+    for (int k = 0; k < NUM_STEPS && same; k++)
+    {
+        const double target = (k % 700 < 350) ? 1.0 : -0.5;
+        const double now_val = value(rng);
+        const double dt = 0.001 * (1 + k % 3);
+        runtime.update(target, now_val, dt);
+        policy.update(target, now_val, dt);
+        const double a = runtime.getControlVal(), b = policy.getControlVal();
+        same = std::memcmp(&a, &b, sizeof(double)) == 0;
+
+        // 途中でリセットしても一致する
+        if (k == NUM_STEPS / 2)
+        {
+            runtime.reset();
+            policy.reset();
+        }
+    }
+    return same;
+}
+
+int main(void)
+{
+    using namespace myStd::PIDMode;
+
+    bool ok = true;
+    ok &= check(compare<pPID>(PID::Mode::pPID, false), "pPID");
+    ok &= check(compare<sPID>(PID::Mode::sPID, false), "sPID");
+    ok &= check(compare<PI_D>(PID::Mode::PI_D, false), "PI_D");
+    ok &= check(compare<I_PD>(PID::Mode::I_PD, false), "I_PD");
+    ok &= check(compare<pPID>(PID::Mode::pPID, true), "pPID with saturation");
+    ok &= check(compare<sPID>(PID::Mode::sPID, true), "sPID with saturation");
+    ok &= check(compare<PI_D>(PID::Mode::PI_D, true), "PI_D with saturation");
+    ok &= check(compare<I_PD>(PID::Mode::I_PD, true), "I_PD with saturation");
+
+    std::cout << (ok ? "OK" : "NG") << std::endl;
+    return ok ? 0 : 1;
+}
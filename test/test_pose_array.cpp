@@ -0,0 +1,154 @@
+#include <iostream>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+#include "./../MyStdLib/MyStdLib.h"
+
+// PoseArrayの一括計算（getDistance，getAngle，getDot，leap，nearest）が要素ごとのPose2Dの関数と一致することを確認する
+// g++ -std=c++11 -O2 test_pose_array.cpp && ./a.out
+
+static bool check(bool ok, const char *name)
+{
+    std::cout << (ok ? "OK " : "NG ") << name << std::endl;
+    return ok;
+}
+
+// ベクトル化でFMAに変換されても通るよう数ulpの差を許す
+template <typename T>
+static bool close(T a, T b)
+{
+    const T eps = std::numeric_limits<T>::epsilon();
+    return std::fabs(a - b) <= 4 * eps * max(T(1), max(std::fabs(a), std::fabs(b)));
+}
+
+template <typename T>
+static bool samePose(const myStd::Pose2D<T> &a, const myStd::Pose2D<T> &b)
+{
+    return close(a.x, b.x) && close(a.y, b.y) && close(a.theta, b.theta);
+}
+
+template <typename T>
+static std::vector<myStd::Pose2D<T>> randomPoses(std::mt19937 &rng, std::size_t n)
+{
+    std::uniform_real_distribution<double> pos(-50.0, 50.0), ang(-PI, PI);
+    std::vector<myStd::Pose2D<T>> v;
+    for (std::size_t i = 0; i < n; i++)
+        v.push_back(myStd::Pose2D<T>(T(pos(rng)), T(pos(rng)), T(ang(rng))));
+    return v;
+}
+
+// 要素数はベクトル化の余りとnearest()のブロック（256）の境界をまたぐ半端な数にする
+template <typename T>
+static bool kernels(const char *type_name)
+{
+    typedef myStd::Pose2D<T> Pose;
+    const std::size_t N = 1031;
+    std::mt19937 rng(5);
+    const std::vector<Pose> va = randomPoses<T>(rng, N), vb = randomPoses<T>(rng, N);
+    const myStd::PoseArray<T> a(va), b(vb);
+    const myStd::Vector2<T> p(T(3.25), T(-7.5));
+    const Pose pp(p.x, p.y, 0);
+
+    std::vector<T> dist(N), angle(N), dot(N), dist2(N), angle2(N), dot2(N);
+    a.getDistance(p, dist.data());
+    a.getAngle(p, angle.data());
+    a.getDot(p, dot.data());
+    myStd::PoseArray<T>::getDistance(a, b, dist2.data());
+    myStd::PoseArray<T>::getAngle(a, b, angle2.data());
+    myStd::PoseArray<T>::getDot(a, b, dot2.data());
+
+    bool ok_dist = true, ok_angle = true, ok_dot = true;
+    for (std::size_t i = 0; i < N; i++)
+    {
+        ok_dist = ok_dist && close(dist[i], Pose::getDistance(pp, va[i])) && close(dist2[i], Pose::getDistance(va[i], vb[i]));
+        ok_angle = ok_angle && close(angle[i], Pose::getAngle(pp, va[i])) && close(angle2[i], Pose::getAngle(va[i], vb[i]));
+        ok_dot = ok_dot && close(dot[i], Pose::getDot(pp, va[i])) && close(dot2[i], Pose::getDot(va[i], vb[i]));
+    }
+
+    // leap: tは0～1に制限され，出力先が入力と同じでもよい
+    bool ok_leap = true;
+    const T ts[] = {T(-0.5), T(0), T(0.3), T(1), T(1.5)};
+    for (T t : ts)
+    {
+        myStd::PoseArray<T> out;
+        myStd::PoseArray<T>::leap(a, b, t, out);
+        myStd::PoseArray<T> in_place = a;
+        myStd::PoseArray<T>::leap(in_place, b, t, in_place);
+        ok_leap = ok_leap && out.size() == N && in_place.size() == N;
+        for (std::size_t i = 0; i < N && ok_leap; i++)
+        {
+            const Pose expected = Pose::leap(va[i], vb[i], t);
+            ok_leap = samePose(out[i], expected) && samePose(in_place[i], expected);
+        }
+    }
+
+    // nearest: 全探索（同じ距離の場合は小さいインデックス）と一致する
+    bool ok_nearest = true;
+    std::uniform_real_distribution<double> q(-60.0, 60.0);
+    for (int k = 0; k < 2000; k++)
+    {
+        const myStd::Vector2<T> r(T(q(rng)), T(q(rng)));
+        int best = -1;
+        T best_sq = std::numeric_limits<T>::infinity();
+        for (std::size_t i = 0; i < N; i++)
+        {
+            const T dx = va[i].x - r.x, dy = va[i].y - r.y;
+            const T sq = dx * dx + dy * dy;
+            if (sq < best_sq)
+            {
+                best_sq = sq;
+                best = static_cast<int>(i);
+            }
+        }
+        ok_nearest = ok_nearest && a.nearest(r) == best;
+    }
+
+    const std::string name(type_name);
+    bool ok = true;
+    ok &= check(ok_dist, (name + " getDistance").c_str());
+    ok &= check(ok_angle, (name + " getAngle").c_str());
+    ok &= check(ok_dot, (name + " getDot").c_str());
+    ok &= check(ok_leap, (name + " leap").c_str());
+    ok &= check(ok_nearest, (name + " nearest").c_str());
+    return ok;
+}
+
+// nearest()の同じ距離の扱いと空の配列
+static bool nearestTies()
+{
+    typedef myStd::Pose2D<double> Pose;
+    bool ok = true;
+
+    // 空の配列は-1
+    ok = ok && myStd::PoseArray<double>().nearest(myStd::Vector2<double>(0, 0)) == -1;
+
+    // 原点から同じ距離の異なる点（(1, 0)がインデックス2，(-1, 0)がインデックス5）
+    std::vector<Pose> v(8, Pose(10.0, 10.0, 0.0));
+    v[2] = Pose(1.0, 0.0, 0.0);
+    v[5] = Pose(-1.0, 0.0, 0.0);
+    ok = ok && myStd::PoseArray<double>(v).nearest(myStd::Vector2<double>(0, 0)) == 2;
+
+    // 同じ点がブロックの内側と，ブロックをまたいで重複している
+    std::vector<Pose> w(600, Pose(10.0, 10.0, 0.0));
+    w[100] = w[400] = w[401] = Pose(1.0, 1.0, 0.0);
+    ok = ok && myStd::PoseArray<double>(w).nearest(myStd::Vector2<double>(1, 1)) == 100;
+    w[100] = Pose(10.0, 10.0, 0.0);
+    ok = ok && myStd::PoseArray<double>(w).nearest(myStd::Vector2<double>(1, 1)) == 400;
+
+    // 全て同じ点なら0
+    ok = ok && myStd::PoseArray<double>(std::vector<Pose>(300, Pose(2.0, 2.0, 0.0))).nearest(myStd::Vector2<double>(0, 0)) == 0;
+    return ok;
+}
+
+int main(void)
+{
+    bool ok = true;
+    ok &= kernels<double>("double");
+    ok &= kernels<float>("float");
+    ok &= check(nearestTies(), "nearest ties and empty array");
+
+    std::cout << (ok ? "OK" : "NG") << std::endl;
+    return ok ? 0 : 1;
+}
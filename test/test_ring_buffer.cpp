@@ -0,0 +1,83 @@
+#include <iostream>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "./../MyStdLib/MyStdLib.h"
+
+// RingBufferの順序，合計，平均，最小値，最大値がdataShiftToLast()で管理した配列と一致することを確認する
+// g++ -std=c++11 -O2 test_ring_buffer.cpp && ./a.out
+
+static bool check(bool ok, const char *name)
+{
+    std::cout << (ok ? "OK " : "NG ") << name << std::endl;
+    return ok;
+}
+
+template <typename T>
+static bool near(T a, T b, double eps) { return std::fabs(static_cast<double>(a) - static_cast<double>(b)) <= eps; }
+
+// 乱数の値を追加しながら，毎回全ての要素と統計量を比べる
+template <typename T, std::size_t N, typename Dist>
+static bool compare(Dist dist, double eps)
+{
+    std::mt19937 rng(N);
+    myStd::RingBuffer<T, N> ring;
+    T array[N] = {};
+    bool same = true;
+    for (std::size_t k = 0; k < 20 * N + 3 && same; k++)
+    {
+        const T x = static_cast<T>(dist(rng));
+        ring.push(x);
+        dataShiftToLast(x, array, static_cast<int>(N));
+
+        const std::size_t n = min(k + 1, N);
+        T sum = T(), lo = array[0], hi = array[0];
+        for (std::size_t i = 0; i < N; i++)
+        {
+            same = same && ring[i] == array[i];
+            sum += array[i];
+            if (i < n)
+            {
+                lo = min(lo, array[i]);
+                hi = max(hi, array[i]);
+            }
+        }
+        same = same && ring.size() == n && ring.newest() == x && ring.oldest() == array[n - 1] &&
+               near(ring.getSum(), sum, eps) && near(ring.getMean(), sum / static_cast<T>(n), eps) &&
+               ring.getMin() == lo && ring.getMax() == hi;
+    }
+
+    ring.clear();
+    same = same && ring.size() == 0 && ring.getSum() == T() && ring.getMin() == T() && ring[N - 1] == T();
+    return same;
+}
+
+int main(void)
+{
+    bool ok = true;
+    std::uniform_int_distribution<int> ints(-1000, 1000);
+    std::uniform_real_distribution<double> reals(-1.0, 1.0);
+
+    ok &= check(compare<int, 1>(ints, 0), "int N=1");
+    ok &= check(compare<int, 7>(ints, 0), "int N=7");
+    ok &= check(compare<int, 64>(ints, 0), "int N=64");
+    ok &= check(compare<double, 1>(reals, 1e-12), "double N=1");
+    ok &= check(compare<double, 7>(reals, 1e-12), "double N=7");
+    ok &= check(compare<double, 100>(reals, 1e-12), "double N=100");
+
+    // 大きさの違う値を長く追加しても合計に誤差が溜まらない
+    {
+        myStd::RingBuffer<double, 50> ring;
+        std::mt19937 rng(5);
+        std::uniform_real_distribution<double> small(0.0, 1e-3);
+        for (int k = 0; k < 1000000; k++)
+            ring.push((k % 1000 == 0) ? 1e8 : small(rng));
+        double sum = 0;
+        for (std::size_t i = 0; i < ring.size(); i++)
+            sum += ring[i];
+        ok &= check(near(ring.getSum(), sum, 1e-9), "no drift");
+    }
+
+    std::cout << (ok ? "OK" : "NG") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,101 @@
+#include <iostream>
+#include <cmath>
+#include "./../MyStdLib/MyStdLib.h"
+#include "./../MyStdLib/RealTime/RealTime.h"
+#if defined(__linux__)
+#include <atomic>
+#include <sched.h>
+#endif
+
+// 1kHz，200Hz，50Hzの制御ループを2つのワーカーで1秒間実行し，回数とdtを確認する
+// CPUを固定したワーカーでは初回の実行から固定したCPUで動くことを確認する（Linuxのみ）
+// g++ -std=c++11 -O2 -pthread test_scheduler.cpp && ./a.out
+
+struct Loop
+{
+    Loop(const char *n, double p) : name(n), period(p), pid(1.0, 0.1, 0.0) {}
+
+    const char *name;
+    double period;
+    myStd::PID<double> pid;
+    double dt_sum = 0;
+    double dt_max = 0;
+    int id = -1;
+};
+
+#if defined(__linux__)
+// 使えるCPUのうち番号が最大のものに固定し，全ての実行がそのCPU上か確認する
+static bool pinnedFromFirstRun()
+{
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+        return true;
+    int cpu = -1;
+    for (int i = 0; i < CPU_SETSIZE; i++)
+        if (CPU_ISSET(i, &allowed))
+            cpu = i;
+
+    std::atomic<int> runs{0}, wrong{0};
+    myStd::Scheduler<double> sched(1);
+    sched.setAffinity(0, cpu);
+    sched.addTask(0.001, [&](double) {
+        if (sched_getcpu() != cpu)
+            wrong++;
+        runs++;
+    });
+    sched.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    sched.stop();
+    std::cout << "pinned to cpu " << cpu << "\truns: " << runs << "\twrong cpu: " << wrong << std::endl;
+    return runs > 0 && wrong == 0;
+}
+#endif
+
+int main(void)
+{
+    Loop loops[3] = {Loop("current 1kHz", 0.001), Loop("velocity 200Hz", 0.005), Loop("path 50Hz", 0.02)};
+
+    myStd::Scheduler<double> sched(2);
+    for (Loop &l : loops)
+    {
+        l.pid.setMode(myStd::PID<double>::Mode::pPID);
+        l.pid.setSaturation(-1.0, 1.0);
+        l.pid.reset();
+        Loop *p = &l;
+        l.id = sched.addTask(l.period, [p](double dt) {
+            p->pid.update(1.0, 0.0, dt);
+            p->dt_sum += dt;
+            p->dt_max = std::max(p->dt_max, dt);
+        });
+    }
+
+    const double duration = 1.0;
+    sched.start();
+    std::this_thread::sleep_for(std::chrono::duration<double>(duration));
+    sched.stop();
+
+    int failures = 0;
+    for (const Loop &l : loops)
+    {
+        myStd::Scheduler<double>::stats_t s = sched.getStats(l.id);
+        const double expected = duration / l.period;
+        const double dt_mean = l.dt_sum / s.count;
+        std::cout << l.name << "\tcount: " << s.count << " / " << expected << "\tdt mean: " << dt_mean << " max: " << l.dt_max
+                  << "\tjitter mean: " << s.jitter_mean << " max: " << s.jitter_max << "\texec max: " << s.exec_max
+                  << "\tmisses: " << s.misses << "\tskipped: " << s.skipped << std::endl;
+
+        // 負荷の高い環境でも満たすはずのゆるい条件（周期が処理時間でずれない，dtが実際の経過時間）
+        if (s.count + s.skipped < expected * 0.95 || s.count > expected + 2)
+            failures++;
+        if (std::fabs(dt_mean - l.period) > l.period * 0.2)
+            failures++;
+    }
+
+#if defined(__linux__)
+    if (!pinnedFromFirstRun())
+        failures++;
+#endif
+
+    std::cout << (failures == 0 ? "OK" : "NG") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,199 @@
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <vector>
+#include "./../MyStdLib/MyStdLib.h"
+#include "./../MyStdLib/Control/KinematicSimulator.h"
+
+// 運動学シミュレータの確認と速度の計測
+// g++ -std=c++11 -O2 test_simulator.cpp && ./a.out
+
+typedef myStd::KinematicSimulator<double> Sim;
+
+static bool check(bool ok, const char *name)
+{
+    std::cout << (ok ? "OK " : "NG ") << name << std::endl;
+    return ok;
+}
+
+static bool near(double a, double b, double eps) { return std::fabs(a - b) <= eps; }
+
+// 正弦波の経路をPurePursuitControlで追従し，経路からの最大のずれを返す
+static double trackSine(Sim::Mode mode, int delay_steps, double noise, std::uint64_t seed, myStd::Pose2D<double> &final_pose,
+                        double &steps_per_sec)
+{
+    std::vector<myStd::Pose2D<double>> path;
+    for (int i = 0; i <= 2000; i++)
+        path.push_back(myStd::Pose2D<double>(i * 0.01, 0.5 * std::sin(i * 0.01), 0));
+
+    myStd::PID<double> linear(2.0, 0.0, 0.0), angular(4.0, 0.0, 0.0);
+    linear.setMode(myStd::PID<double>::Mode::pPID);
+    linear.setSaturation(-1.0, 1.0);
+    linear.reset();
+    angular.setMode(myStd::PID<double>::Mode::pPID);
+    angular.setSaturation(-3.0, 3.0);
+    angular.reset();
+    myStd::PurePursuitControl<double, myStd::PID<double>> ppc(path);
+    ppc.setController(linear, angular);
+    ppc.setLookahead(0.3);
+
+    Sim::param_t param = Sim::defaultParam();
+    param.mode = mode;
+    param.dt = 0.001;
+    param.delay_steps = delay_steps;
+    param.need_saturation = true;
+    param.vel_max = myStd::Pose2D<double>(1.0, 1.0, 3.0);
+    param.accel_max = myStd::Pose2D<double>(5.0, 5.0, 20.0);
+    param.noise_stddev = myStd::Pose2D<double>(noise, noise, noise);
+    param.seed = seed;
+    Sim sim(param, myStd::Pose2D<double>(0, 0, std::atan(0.5)));
+
+    // 経路からのずれは経路の点との最小距離で近似する（点の間隔は0.01）
+    double max_err = 0;
+    const std::size_t NUM_STEPS = 40000;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t k = 0; k < NUM_STEPS; k += 100)
+    {
+        sim.run(100, [&](const myStd::Pose2D<double> &pose, double dt) {
+            ppc.update(pose, dt);
+            return ppc.getControlVal();
+        });
+        const myStd::Pose2D<double> &p = sim.getPose();
+        if (p.x < 19.5)
+        {
+            const int i = guard(static_cast<int>(p.x / 0.01), 0, 2000);
+            double best = 1e9;
+            for (int j = max(i - 100, 0); j <= min(i + 100, 2000); j++)
+                best = min(best, myStd::Pose2D<double>::getDistance(p, path[j]));
+            max_err = max(max_err, best);
+        }
+    }
+    steps_per_sec = NUM_STEPS / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    final_pose = sim.getPose();
+    return max_err;
+}
+
+int main(void)
+{
+    bool ok = true;
+
+    // 開ループ: 直進，円弧（1周で元の位置に戻る），差動二輪は横方向の速度を無視する
+    {
+        Sim sim;
+        for (int i = 0; i < 1000; i++)
+            sim.step(myStd::Pose2D<double>(1.0, 0.5, 0.0));
+        ok &= check(near(sim.getPose().x, 1.0, 1e-12) && sim.getPose().y == 0 && near(sim.getTime(), 1.0, 1e-12), "diff straight");
+
+        sim.reset();
+        const int n = static_cast<int>(std::round(2 * PI / 0.001));
+        const double w = 2 * PI / (n * 0.001);
+        for (int i = 0; i < n; i++)
+            sim.step(myStd::Pose2D<double>(1.0, 0.0, w));
+        ok &= check(near(sim.getPose().x, 0, 1e-9) && near(sim.getPose().y, 0, 1e-9) && near(sim.getPose().theta, 0, 1e-9),
+                    "diff circle closes");
+
+        Sim::param_t param = Sim::defaultParam();
+        param.mode = Sim::Mode::omni;
+        Sim omni(param, myStd::Pose2D<double>(0, 0, PI / 2));
+        for (int i = 0; i < 1000; i++)
+            omni.step(myStd::Pose2D<double>(1.0, 0.5, 0.0));
+        ok &= check(near(omni.getPose().x, -0.5, 1e-12) && near(omni.getPose().y, 1.0, 1e-12), "omni body frame");
+    }
+
+    // 遅れ，速度と加速度の制限
+    {
+        Sim::param_t param = Sim::defaultParam();
+        param.delay_steps = 5;
+        Sim sim(param);
+        bool delayed = true;
+        for (int i = 0; i < 5; i++)
+            delayed = delayed && sim.step(myStd::Pose2D<double>(1.0, 0.0, 0.0)).x == 0;
+        sim.step(myStd::Pose2D<double>(1.0, 0.0, 0.0));
+        ok &= check(delayed && near(sim.getPose().x, 0.001, 1e-15), "delay");
+
+        param = Sim::defaultParam();
+        param.need_saturation = true;
+        param.vel_max = myStd::Pose2D<double>(0.5, 0.5, 1.0);
+        param.accel_max = myStd::Pose2D<double>(1.0, 0.0, 0.0);
+        sim.setParam(param);
+        sim.reset();
+        sim.run(100, [](const myStd::Pose2D<double> &, double) { return myStd::Pose2D<double>(2.0, 0.0, -5.0); });
+        const bool ramp = near(sim.getVelocity().x, 0.1, 1e-12) && sim.getVelocity().theta == -1.0;
+        sim.run(1000, [](const myStd::Pose2D<double> &, double) { return myStd::Pose2D<double>(2.0, 0.0, 0.0); });
+        ok &= check(ramp && sim.getVelocity().x == 0.5, "saturation");
+    }
+
+    // 雑音: 同じシードなら同じ結果，標準偏差が設定値に近い
+    {
+        Sim::param_t param = Sim::defaultParam();
+        param.noise_stddev = myStd::Pose2D<double>(0.1, 0.0, 0.0);
+        param.seed = 42;
+        Sim a(param), b(param);
+        param.seed = 43;
+        Sim c(param);
+        const myStd::Pose2D<double> cmd(1.0, 0.0, 0.2);
+        for (int i = 0; i < 10000; i++)
+        {
+            a.step(cmd);
+            b.step(cmd);
+            c.step(cmd);
+        }
+        ok &= check(a.getPose().x == b.getPose().x && a.getPose().y == b.getPose().y && a.getPose().x != c.getPose().x,
+                    "noise deterministic by seed");
+
+        Sim d(param);
+        double sum = 0, sq = 0;
+        const int N = 200000;
+        for (int i = 0; i < N; i++)
+        {
+            const double x0 = d.getPose().x;
+            d.step(myStd::Pose2D<double>(0.0, 0.0, 0.0));
+            const double v = (d.getPose().x - x0) / 0.001;
+            sum += v;
+            sq += v * v;
+        }
+        const double mean = sum / N, sd = std::sqrt(sq / N - mean * mean);
+        ok &= check(std::fabs(mean) < 0.002 && near(sd, 0.1, 0.002), "noise stddev");
+    }
+
+    // 閉ループ: PurePursuitControlで正弦波の経路を追従する
+    {
+        myStd::Pose2D<double> p1, p2;
+        double sps;
+        const double err = trackSine(Sim::Mode::diff, 0, 0.0, 1, p1, sps);
+        std::cout << "diff tracking max error: " << err << " final: " << p1 << " (" << sps / 1e6 << " M steps/s with PurePursuit)" << std::endl;
+        ok &= check(err < 0.05 && p1.x > 19.5, "diff tracking");
+
+        const double err_omni = trackSine(Sim::Mode::omni, 0, 0.0, 1, p1, sps);
+        ok &= check(err_omni == err, "omni without lateral command matches diff");
+
+        const double err_delay = trackSine(Sim::Mode::diff, 20, 0.05, 7, p1, sps);
+        trackSine(Sim::Mode::diff, 20, 0.05, 7, p2, sps);
+        std::cout << "diff tracking with 20ms delay and noise max error: " << err_delay << std::endl;
+        ok &= check(err_delay < 0.1 && p1.x == p2.x && p1.y == p2.y && p1.theta == p2.theta, "closed loop deterministic");
+    }
+
+    // 開ループの1ステップの時間（遅れ，制限，雑音あり）
+    {
+        Sim::param_t param = Sim::defaultParam();
+        param.mode = Sim::Mode::omni;
+        param.delay_steps = 10;
+        param.need_saturation = true;
+        param.vel_max = myStd::Pose2D<double>(1.0, 1.0, 3.0);
+        param.accel_max = myStd::Pose2D<double>(5.0, 5.0, 20.0);
+        param.noise_stddev = myStd::Pose2D<double>(0.01, 0.01, 0.01);
+        Sim sim(param);
+        std::vector<myStd::Pose2D<double>> cmds(1024);
+        for (std::size_t i = 0; i < cmds.size(); i++)
+            cmds[i] = myStd::Pose2D<double>(std::sin(i * 0.1), std::cos(i * 0.07), std::sin(i * 0.05));
+        const std::size_t NUM = 5000000;
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < NUM; i++)
+            sim.step(cmds[i & 1023]);
+        const double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "open loop: " << NUM / sec / 1e6 << " M steps/s " << sim.getPose() << std::endl;
+    }
+
+    std::cout << (ok ? "OK" : "NG") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,143 @@
+#include <iostream>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#define MYSTD_TRACE
+#include "./../MyStdLib/MyStdLib.h"
+#include "./../MyStdLib/RealTime/RealTime.h"
+
+// トレース（MYSTD_TRACE）の記録，ファイルへの書き出し，CSVへの変換の確認
+// g++ -std=c++11 -O2 -pthread test_trace.cpp && ./a.out
+
+static bool check(bool ok, const char *name)
+{
+    std::cout << (ok ? "OK " : "NG ") << name << std::endl;
+    return ok;
+}
+
+int main(void)
+{
+    bool ok = true;
+    const int NUM_THREADS = 2;
+    const int NUM_STEPS = 20000;
+    const std::string trace_file = "test_trace.bin", csv_file = "test_trace.csv";
+    std::uint64_t dropped = 0;
+
+    // 制御ループのスレッドごとにリングを用意し，PIDとPurePursuitControlの状態を記録する
+    {
+        myStd::TraceRecorder rec(1 << 12);
+        ok &= check(rec.open(trace_file), "open");
+        std::vector<myStd::TraceRing *> rings;
+        for (int t = 0; t < NUM_THREADS; t++)
+            rings.push_back(rec.addRing());
+        rec.start(0.0005);
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < NUM_THREADS; t++)
+        {
+            threads.emplace_back([&, t] {
+                myStd::PID<double> pid(1.0, 0.5, 0.01);
+                pid.setMode(myStd::PID<double>::Mode::pPID);
+                pid.setSaturation(-5.0, 5.0);
+                pid.reset();
+                const myStd::PID<double> untraced = pid;
+                pid.setTrace(rings[t], 10 * t);
+
+                std::vector<myStd::Pose2D<double>> path;
+                for (int i = 0; i < 100; i++)
+                    path.push_back(myStd::Pose2D<double>(i * 0.1, 0, 0));
+                myStd::PurePursuitControl<double, myStd::PID<double>> ppc(path);
+                ppc.setController(untraced, untraced);
+                ppc.setLookahead(0.5);
+                ppc.setTrace(rings[t], 10 * t + 1);
+
+                for (int i = 0; i < NUM_STEPS; i++)
+                {
+                    pid.update(1.0, i * 1e-4, 0.001);
+                    if (i % 10 == 0)
+                        ppc.update(myStd::Pose2D<double>((i % 900) * 0.01, 0.05, 0), 0.01);
+                    // 書き出しスレッドが追いつくように時々待つ（リングの容量は4096）
+                    if (i % 1000 == 999)
+                        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                }
+            });
+        }
+        for (std::thread &th : threads)
+            th.join();
+        rec.stop();
+
+        const std::uint64_t expected = NUM_THREADS * (NUM_STEPS + NUM_STEPS / 10);
+        dropped = rec.getDropped();
+        std::cout << "written: " << rec.getWritten() << " dropped: " << dropped << std::endl;
+        ok &= check(rec.getWritten() + rec.getDropped() == expected, "written + dropped == recorded");
+        rec.close();
+    }
+
+    // ファイルを読み戻して値と順序を確認する
+    {
+        myStd::TraceReader reader;
+        ok &= check(reader.open(trace_file), "reader open");
+        myStd::trace_record_t r;
+        int ring;
+        std::vector<std::uint64_t> last_ticks(NUM_THREADS, 0);
+        std::vector<int> next_step(NUM_THREADS, 0);
+        bool ordered = true, values_ok = true;
+        long long count = 0;
+        while (reader.next(r, ring))
+        {
+            ordered = ordered && ring < NUM_THREADS && r.ticks >= last_ticks[ring];
+            last_ticks[ring] = r.ticks;
+            if (r.kind == static_cast<std::uint16_t>(myStd::TraceKind::PID))
+            {
+                // target, now_val, diff[0]が書き込んだ値と一致する（捨てたレコードが無ければ連番）
+                const int step = next_step[ring]++;
+                values_ok = values_ok && r.num_values == 7 && r.source == 10u * ring && r.values[0] == 1.0f &&
+                            (dropped > 0 || (r.values[1] == static_cast<float>(step * 1e-4) &&
+                                             r.values[2] == static_cast<float>(1.0 - step * 1e-4))) &&
+                            r.values[6] <= 5.0f;
+            }
+            else
+                values_ok = values_ok && r.kind == static_cast<std::uint16_t>(myStd::TraceKind::PurePursuit) &&
+                            r.num_values == 7 && r.source == 10u * ring + 1 && r.values[1] == 0.05f;
+            count++;
+        }
+        ok &= check(ordered, "ticks ordered per ring");
+        ok &= check(values_ok, "record values");
+
+        const long long rows = myStd::TraceReader::toCSV(trace_file, csv_file);
+        std::ifstream ifs(csv_file);
+        std::string header, line;
+        std::getline(ifs, header);
+        std::getline(ifs, line);
+        std::cout << header << "\n" << line << std::endl;
+        ok &= check(rows == count && header.compare(0, 23, "time,ring,source,kind,v") == 0, "CSV");
+    }
+    std::remove(trace_file.c_str());
+    std::remove(csv_file.c_str());
+
+    // 1レコードの書き込みにかかる時間（リングが満杯にならないよう容量ごとに読み出す）
+    {
+        myStd::TraceRing ring(1 << 14);
+        std::vector<myStd::trace_record_t> out(ring.capacity());
+        const int LOOPS = 100;
+        double sum = 0.0;
+        std::chrono::duration<double> elapsed(0);
+        for (int l = 0; l < LOOPS; l++)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            for (std::size_t i = 0; i < ring.capacity(); i++)
+                ring.write(0, myStd::TraceKind::PID, 1.0, double(i), 0.5, 0.25, 0.125, 2.0, 3.0);
+            elapsed += std::chrono::steady_clock::now() - start;
+            ring.pop(out.data(), out.size());
+            sum += out[l].values[1];
+        }
+        std::cout << "write: " << elapsed.count() * 1e9 / (LOOPS * ring.capacity()) << " ns/record (" << sum << ")" << std::endl;
+        ok &= check(ring.getDropped() == 0, "no drops");
+    }
+
+    std::cout << (ok ? "OK" : "NG") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,143 @@
+#include <iostream>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "./../MyStdLib/MyStdLib.h"
+
+// Transform2Dの合成，逆変換，点と座標の変換，点群の一括変換を確認する
+// g++ -std=c++11 -O2 test_transform2d.cpp && ./a.out
+
+typedef myStd::Transform2D<double> TF;
+typedef myStd::Vector2<double> Vec;
+typedef myStd::Pose2D<double> Pose;
+
+static const double TOL = 1e-12;
+
+static bool check(bool ok, const char *name)
+{
+    std::cout << (ok ? "OK " : "NG ") << name << std::endl;
+    return ok;
+}
+
+static bool same(const Vec &a, const Vec &b) { return a.x == b.x && a.y == b.y; }
+
+static bool near(const Vec &a, const Vec &b) { return std::fabs(a.x - b.x) < TOL && std::fabs(a.y - b.y) < TOL; }
+
+static bool near(const Pose &a, const Pose &b)
+{
+    return std::fabs(a.x - b.x) < TOL && std::fabs(a.y - b.y) < TOL &&
+           std::fabs(shortestAngularDistance(a.theta, b.theta)) < TOL;
+}
+
+// 並進，回転角，cos，sinが恒等変換と一致するか
+static bool isIdentity(const TF &tf)
+{
+    return near(tf.getTranslation(), Vec(0, 0)) && std::fabs(tf.getAngle()) < TOL &&
+           std::fabs(tf.getCos() - 1) < TOL && std::fabs(tf.getSin()) < TOL;
+}
+
+int main(void)
+{
+    bool ok = true;
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> pos(-20.0, 20.0), ang(-PI, PI);
+
+    bool inverse_ok = true, point_ok = true, pose_ok = true, compose_ok = true, relative_ok = true;
+    for (int k = 0; k < 10000; k++)
+    {
+        const TF a(pos(rng), pos(rng), ang(rng)), b(pos(rng), pos(rng), ang(rng));
+        const Vec p(pos(rng), pos(rng));
+        const Pose q(pos(rng), pos(rng), ang(rng));
+
+        // 逆変換との合成は恒等変換
+        inverse_ok = inverse_ok && isIdentity(a.inverse() * a) && isIdentity(a * a.inverse());
+
+        // 変換して逆変換すると元に戻り，applyInverse()はinverse().apply()と一致する
+        point_ok = point_ok && near(a.applyInverse(a.apply(p)), p) && near(a.apply(a.applyInverse(p)), p) &&
+                   near(a.applyInverse(p), a.inverse().apply(p));
+        pose_ok = pose_ok && near(a.applyInverse(a.apply(q)), q) && near(a.applyInverse(q), a.inverse().apply(q));
+
+        // 合成した変換はbを適用してからaを適用するのと同じ
+        const TF ab = a * b;
+        TF assigned = a;
+        assigned *= b;
+        compose_ok = compose_ok && near(ab.apply(p), a.apply(b.apply(p))) && near(ab.apply(q), a.apply(b.apply(q))) &&
+                     near(assigned.apply(p), ab.apply(p)) && near(a * p, a.apply(p)) &&
+                     std::fabs(ab.getCos() - std::cos(ab.getAngle())) < TOL && std::fabs(ab.getSin() - std::sin(ab.getAngle())) < TOL;
+
+        // 相対変換
+        relative_ok = relative_ok && near(TF::getRelative(a, b).apply(p), a.applyInverse(b.apply(p))) &&
+                      near(TF(a.toPose()).apply(TF::getRelative(a.toPose(), q)), q);
+    }
+    ok &= check(inverse_ok, "inverse composed with transform is identity");
+    ok &= check(point_ok, "applyInverse(apply(p)) == p");
+    ok &= check(pose_ok, "applyInverse(apply(pose)) == pose");
+    ok &= check(compose_ok, "composition matches applying one after another");
+    ok &= check(relative_ok, "getRelative");
+
+    // 既知の値: (1, 0)を90度回転して(2, 3)並進すると(2, 4)
+    {
+        const TF tf(2.0, 3.0, HALF_PI);
+        ok &= check(near(tf.apply(Vec(1, 0)), Vec(2, 4)) && near(tf.apply(Pose(1, 0, 0)), Pose(2, 4, HALF_PI)) &&
+                        isIdentity(TF()) && near(TF(Pose(2, 3, HALF_PI)).apply(Vec(1, 0)), Vec(2, 4)),
+                    "known values");
+    }
+
+    // 多数回の合成で回転がずれてもnormalize()でcos^2 + sin^2 = 1に戻る
+    {
+        TF tf;
+        const TF step(0.01, 0.0, 0.001);
+        for (int i = 0; i < 100000; i++)
+            tf *= step;
+        tf.normalize();
+        ok &= check(std::fabs(tf.getCos() * tf.getCos() + tf.getSin() * tf.getSin() - 1) < 1e-15, "normalize");
+    }
+
+    // 点群の一括変換は1点ずつのapply()と完全に一致する（端数の要素数でベクトル化の余りも確かめる）
+    {
+        const std::size_t N = 4003;
+        const Pose robot(1.5, -2.25, 0.7);
+        const TF tf(robot);
+        std::vector<Vec> scan(N), expected(N);
+        std::vector<double> xs(N), ys(N);
+        for (std::size_t i = 0; i < N; i++)
+        {
+            scan[i] = Vec(pos(rng), pos(rng));
+            xs[i] = scan[i].x;
+            ys[i] = scan[i].y;
+            expected[i] = tf.apply(scan[i]);
+        }
+
+        std::vector<Vec> in_place = scan, out(N), free_in_place = scan, free_out(N);
+        std::vector<double> split_x = xs, split_y = ys, out_x(N), out_y(N);
+        std::vector<double> free_x = xs, free_y = ys, free_out_x(N), free_out_y(N);
+        tf.apply(in_place.data(), N);
+        tf.apply(scan.data(), out.data(), N);
+        tf.apply(split_x.data(), split_y.data(), N);
+        tf.apply(xs.data(), ys.data(), out_x.data(), out_y.data(), N);
+        myStd::transformPoints(robot, free_in_place.data(), N);
+        myStd::transformPoints(robot, scan.data(), free_out.data(), N);
+        myStd::transformPoints(robot, free_x.data(), free_y.data(), N);
+        myStd::transformPoints(robot, xs.data(), ys.data(), free_out_x.data(), free_out_y.data(), N);
+
+        bool interleaved = true, split = true, free_func = true, rotate = true;
+        for (std::size_t i = 0; i < N; i++)
+        {
+            interleaved = interleaved && same(in_place[i], expected[i]) && same(out[i], expected[i]);
+            split = split && same(Vec(split_x[i], split_y[i]), expected[i]) && same(Vec(out_x[i], out_y[i]), expected[i]);
+            free_func = free_func && same(free_in_place[i], expected[i]) && same(free_out[i], expected[i]) &&
+                        same(Vec(free_x[i], free_y[i]), expected[i]) && same(Vec(free_out_x[i], free_out_y[i]), expected[i]);
+            // 1点ずつ回転して並進する従来の書き方とも一致する（FMAへの変換で丸めが変わり得るため誤差を許す）
+            Vec r = scan[i];
+            r.rotate(robot.theta);
+            rotate = rotate && near(r + Vec(robot.x, robot.y), expected[i]);
+        }
+        ok &= check(interleaved, "batch apply (Vector2 array) matches scalar");
+        ok &= check(split, "batch apply (split x/y) matches scalar");
+        ok &= check(free_func, "transformPoints matches scalar");
+        ok &= check(rotate, "batch apply matches Vector2::rotate");
+    }
+
+    std::cout << (ok ? "OK" : "NG") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,109 @@
+#include <iostream>
+#include <cmath>
+#include <sstream>
+#include <type_traits>
+#include "./../MyStdLib/MyStdLib.h"
+
+// VectorN（Vector3，Vector4，1要素の場合を含む）の演算，コピー，constexprでの利用を確認する
+// g++ -std=c++11 -O2 test_vector.cpp && ./a.out
+
+typedef myStd::VectorN<double, 1> Vec1;
+typedef myStd::Vector3<double> Vec3;
+typedef myStd::Vector4<double> Vec4;
+
+static const double TOL = 1e-12;
+
+static bool check(bool ok, const char *name)
+{
+    std::cout << (ok ? "OK " : "NG ") << name << std::endl;
+    return ok;
+}
+
+template <std::size_t N>
+static bool near(const myStd::VectorN<double, N> &a, const myStd::VectorN<double, N> &b)
+{
+    for (std::size_t i = 0; i < N; i++)
+        if (std::fabs(a[i] - b[i]) > TOL)
+            return false;
+    return true;
+}
+
+// 要素ごとの演算はC++11でもコンパイル時に評価できる
+constexpr Vec3 ca(1, 2, 3), cb(4, -5, 6);
+constexpr Vec1 c1(7);
+static_assert((ca + cb) == Vec3(5, -3, 9), "constexpr add");
+static_assert((ca - cb) == Vec3(-3, 7, -3), "constexpr sub");
+static_assert((ca * 2.0) == Vec3(2, 4, 6) && (cb / 2.0) == Vec3(2, -2.5, 3) && -ca == Vec3(-1, -2, -3), "constexpr scale");
+static_assert(Vec3::getDot(ca, cb) == 12 && ca.sqrMagnitude() == 14, "constexpr dot");
+static_assert(Vec3::getCross(ca, cb) == Vec3(27, 6, -13), "constexpr cross");
+static_assert(Vec3::leap(ca, cb, 0.5) == Vec3(2.5, -1.5, 4.5) && Vec3::leap(ca, cb, 2.0) == cb, "constexpr leap");
+static_assert(Vec4(1, 2, 3, 4).w == 4 && Vec4::size() == 4 && c1[0] == 7, "constexpr element access");
+
+// VectorNは要素として受け取らない（1要素の場合に要素を並べるコンストラクタがコピーの代わりに選ばれないようにする）
+static_assert(!std::is_constructible<Vec3, Vec3, Vec3, Vec3>::value, "vectors are not elements");
+static_assert(std::is_constructible<Vec1, int>::value && std::is_constructible<Vec3, int, float, double>::value, "element constructor");
+
+int main(void)
+{
+    bool ok = true;
+
+    // 1要素: 非constの左辺値からのコピーとset()
+    {
+        Vec1 a(3.0);
+        Vec1 b(a);
+        Vec1 c = a;
+        Vec1 d;
+        d = a;
+        a.set(-2.0);
+        ok &= check(b[0] == 3.0 && c[0] == 3.0 && d[0] == 3.0 && a[0] == -2.0, "N = 1 copy from non-const lvalue");
+        ok &= check(a.magnitude() == 2.0 && Vec1::getDistance(a, b) == 5.0 && a.normalized() == Vec1(-1.0), "N = 1 magnitude");
+    }
+
+    // Vector3
+    {
+        Vec3 a(1, 2, 2), b(a);
+        ok &= check(a.x == 1 && a.y == 2 && a.z == 2 && a.at(2) == 2 && b == a && !(b != a) && a.equals(b), "Vector3 elements and copy");
+        ok &= check(a.magnitude() == 3 && a.length() == 3 && Vec3::getDistance(a, Vec3(1, 2, -2)) == 4, "Vector3 magnitude and distance");
+        a.normalize();
+        ok &= check(near(a, Vec3(1.0 / 3, 2.0 / 3, 2.0 / 3)) && std::fabs(a.magnitude() - 1) < TOL, "Vector3 normalize");
+        const Vec3 c = Vec3::getCross(Vec3(1, 0, 0), Vec3(0, 1, 0));
+        ok &= check(c == Vec3(0, 0, 1) && Vec3::getDot(c, Vec3(1, 1, 0)) == 0, "Vector3 cross");
+        b += Vec3(1, 1, 1);
+        b -= Vec3(0, 0, 3);
+        b *= 2;
+        b /= 4;
+        ok &= check(b == Vec3(1, 1.5, 0), "Vector3 compound assignment");
+        ok &= check(Vec3::leap(Vec3(0, 0, 0), Vec3(2, 4, 6), 0.25) == Vec3(0.5, 1, 1.5) &&
+                        Vec3::leap(Vec3(0, 0, 0), Vec3(2, 4, 6), -1.0) == Vec3(0, 0, 0),
+                    "Vector3 leap");
+    }
+
+    // Vector4
+    {
+        Vec4 a(1, -1, 1, -1);
+        a.set(2, 0, 0, 0);
+        Vec4 b = a;
+        b[3] = 2;
+        ok &= check(a == Vec4(2, 0, 0, 0) && b.w == 2 && Vec4::getDot(a, b) == 4, "Vector4 set and elements");
+        ok &= check(std::fabs(b.magnitude() - std::sqrt(8.0)) < TOL && near(b.normalized() * std::sqrt(8.0), b) &&
+                        std::fabs(Vec4::getDistance(a, b) - 2) < TOL,
+                    "Vector4 magnitude and normalize");
+        ok &= check(Vec4::leap(a, b, 0.5) == Vec4(2, 0, 0, 1) && (a + b - b) == a && (-a + a) == Vec4(), "Vector4 arithmetic");
+    }
+
+    // 入出力
+    {
+        std::stringstream ss;
+        ss << Vec3(1.5, -2, 3);
+        Vec3 v;
+        ss >> v;
+        ok &= check(v == Vec3(1.5, -2, 3) && Vec4(1, 2, 3, 4).toString() == "(1.000000, 2.000000, 3.000000, 4.000000)", "stream and toString");
+    }
+
+    // SIMDレジスタ1本分に揃うのは大きさが2のべき乗の場合のみ
+    ok &= check(alignof(myStd::Vector4<float>) == 16 && alignof(myStd::Vector3<float>) == alignof(float) && alignof(Vec1) == alignof(double),
+                "alignment");
+
+    std::cout << (ok ? "OK" : "NG") << std::endl;
+    return ok ? 0 : 1;
+}
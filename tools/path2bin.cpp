@@ -0,0 +1,61 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "./../MyStdLib/MyStdLib.h"
+#include "./../MyStdLib/Control/PathFile.h"
+
+// テキスト形式の経路データ（"(x, y, theta)"の並び）をPathFileのバイナリ形式に変換する
+// g++ -std=c++11 -O2 path2bin.cpp -o path2bin
+// ./path2bin input.txt output.bin [--float] [--no-arc-length]
+
+template <typename T>
+int convert(const std::string &input, const std::string &output, bool with_arc_length)
+{
+    std::ifstream ifs(input);
+    if (!ifs)
+    {
+        std::cerr << "cannot open " << input << std::endl;
+        return 1;
+    }
+
+    std::vector<myStd::Pose2D<T>> path;
+    myStd::Pose2D<T> pose;
+    while (ifs >> pose)
+        path.push_back(pose);
+
+    if (!myStd::PathFile<T>::write(output, path.data(), path.size(), with_arc_length))
+    {
+        std::cerr << "cannot write " << output << std::endl;
+        return 1;
+    }
+    std::cout << path.size() << " poses written to " << output << std::endl;
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    std::vector<std::string> files;
+    bool use_float = false;
+    bool with_arc_length = true;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--float")
+            use_float = true;
+        else if (arg == "--no-arc-length")
+            with_arc_length = false;
+        else
+            files.push_back(arg);
+    }
+
+    if (files.size() != 2)
+    {
+        std::cerr << "usage: " << argv[0] << " input.txt output.bin [--float] [--no-arc-length]" << std::endl;
+        return 1;
+    }
+
+    if (use_float)
+        return convert<float>(files[0], files[1], with_arc_length);
+    return convert<double>(files[0], files[1], with_arc_length);
+}
@@ -0,0 +1,26 @@
+#include <iostream>
+#include <string>
+#include "./../MyStdLib/MyStdLib.h"
+#include "./../MyStdLib/RealTime/TraceRecorder.h"
+
+// TraceRecorderが書き出したトレースファイルをCSVに変換する
+// g++ -std=c++11 -O2 -pthread trace2csv.cpp -o trace2csv
+// ./trace2csv trace.bin trace.csv
+
+int main(int argc, char *argv[])
+{
+    if (argc != 3)
+    {
+        std::cerr << "usage: " << argv[0] << " trace.bin output.csv" << std::endl;
+        return 1;
+    }
+
+    const long long count = myStd::TraceReader::toCSV(argv[1], argv[2]);
+    if (count < 0)
+    {
+        std::cerr << "cannot convert " << argv[1] << " to " << argv[2] << std::endl;
+        return 1;
+    }
+    std::cout << count << " records written to " << argv[2] << std::endl;
+    return 0;
+}